@@ -0,0 +1,1093 @@
+#include "appcatalog.h"
+#include "filechangenotifier.h"
+#include "directoryscanner.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QLocale>
+#include <QSaveFile>
+#include <QSemaphore>
+#include <QStandardPaths>
+#include <QThread>
+#include <QThreadPool>
+#include <QVector>
+#include <QDebug>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <sys/stat.h>
+
+namespace {
+
+const quint32 CacheMagic = 0x58415043; // "XAPC"
+const quint32 CacheVersion = 2;  // 2: TryExec bulunamayan dosyalar gizli kayıt olarak tutulmaz
+
+// Önbellekteki dizeler dosya başından itibaren konum ve UTF-8 bayt uzunluğuyla tutulur
+struct StringRef {
+    quint32 offset;
+    quint32 length;
+};
+
+struct CacheHeader {
+    quint32 magic;
+    quint32 version;
+    quint32 dirCount;
+    quint32 entryCount;    // Gölgelenmiş ve gizliler dahil bütün dosyalar
+    quint32 visibleCount;  // Menüde gösterilenler (byName)
+    quint32 idCount;       // Kimliğe göre aranabilenler (byId)
+    quint32 dirsOffset;
+    quint32 entriesOffset;
+    quint32 byNameOffset;
+    quint32 byIdOffset;
+    quint32 stringsOffset;
+    quint32 fileSize;
+    StringRef locale;
+    StringRef roots;
+};
+
+// Önbellek, bu dizinlerin değişiklik zamanlarıyla anahtarlanır
+struct DirRecord {
+    qint64 mtimeNs;
+    StringRef path;
+};
+
+enum EntryFlag : quint8 {
+    TerminalFlag = 0x01,
+    NoDisplayFlag = 0x02,
+    HiddenFlag = 0x04,     // Hidden=true; alttaki dizinlerdeki aynı kimliği gizler
+    ShadowedFlag = 0x08,   // Aynı kimlik daha öncelikli bir dizinde var
+    StartupNotifyFlag = 0x10
+};
+
+struct EntryRecord {
+    StringRef id;
+    StringRef name;
+    StringRef genericName;
+    StringRef comment;
+    StringRef exec;
+    StringRef icon;
+    StringRef keywords;
+    StringRef path;
+    StringRef workingDirectory;
+    quint32 categories;
+    qint8 primaryCategory;
+    quint8 flags;
+    quint8 priority;       // Kök dizin sırası; küçük olan önceliklidir
+    quint8 reserved;
+};
+
+static_assert(sizeof(CacheHeader) == 64, "CacheHeader 64 bayt olmalı");
+static_assert(sizeof(DirRecord) == 16, "DirRecord 16 bayt olmalı");
+static_assert(sizeof(EntryRecord) == 80, "EntryRecord 80 bayt olmalı");
+
+// Ayrıştırılmış bir .desktop dosyası
+struct ParsedFile {
+    AppEntry entry;
+    int priority = 0;
+    bool hidden = false;
+};
+
+struct Directory {
+    QString path;
+    qint64 mtimeNs;
+};
+
+// Ana kategori adları; Audio ve Video, AudioVideo'ya katılır
+const struct {
+    const char *key;
+    int category;
+} CategoryKeys[] = {
+    { "AudioVideo", AppCatalog::AudioVideo },
+    { "Audio", AppCatalog::AudioVideo },
+    { "Video", AppCatalog::AudioVideo },
+    { "Development", AppCatalog::Development },
+    { "Education", AppCatalog::Education },
+    { "Game", AppCatalog::Game },
+    { "Graphics", AppCatalog::Graphics },
+    { "Network", AppCatalog::Network },
+    { "Office", AppCatalog::Office },
+    { "Science", AppCatalog::Science },
+    { "Settings", AppCatalog::Settings },
+    { "System", AppCatalog::System },
+    { "Utility", AppCatalog::Utility },
+};
+
+qint64 directoryMtime(const QString &path)
+{
+    struct stat info;
+    if (::stat(QFile::encodeName(path).constData(), &info) != 0 || !S_ISDIR(info.st_mode)) {
+        return -1;
+    }
+    return qint64(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+}
+
+QString cacheString(const uchar *base, const StringRef &ref)
+{
+    return QString::fromUtf8(reinterpret_cast<const char *>(base) + ref.offset, int(ref.length));
+}
+
+const CacheHeader *headerOf(const uchar *base)
+{
+    return reinterpret_cast<const CacheHeader *>(base);
+}
+
+const EntryRecord *entriesOf(const uchar *base)
+{
+    return reinterpret_cast<const EntryRecord *>(base + headerOf(base)->entriesOffset);
+}
+
+const DirRecord *dirsOf(const uchar *base)
+{
+    return reinterpret_cast<const DirRecord *>(base + headerOf(base)->dirsOffset);
+}
+
+const quint32 *byNameOf(const uchar *base)
+{
+    return reinterpret_cast<const quint32 *>(base + headerOf(base)->byNameOffset);
+}
+
+const quint32 *byIdOf(const uchar *base)
+{
+    return reinterpret_cast<const quint32 *>(base + headerOf(base)->byIdOffset);
+}
+
+QString currentLocale()
+{
+    return QLocale::system().name();
+}
+
+// Yapı ve sınırlar denetlenir; dizin zamanlarına bakılmaz
+bool checkLayout(const uchar *base, qint64 size, const QString &locale, const QString &roots)
+{
+    if (size < qint64(sizeof(CacheHeader)) || (quintptr(base) & 7) != 0) {
+        return false;
+    }
+
+    const CacheHeader *header = headerOf(base);
+    if (header->magic != CacheMagic || header->version != CacheVersion || header->fileSize != size) {
+        return false;
+    }
+
+    auto within = [size](quint64 offset, quint64 bytes) { return offset + bytes <= quint64(size); };
+    if (!within(header->dirsOffset, quint64(header->dirCount) * sizeof(DirRecord))
+        || !within(header->entriesOffset, quint64(header->entryCount) * sizeof(EntryRecord))
+        || !within(header->byNameOffset, quint64(header->visibleCount) * 4)
+        || !within(header->byIdOffset, quint64(header->idCount) * 4)
+        || header->visibleCount > header->entryCount || header->idCount > header->entryCount
+        || (header->dirsOffset & 7) != 0 || (header->entriesOffset & 3) != 0
+        || (header->byNameOffset & 3) != 0 || (header->byIdOffset & 3) != 0) {
+        return false;
+    }
+
+    // Bütün dize başvuruları dize alanının içinde kalmalı
+    auto validRef = [header](const StringRef &ref) {
+        return ref.offset >= header->stringsOffset && quint64(ref.offset) + ref.length <= header->fileSize;
+    };
+    if (!validRef(header->locale) || !validRef(header->roots)) {
+        return false;
+    }
+    const DirRecord *dirs = dirsOf(base);
+    for (quint32 i = 0; i < header->dirCount; ++i) {
+        if (!validRef(dirs[i].path)) {
+            return false;
+        }
+    }
+    const EntryRecord *entries = entriesOf(base);
+    for (quint32 i = 0; i < header->entryCount; ++i) {
+        const EntryRecord &e = entries[i];
+        if (!validRef(e.id) || !validRef(e.name) || !validRef(e.genericName) || !validRef(e.comment)
+            || !validRef(e.exec) || !validRef(e.icon) || !validRef(e.keywords) || !validRef(e.path)
+            || !validRef(e.workingDirectory)) {
+            return false;
+        }
+        // Kategori dizin olarak kullanıldığından aralık dışı değer reddedilir
+        if (e.primaryCategory < -1 || e.primaryCategory >= AppCatalog::CategoryCount) {
+            return false;
+        }
+    }
+    const quint32 *byName = byNameOf(base);
+    for (quint32 i = 0; i < header->visibleCount; ++i) {
+        if (byName[i] >= header->entryCount) {
+            return false;
+        }
+    }
+    const quint32 *byId = byIdOf(base);
+    for (quint32 i = 0; i < header->idCount; ++i) {
+        if (byId[i] >= header->entryCount) {
+            return false;
+        }
+    }
+
+    return cacheString(base, header->locale) == locale && cacheString(base, header->roots) == roots;
+}
+
+// Paketler .desktop dosyalarını yeniden adlandırarak kurar; dizin zamanı değişir
+bool directoriesUnchanged(const uchar *base)
+{
+    const CacheHeader *header = headerOf(base);
+    const DirRecord *dirs = dirsOf(base);
+    for (quint32 i = 0; i < header->dirCount; ++i) {
+        if (directoryMtime(cacheString(base, dirs[i].path)) != dirs[i].mtimeNs) {
+            return false;
+        }
+    }
+    return true;
+}
+
+ParsedFile decodeRecord(const uchar *base, const EntryRecord &record)
+{
+    ParsedFile file;
+    AppEntry &entry = file.entry;
+    entry.id = cacheString(base, record.id);
+    entry.name = cacheString(base, record.name);
+    entry.genericName = cacheString(base, record.genericName);
+    entry.comment = cacheString(base, record.comment);
+    entry.exec = cacheString(base, record.exec);
+    entry.icon = cacheString(base, record.icon);
+    entry.keywords = cacheString(base, record.keywords);
+    entry.path = cacheString(base, record.path);
+    entry.workingDirectory = cacheString(base, record.workingDirectory);
+    entry.categories = record.categories;
+    entry.primaryCategory = record.primaryCategory;
+    entry.terminal = record.flags & TerminalFlag;
+    entry.startupNotify = record.flags & StartupNotifyFlag;
+    entry.noDisplay = record.flags & NoDisplayFlag;
+    file.priority = record.priority;
+    file.hidden = record.flags & HiddenFlag;
+    return file;
+}
+
+// Dize değerlerindeki kaçış dizileri: \s \n \t \r \\ (spesifikasyon)
+QString unescape(const QByteArray &value)
+{
+    if (!value.contains('\\')) {
+        return QString::fromUtf8(value);
+    }
+
+    QByteArray result;
+    result.reserve(value.size());
+    for (int i = 0; i < value.size(); ++i) {
+        const char c = value.at(i);
+        if (c != '\\' || i + 1 == value.size()) {
+            result.append(c);
+            continue;
+        }
+        switch (value.at(++i)) {
+        case 's': result.append(' '); break;
+        case 'n': result.append('\n'); break;
+        case 't': result.append('\t'); break;
+        case 'r': result.append('\r'); break;
+        case '\\': result.append('\\'); break;
+        default:
+            // Exec ve listelerde anlamı olan diğer kaçışlar korunur
+            result.append('\\');
+            result.append(value.at(i));
+            break;
+        }
+    }
+    return QString::fromUtf8(result);
+}
+
+bool isTrue(const QByteArray &value)
+{
+    return value == "true" || value == "1";
+}
+
+// Yerelleştirilmiş anahtarlar: tam eşleşme (tr_TR) > dil (tr) > yerelsiz
+struct LocalizedValue {
+    QByteArray value;
+    int level = -1;
+
+    void offer(const QByteArray &candidate, int candidateLevel)
+    {
+        if (candidateLevel > level) {
+            value = candidate;
+            level = candidateLevel;
+        }
+    }
+};
+
+bool parseDesktopFile(const QString &path, const QString &id, const QByteArray &locale,
+                      const QByteArray &language, ParsedFile *file)
+{
+    QFile source(path);
+    if (!source.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const QByteArray data = source.readAll();
+
+    LocalizedValue name, genericName, comment, keywords;
+    QByteArray type, exec, icon, categories, workingDirectory, tryExec;
+    bool noDisplay = false, hidden = false, terminal = false, startupNotify = false;
+
+    bool inGroup = false;
+    bool seenGroup = false;
+    int lineStart = 0;
+    while (lineStart < data.size()) {
+        int lineEnd = data.indexOf('\n', lineStart);
+        if (lineEnd < 0) {
+            lineEnd = data.size();
+        }
+        const QByteArray line = data.mid(lineStart, lineEnd - lineStart).trimmed();
+        lineStart = lineEnd + 1;
+
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+        if (line.startsWith('[')) {
+            // Yalnızca ilk [Desktop Entry] grubu okunur; eylemler atlanır
+            if (seenGroup) {
+                break;
+            }
+            inGroup = line == "[Desktop Entry]";
+            seenGroup = inGroup;
+            continue;
+        }
+        if (!inGroup) {
+            continue;
+        }
+
+        const int equals = line.indexOf('=');
+        if (equals <= 0) {
+            continue;
+        }
+        QByteArray key = line.left(equals).trimmed();
+        const QByteArray value = line.mid(equals + 1).trimmed();
+
+        // Name[tr_TR] biçimindeki anahtarların yerel kısmı ayrılır
+        int level = 0;
+        const int bracket = key.indexOf('[');
+        if (bracket > 0 && key.endsWith(']')) {
+            QByteArray keyLocale = key.mid(bracket + 1, key.size() - bracket - 2);
+            const int modifier = keyLocale.indexOf('@');
+            if (modifier >= 0) {
+                keyLocale.truncate(modifier);
+            }
+            if (keyLocale == locale) {
+                level = 2;
+            } else if (keyLocale == language) {
+                level = 1;
+            } else {
+                continue;
+            }
+            key.truncate(bracket);
+        }
+
+        if (key == "Name") {
+            name.offer(value, level);
+        } else if (key == "GenericName") {
+            genericName.offer(value, level);
+        } else if (key == "Comment") {
+            comment.offer(value, level);
+        } else if (key == "Keywords") {
+            keywords.offer(value, level);
+        } else if (level > 0) {
+            continue;
+        } else if (key == "Type") {
+            type = value;
+        } else if (key == "Exec") {
+            exec = value;
+        } else if (key == "Icon") {
+            icon = value;
+        } else if (key == "Categories") {
+            categories = value;
+        } else if (key == "Path") {
+            workingDirectory = value;
+        } else if (key == "TryExec") {
+            tryExec = value;
+        } else if (key == "NoDisplay") {
+            noDisplay = isTrue(value);
+        } else if (key == "Hidden") {
+            hidden = isTrue(value);
+        } else if (key == "Terminal") {
+            terminal = isTrue(value);
+        } else if (key == "StartupNotify") {
+            startupNotify = isTrue(value);
+        }
+    }
+
+    // Hidden=true dosyası geçerlidir: alttaki dizinlerdeki aynı kimliği gizler
+    if (!hidden && (type != "Application" || name.value.isEmpty() || exec.isEmpty())) {
+        return false;
+    }
+
+    AppEntry &entry = file->entry;
+    entry.id = id;
+    entry.name = unescape(name.value);
+    entry.genericName = unescape(genericName.value);
+    entry.comment = unescape(comment.value);
+    entry.exec = unescape(exec);
+    entry.icon = unescape(icon);
+    entry.keywords = unescape(keywords.value);
+    entry.path = path;
+    entry.workingDirectory = unescape(workingDirectory);
+    entry.terminal = terminal;
+    entry.startupNotify = startupNotify;
+    entry.noDisplay = noDisplay;
+
+    for (const QByteArray &category : categories.split(';')) {
+        for (const auto &known : CategoryKeys) {
+            if (category == known.key) {
+                entry.categories |= 1u << known.category;
+                if (entry.primaryCategory < 0) {
+                    entry.primaryCategory = known.category;
+                }
+                break;
+            }
+        }
+    }
+
+    // Programı kurulu olmayan dosya yok sayılır. Hidden'dan farklı olarak alttaki
+    // dizinlerdeki aynı kimliği gizlemez; çalışan kopya görünür kalır.
+    if (!hidden && !tryExec.isEmpty()) {
+        const QString program = unescape(tryExec);
+        const bool found = QFileInfo(program).isAbsolute()
+                               ? QFileInfo(program).isExecutable()
+                               : !QStandardPaths::findExecutable(program).isEmpty();
+        if (!found) {
+            return false;
+        }
+    }
+    file->hidden = hidden;
+    return true;
+}
+
+// Kimlik, kök dizine göre göreli yoldur; alt dizin ayırıcıları '-' olur
+QString desktopId(const QString &root, const QString &path)
+{
+    return path.mid(root.size() + 1).replace('/', '-');
+}
+
+struct FileRef {
+    QString path;
+    QString id;
+    int priority;
+};
+
+// Dosyalar iş parçacıklarına iş çalma yöntemiyle dağıtılır; çağıran da çalışır
+QVector<ParsedFile> parseFiles(const QVector<FileRef> &files)
+{
+    const QByteArray locale = currentLocale().toUtf8();
+    const QByteArray language = locale.left(locale.indexOf('_'));
+
+    QVector<ParsedFile> parsed(files.size());
+    QVector<char> ok(files.size(), 0);
+    ParsedFile *parsedData = parsed.data();
+    char *okData = ok.data();
+    std::atomic<int> next(0);
+
+    // Her iş parçacığı kendi dizinlerine yazar; vektörler paylaşılmaz
+    auto work = [&]() {
+        for (int i = next.fetch_add(1); i < files.size(); i = next.fetch_add(1)) {
+            okData[i] = parseDesktopFile(files.at(i).path, files.at(i).id, locale, language, &parsedData[i]);
+            parsedData[i].priority = files.at(i).priority;
+        }
+    };
+
+    QSemaphore done;
+    const int helpers = qMin(qBound(1, QThread::idealThreadCount(), 8) - 1, files.size() / 64);
+    for (int i = 0; i < helpers; ++i) {
+        QThreadPool::globalInstance()->start([&work, &done]() {
+            work();
+            done.release();
+        });
+    }
+    work();
+    done.acquire(helpers);
+
+    QVector<ParsedFile> result;
+    result.reserve(files.size());
+    for (int i = 0; i < files.size(); ++i) {
+        if (ok.at(i)) {
+            result.append(std::move(parsed[i]));
+        }
+    }
+    return result;
+}
+
+void scanDirectory(const QString &root, const QString &path, int priority,
+                   QVector<Directory> *directories, QVector<FileRef> *files)
+{
+    directories->append({ path, directoryMtime(path) });
+    for (const DirectoryEntry &entry : DirectoryScanner::scan(path)) {
+        const QString child = path + "/" + entry.name;
+        if (entry.isDir) {
+            scanDirectory(root, child, priority, directories, files);
+        } else if (entry.name.endsWith(".desktop")) {
+            files->append({ child, desktopId(root, child), priority });
+        }
+    }
+}
+
+class StringPool
+{
+public:
+    explicit StringPool(QByteArray *data) : m_data(data) {}
+
+    StringRef add(const QString &text)
+    {
+        const QByteArray utf8 = text.toUtf8();
+        StringRef ref;
+        ref.offset = quint32(m_data->size());
+        ref.length = quint32(utf8.size());
+        m_data->append(utf8);
+        return ref;
+    }
+
+private:
+    QByteArray *m_data;
+};
+
+} // namespace
+
+struct AppCatalog::State {
+    QStringList roots;
+    QString locale;
+    QVector<Directory> directories;
+    QVector<ParsedFile> files;
+    bool loaded = false;
+
+    void scanAll()
+    {
+        directories.clear();
+        QVector<FileRef> refs;
+        for (int i = 0; i < roots.size(); ++i) {
+            scanDirectory(roots.at(i), roots.at(i), i, &directories, &refs);
+        }
+        files = parseFiles(refs);
+        loaded = true;
+    }
+
+    // Sıcak açılıştan sonraki ilk değişiklikte durum önbellekten okunur
+    bool loadFrom(const QString &path)
+    {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            return false;
+        }
+        const QByteArray data = file.readAll();
+        const uchar *base = reinterpret_cast<const uchar *>(data.constData());
+        if (!checkLayout(base, data.size(), locale, roots.join(':'))) {
+            return false;
+        }
+
+        const CacheHeader *header = headerOf(base);
+        directories.clear();
+        for (quint32 i = 0; i < header->dirCount; ++i) {
+            directories.append({ cacheString(base, dirsOf(base)[i].path), dirsOf(base)[i].mtimeNs });
+        }
+        files.clear();
+        files.reserve(int(header->entryCount));
+        for (quint32 i = 0; i < header->entryCount; ++i) {
+            files.append(decodeRecord(base, entriesOf(base)[i]));
+        }
+        loaded = true;
+        return true;
+    }
+
+    QByteArray serialize() const
+    {
+        // Kimlik başına en öncelikli dosya kazanır; eşitlikte ilk bulunan
+        QVector<int> order(files.size());
+        for (int i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [this](int a, int b) {
+            return files.at(a).priority < files.at(b).priority;
+        });
+
+        QVector<quint8> flags(files.size(), 0);
+        QHash<QString, int> winners;
+        winners.reserve(files.size());
+        for (int index : order) {
+            const ParsedFile &file = files.at(index);
+            quint8 &flag = flags[index];
+            flag = (file.entry.terminal ? TerminalFlag : 0) | (file.entry.noDisplay ? NoDisplayFlag : 0)
+                   | (file.entry.startupNotify ? StartupNotifyFlag : 0) | (file.hidden ? HiddenFlag : 0);
+            if (winners.contains(file.entry.id)) {
+                flag |= ShadowedFlag;
+            } else {
+                winners.insert(file.entry.id, index);
+            }
+        }
+
+        QVector<quint32> byName, byId;
+        for (int index : qAsConst(winners)) {
+            if (flags.at(index) & HiddenFlag) {
+                continue;
+            }
+            byId.append(quint32(index));
+            if (!(flags.at(index) & NoDisplayFlag)) {
+                byName.append(quint32(index));
+            }
+        }
+        std::sort(byName.begin(), byName.end(), [this](quint32 a, quint32 b) {
+            return QString::localeAwareCompare(files.at(int(a)).entry.name, files.at(int(b)).entry.name) < 0;
+        });
+
+        // Kimlikler UTF-8 bayt sırasıyla dizilir; arama da aynı karşılaştırmayı kullanır
+        QVector<QByteArray> ids(files.size());
+        for (quint32 index : qAsConst(byId)) {
+            ids[int(index)] = files.at(int(index)).entry.id.toUtf8();
+        }
+        std::sort(byId.begin(), byId.end(), [&ids](quint32 a, quint32 b) {
+            return ids.at(int(a)) < ids.at(int(b));
+        });
+
+        CacheHeader header;
+        std::memset(&header, 0, sizeof(header));
+        header.magic = CacheMagic;
+        header.version = CacheVersion;
+        header.dirCount = quint32(directories.size());
+        header.entryCount = quint32(files.size());
+        header.visibleCount = quint32(byName.size());
+        header.idCount = quint32(byId.size());
+        header.dirsOffset = sizeof(CacheHeader);
+        header.entriesOffset = header.dirsOffset + header.dirCount * sizeof(DirRecord);
+        header.byNameOffset = header.entriesOffset + header.entryCount * sizeof(EntryRecord);
+        header.byIdOffset = header.byNameOffset + header.visibleCount * 4;
+        header.stringsOffset = header.byIdOffset + header.idCount * 4;
+
+        QByteArray data(int(header.stringsOffset), '\0');
+        StringPool pool(&data);
+        header.locale = pool.add(locale);
+        header.roots = pool.add(roots.join(':'));
+
+        QVector<DirRecord> dirRecords(directories.size());
+        for (int i = 0; i < directories.size(); ++i) {
+            dirRecords[i].mtimeNs = directories.at(i).mtimeNs;
+            dirRecords[i].path = pool.add(directories.at(i).path);
+        }
+        QVector<EntryRecord> entryRecords(files.size());
+        for (int i = 0; i < files.size(); ++i) {
+            const AppEntry &entry = files.at(i).entry;
+            EntryRecord &record = entryRecords[i];
+            record.id = pool.add(entry.id);
+            record.name = pool.add(entry.name);
+            record.genericName = pool.add(entry.genericName);
+            record.comment = pool.add(entry.comment);
+            record.exec = pool.add(entry.exec);
+            record.icon = pool.add(entry.icon);
+            record.keywords = pool.add(entry.keywords);
+            record.path = pool.add(entry.path);
+            record.workingDirectory = pool.add(entry.workingDirectory);
+            record.categories = entry.categories;
+            record.primaryCategory = qint8(entry.primaryCategory);
+            record.flags = flags.at(i);
+            record.priority = quint8(qMin(files.at(i).priority, 255));
+            record.reserved = 0;
+        }
+        header.fileSize = quint32(data.size());
+
+        // Sabit boyutlu bölümler dize havuzu dolduktan sonra yerine yazılır
+        char *out = data.data();
+        std::memcpy(out, &header, sizeof(header));
+        std::memcpy(out + header.dirsOffset, dirRecords.constData(), dirRecords.size() * sizeof(DirRecord));
+        std::memcpy(out + header.entriesOffset, entryRecords.constData(), entryRecords.size() * sizeof(EntryRecord));
+        std::memcpy(out + header.byNameOffset, byName.constData(), byName.size() * 4);
+        std::memcpy(out + header.byIdOffset, byId.constData(), byId.size() * 4);
+        return data;
+    }
+};
+
+namespace {
+
+bool writeCache(const QString &path, const QByteArray &data)
+{
+    QDir().mkpath(QFileInfo(path).path());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Uygulama önbelleği yazılamadı:" << path;
+        return false;
+    }
+    file.write(data);
+    return file.commit();
+}
+
+QStringList directoryPaths(const QVector<Directory> &directories)
+{
+    QStringList paths;
+    paths.reserve(directories.size());
+    for (const Directory &directory : directories) {
+        paths.append(directory.path);
+    }
+    return paths;
+}
+
+} // namespace
+
+AppCatalog *AppCatalog::instance()
+{
+    static AppCatalog *catalog = new AppCatalog(QCoreApplication::instance());
+    return catalog;
+}
+
+AppCatalog::AppCatalog(QObject *parent)
+    : QObject(parent)
+    , m_base(nullptr)
+    , m_size(0)
+    , m_worker(new QThreadPool(this))
+    , m_state(std::make_shared<State>())
+    , m_notifier(new FileChangeNotifier(this))
+{
+    // Tek çalışan: taramalar ve yazmalar sırayla, durum yalnızca onun elinde
+    m_worker->setMaxThreadCount(1);
+
+    m_state->roots = applicationRoots();
+    m_state->locale = currentLocale();
+
+    connect(m_notifier, &FileChangeNotifier::changesReady, this, &AppCatalog::applyChanges);
+
+    // Sıcak açılış: eşleme ve dizin zamanları dışında iş yoktur
+    if (mapCache() && directoriesUnchanged(m_base)) {
+        QStringList directories;
+        const CacheHeader *header = headerOf(m_base);
+        for (quint32 i = 0; i < header->dirCount; ++i) {
+            directories.append(cacheString(m_base, dirsOf(m_base)[i].path));
+        }
+        watchDirectories(directories);
+        return;
+    }
+
+    // Eski önbellek, yenisi hazır olana dek kullanılmaya devam eder
+    rebuild();
+}
+
+AppCatalog::~AppCatalog()
+{
+    m_worker->waitForDone();
+}
+
+QStringList AppCatalog::applicationRoots()
+{
+    // XDG_DATA_HOME önce gelir; aynı kimlik bulunduğunda o kazanır
+    QStringList roots;
+    QString dataHome = QFile::decodeName(qgetenv("XDG_DATA_HOME"));
+    if (dataHome.isEmpty()) {
+        dataHome = QDir::homePath() + "/.local/share";
+    }
+    roots.append(dataHome + "/applications");
+
+    QString dataDirs = QFile::decodeName(qgetenv("XDG_DATA_DIRS"));
+    if (dataDirs.isEmpty()) {
+        dataDirs = "/usr/local/share:/usr/share";
+    }
+    for (const QString &dir : dataDirs.split(':', Qt::SkipEmptyParts)) {
+        const QString root = QDir::cleanPath(dir) + "/applications";
+        if (!roots.contains(root)) {
+            roots.append(root);
+        }
+    }
+    return roots;
+}
+
+QString AppCatalog::cachePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + "/xenoraos/applications.cache";
+}
+
+bool AppCatalog::mapCache()
+{
+    std::unique_ptr<QFile> file(new QFile(cachePath()));
+    if (!file->open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const qint64 size = file->size();
+    const uchar *base = file->map(0, size);
+    if (!base || !checkLayout(base, size, m_state->locale, m_state->roots.join(':'))) {
+        return false;
+    }
+
+    // Önceki eşleme, QFile yok edilirken bırakılır
+    m_cacheFile = std::move(file);
+    m_data.clear();
+    m_base = base;
+    m_size = size;
+    return true;
+}
+
+void AppCatalog::adopt(const QByteArray &data)
+{
+    // Yeni yazılan dosya eşlenir; yazılamadıysa bellekteki kopya kullanılır
+    if (mapCache()) {
+        return;
+    }
+
+    m_cacheFile.reset();
+    m_data = data;
+    m_base = reinterpret_cast<const uchar *>(m_data.constData());
+    m_size = m_data.size();
+}
+
+void AppCatalog::publish(const QByteArray &data, const QStringList &directories)
+{
+    adopt(data);
+    watchDirectories(directories);
+    emit catalogChanged();
+}
+
+void AppCatalog::rebuild()
+{
+    AppCatalog *catalog = this;
+    std::shared_ptr<State> state = m_state;
+    const QString path = cachePath();
+    m_worker->start([catalog, state, path]() {
+        state->scanAll();
+        const QByteArray data = state->serialize();
+        writeCache(path, data);
+        const QStringList directories = directoryPaths(state->directories);
+        QMetaObject::invokeMethod(catalog, [catalog, data, directories]() {
+            catalog->publish(data, directories);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void AppCatalog::watchDirectories(const QStringList &directories)
+{
+    const QSet<QString> wanted(directories.begin(), directories.end());
+    for (const QString &directory : m_watched - wanted) {
+        m_notifier->removePath(directory);
+    }
+    for (const QString &directory : wanted - m_watched) {
+        // Var olmayan kök dizinler izlenemez; oluşturulmaları bir sonraki açılışta görülür
+        if (QFileInfo(directory).isDir()) {
+            m_notifier->addPath(directory);
+        }
+    }
+    m_watched = wanted;
+}
+
+void AppCatalog::applyChanges(const FileChangeBatch &batch)
+{
+    // Alt dizin eklendi ya da kaldırıldıysa ya da olaylar kaybolduysa baştan taranır
+    bool rescan = batch.overflow;
+    QStringList changed;
+    for (const QString &name : batch.created) {
+        const QString path = batch.directory + "/" + name;
+        if (name.endsWith(".desktop")) {
+            changed.append(path);
+        } else if (QFileInfo(path).isDir()) {
+            rescan = true;
+        }
+    }
+    for (const QString &name : batch.removed) {
+        const QString path = batch.directory + "/" + name;
+        if (name.endsWith(".desktop")) {
+            changed.append(path);
+        } else if (m_watched.contains(path)) {
+            rescan = true;
+        }
+    }
+    for (const QString &name : batch.modified) {
+        if (name.endsWith(".desktop")) {
+            changed.append(batch.directory + "/" + name);
+        }
+    }
+
+    if (rescan) {
+        rebuild();
+        return;
+    }
+    if (changed.isEmpty()) {
+        return;
+    }
+
+    // Yalnızca değişen dosyalar yeniden okunur; diğer kayıtlar olduğu gibi kalır
+    AppCatalog *catalog = this;
+    std::shared_ptr<State> state = m_state;
+    const QString path = cachePath();
+    m_worker->start([catalog, state, path, changed]() {
+        if (!state->loaded && !state->loadFrom(path)) {
+            state->scanAll();
+        } else {
+            const QSet<QString> changedSet(changed.begin(), changed.end());
+            QVector<ParsedFile> kept;
+            kept.reserve(state->files.size());
+            for (ParsedFile &file : state->files) {
+                if (!changedSet.contains(file.entry.path)) {
+                    kept.append(std::move(file));
+                }
+            }
+            state->files = std::move(kept);
+
+            QVector<FileRef> refs;
+            for (const QString &file : changed) {
+                if (!QFileInfo::exists(file)) {
+                    continue;
+                }
+                for (int i = 0; i < state->roots.size(); ++i) {
+                    const QString &root = state->roots.at(i);
+                    if (file.startsWith(root + "/")) {
+                        refs.append({ file, desktopId(root, file), i });
+                        break;
+                    }
+                }
+            }
+            state->files += parseFiles(refs);
+
+            for (Directory &directory : state->directories) {
+                directory.mtimeNs = directoryMtime(directory.path);
+            }
+        }
+
+        const QByteArray data = state->serialize();
+        writeCache(path, data);
+        const QStringList directories = directoryPaths(state->directories);
+        QMetaObject::invokeMethod(catalog, [catalog, data, directories]() {
+            catalog->publish(data, directories);
+        }, Qt::QueuedConnection);
+    });
+}
+
+int AppCatalog::count() const
+{
+    return m_base ? int(headerOf(m_base)->visibleCount) : 0;
+}
+
+AppEntry AppCatalog::entry(int index) const
+{
+    if (index < 0 || index >= count()) {
+        return AppEntry();
+    }
+    return decode(byNameOf(m_base)[index]);
+}
+
+QString AppCatalog::name(int index) const
+{
+    if (index < 0 || index >= count()) {
+        return QString();
+    }
+    return cacheString(m_base, entriesOf(m_base)[byNameOf(m_base)[index]].name);
+}
+
+QString AppCatalog::iconName(int index) const
+{
+    if (index < 0 || index >= count()) {
+        return QString();
+    }
+    return cacheString(m_base, entriesOf(m_base)[byNameOf(m_base)[index]].icon);
+}
+
+int AppCatalog::primaryCategory(int index) const
+{
+    if (index < 0 || index >= count()) {
+        return -1;
+    }
+    return entriesOf(m_base)[byNameOf(m_base)[index]].primaryCategory;
+}
+
+AppEntry AppCatalog::entry(const QString &desktopId) const
+{
+    if (!m_base) {
+        return AppEntry();
+    }
+
+    // Kimlikler önbellekte UTF-8 bayt sırasıyla dizilidir
+    const QByteArray id = desktopId.toUtf8();
+    const quint32 *byId = byIdOf(m_base);
+    const EntryRecord *entries = entriesOf(m_base);
+    int low = 0;
+    int high = int(headerOf(m_base)->idCount) - 1;
+    while (low <= high) {
+        const int middle = (low + high) / 2;
+        const StringRef &ref = entries[byId[middle]].id;
+        const int common = qMin(int(ref.length), id.size());
+        int order = std::memcmp(m_base + ref.offset, id.constData(), size_t(common));
+        if (order == 0) {
+            order = int(ref.length) - id.size();
+        }
+        if (order == 0) {
+            return decode(byId[middle]);
+        }
+        if (order < 0) {
+            low = middle + 1;
+        } else {
+            high = middle - 1;
+        }
+    }
+    return AppEntry();
+}
+
+AppEntry AppCatalog::firstInstalled(const QStringList &desktopIds) const
+{
+    for (const QString &id : desktopIds) {
+        AppEntry found = entry(id);
+        if (found.isValid()) {
+            return found;
+        }
+    }
+    return AppEntry();
+}
+
+AppEntry AppCatalog::decode(quint32 record) const
+{
+    return decodeRecord(m_base, entriesOf(m_base)[record]).entry;
+}
+
+QString AppCatalog::categoryName(int category)
+{
+    switch (category) {
+    case AudioVideo: return "Çoklu Ortam";
+    case Development: return "Geliştirme";
+    case Education: return "Eğitim";
+    case Game: return "Oyunlar";
+    case Graphics: return "Grafik";
+    case Network: return "İnternet";
+    case Office: return "Ofis";
+    case Science: return "Bilim";
+    case Settings: return "Ayarlar";
+    case System: return "Sistem";
+    case Utility: return "Donatılar";
+    default: return "Diğer";
+    }
+}
+
+QString AppCatalog::categoryIcon(int category)
+{
+    switch (category) {
+    case AudioVideo: return "applications-multimedia";
+    case Development: return "applications-development";
+    case Education: return "applications-education";
+    case Game: return "applications-games";
+    case Graphics: return "applications-graphics";
+    case Network: return "applications-internet";
+    case Office: return "applications-office";
+    case Science: return "applications-science";
+    case Settings: return "preferences-system";
+    case System: return "applications-system";
+    case Utility: return "applications-utilities";
+    default: return "applications-other";
+    }
+}
+
+QString AppCatalog::plainCommand(const QString &exec)
+{
+    // %% tek bir % olur; diğer alan kodları (dosya, URL, simge, ...) atılır
+    QString command;
+    command.reserve(exec.size());
+    for (int i = 0; i < exec.size(); ++i) {
+        if (exec.at(i) != '%' || i + 1 == exec.size()) {
+            command.append(exec.at(i));
+            continue;
+        }
+        if (exec.at(++i) == '%') {
+            command.append('%');
+        }
+    }
+    return command.simplified();
+}
+
+AppEntry AppCatalog::readDesktopFile(const QString &path)
+{
+    const QByteArray locale = currentLocale().toUtf8();
+    const QByteArray language = locale.left(locale.indexOf('_'));
+
+    ParsedFile parsed;
+    if (!parseDesktopFile(path, QFileInfo(path).fileName(), locale, language, &parsed) || parsed.hidden) {
+        return AppEntry();
+    }
+    return parsed.entry;
+}
@@ -0,0 +1,124 @@
+#ifndef APPCATALOG_H
+#define APPCATALOG_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <memory>
+
+class QFile;
+class QThreadPool;
+class FileChangeNotifier;
+struct FileChangeBatch;
+
+// Bir .desktop dosyasından menü ve başlatma için gereken alanlar
+struct AppEntry {
+    QString id;               // Masaüstü dosya kimliği (ör. "org.gnome.Terminal.desktop")
+    QString name;             // Yerelleştirilmiş Name
+    QString genericName;
+    QString comment;
+    QString exec;             // Alan kodları açılmamış Exec satırı
+    QString icon;             // Tema simgesi adı ya da tam yol
+    QString keywords;         // ';' ile ayrılmış, yerelleştirilmiş
+    QString path;             // .desktop dosyasının tam yolu
+    QString workingDirectory; // Path anahtarı
+    quint32 categories = 0;   // AppCatalog::Category bitleri
+    int primaryCategory = -1; // Menüde gösterildiği ana kategori (dizin)
+    bool terminal = false;
+    bool startupNotify = false;
+    bool noDisplay = false;
+
+    bool isValid() const { return !id.isEmpty(); }
+};
+
+// XDG_DATA_HOME ve XDG_DATA_DIRS altındaki bütün uygulama (.desktop)
+// dosyalarının dizini. Dosyalar arka planda, iş parçacıklarına bölünerek
+// ayrıştırılır ve sonuç tek bir ikili önbellek dosyasına yazılır. Açılışta
+// önbellek belleğe eşlenir (mmap); dizinlerin değişiklik zamanları
+// önbellektekilerle aynıysa hiçbir .desktop dosyası okunmaz. Kayıtlar
+// ada ve kimliğe göre önceden sıralıdır; menü kurmak dizelere dokunmadan
+// yapılabilir, ad yalnızca gösterilen öğeler için çözülür. Çalışırken
+// dizinler inotify ile izlenir ve yalnızca değişen dosyalar yeniden okunur.
+class AppCatalog : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Freedesktop ana kategorileri; menü sırası budur
+    enum Category {
+        AudioVideo,
+        Development,
+        Education,
+        Game,
+        Graphics,
+        Network,
+        Office,
+        Science,
+        Settings,
+        System,
+        Utility,
+        CategoryCount
+    };
+
+    static AppCatalog *instance();
+    ~AppCatalog();
+
+    // İlk tarama ya da önbellek yüklemesi bitti mi
+    bool isReady() const { return m_base != nullptr; }
+
+    // Menüde gösterilen uygulamalar, yerelleştirilmiş ada göre sıralı
+    int count() const;
+    AppEntry entry(int index) const;
+    QString name(int index) const;
+    QString iconName(int index) const;
+    int primaryCategory(int index) const;
+
+    // Kimliğe göre ikili arama; NoDisplay olanlar da bulunur
+    AppEntry entry(const QString &desktopId) const;
+    // Verilen kimliklerden kurulu olan ilkini döndürür
+    AppEntry firstInstalled(const QStringList &desktopIds) const;
+
+    static QString categoryName(int category);
+    static QString categoryIcon(int category);
+
+    // Exec satırından alan kodlarını (%f, %U, ...) atar; program adını bulmak için
+    static QString plainCommand(const QString &exec);
+    // Katalog dışındaki tek bir .desktop dosyası (ör. masaüstündeki); geçersizse boş
+    static AppEntry readDesktopFile(const QString &path);
+
+signals:
+    void catalogChanged();
+
+private slots:
+    void applyChanges(const FileChangeBatch &batch);
+
+private:
+    explicit AppCatalog(QObject *parent = nullptr);
+
+    struct State;
+
+    static QStringList applicationRoots();
+    static QString cachePath();
+
+    bool mapCache();
+    void adopt(const QByteArray &data);
+    void rebuild();
+    void watchDirectories(const QStringList &directories);
+    void publish(const QByteArray &data, const QStringList &directories);
+
+    AppEntry decode(quint32 record) const;
+
+    std::unique_ptr<QFile> m_cacheFile;
+    QByteArray m_data;       // Önbellek yazılamadıysa bellekteki kopya
+    const uchar *m_base;
+    qint64 m_size;
+
+    QThreadPool *m_worker;   // Tarama ve yazmalar sırayla yapılır
+    std::shared_ptr<State> m_state;
+    FileChangeNotifier *m_notifier;
+    QSet<QString> m_watched;
+};
+
+#endif // APPCATALOG_H
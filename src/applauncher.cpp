@@ -0,0 +1,624 @@
+#include "applauncher.h"
+#include "appcatalog.h"
+#include "usagestore.h"
+#include "xconnection.h"
+#include <QByteArrayList>
+#include <QCoreApplication>
+#include <QCursor>
+#include <QFile>
+#include <QFileInfo>
+#include <QGuiApplication>
+#include <QProcessEnvironment>
+#include <QSocketNotifier>
+#include <QStandardPaths>
+#include <QSysInfo>
+#include <QThreadPool>
+#include <QTimer>
+#include <QX11Info>
+#include <QDebug>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+// posix_spawn dosya eylemleri glibc sürümüne göre
+#if defined(__GLIBC__) && defined(__GLIBC_PREREQ)
+#if __GLIBC_PREREQ(2, 29)
+#define SPAWN_HAS_CHDIR 1
+#endif
+#if __GLIBC_PREREQ(2, 34)
+#define SPAWN_HAS_CLOSEFROM 1
+#endif
+#endif
+
+namespace {
+
+// İlk pencere bu süre içinde açılmazsa geri bildirim kaldırılır (ms)
+const int StartupTimeout = 15000;
+
+// pidfd yokken çocukların yoklanma aralığı (ms)
+const int ReapInterval = 1000;
+
+struct ExecToken {
+    QString text;
+    bool quoted;
+};
+
+// Spesifikasyondaki ayrıştırma: boşluk ayırır, çift tırnak gruplar; tırnak
+// içinde yalnızca " ` $ \ ters bölüyle kaçışlanır. Kapanmayan tırnak geçersizdir.
+bool tokenize(const QString &exec, QVector<ExecToken> *tokens)
+{
+    QString current;
+    bool inQuotes = false;
+    bool inToken = false;
+    bool quoted = false;
+
+    for (int i = 0; i < exec.size(); ++i) {
+        const QChar c = exec.at(i);
+        if (inQuotes) {
+            if (c == '\\' && i + 1 < exec.size() && QStringLiteral("\"`$\\").contains(exec.at(i + 1))) {
+                current.append(exec.at(++i));
+            } else if (c == '"') {
+                inQuotes = false;
+            } else {
+                current.append(c);
+            }
+        } else if (c == ' ' || c == '\t' || c == '\n') {
+            if (inToken) {
+                tokens->append({ current, quoted });
+                current.clear();
+                inToken = false;
+                quoted = false;
+            }
+        } else if (c == '"') {
+            inQuotes = true;
+            inToken = true;
+            quoted = true;
+        } else {
+            current.append(c);
+            inToken = true;
+        }
+    }
+
+    if (inQuotes) {
+        return false;
+    }
+    if (inToken) {
+        tokens->append({ current, quoted });
+    }
+    return true;
+}
+
+// Yerel dosyalar yol olarak, diğerleri URL olarak verilir
+QString urlArgument(const QUrl &url)
+{
+    return url.isLocalFile() ? url.toLocalFile() : url.toString(QUrl::FullyEncoded);
+}
+
+QStringList expandTokens(const QVector<ExecToken> &tokens, const AppEntry &entry, const QList<QUrl> &urls)
+{
+    QStringList arguments;
+    for (const ExecToken &token : tokens) {
+        // Tırnak içinde alan kodu kullanılamaz; değer olduğu gibi geçer
+        if (token.quoted) {
+            arguments.append(token.text);
+            continue;
+        }
+
+        // Liste kodları yalnızca tek başına bir argüman olabilir
+        if (token.text == "%F") {
+            for (const QUrl &url : urls) {
+                if (url.isLocalFile()) {
+                    arguments.append(url.toLocalFile());
+                }
+            }
+            continue;
+        }
+        if (token.text == "%U") {
+            for (const QUrl &url : urls) {
+                arguments.append(urlArgument(url));
+            }
+            continue;
+        }
+        if (token.text == "%i") {
+            if (!entry.icon.isEmpty()) {
+                arguments << "--icon" << entry.icon;
+            }
+            continue;
+        }
+
+        QString argument;
+        bool expanded = false;
+        const QString &text = token.text;
+        for (int i = 0; i < text.size(); ++i) {
+            if (text.at(i) != '%' || i + 1 == text.size()) {
+                argument.append(text.at(i));
+                continue;
+            }
+            expanded = true;
+            switch (text.at(++i).unicode()) {
+            case '%':
+                argument.append('%');
+                break;
+            case 'f':
+                if (!urls.isEmpty() && urls.first().isLocalFile()) {
+                    argument.append(urls.first().toLocalFile());
+                }
+                break;
+            case 'u':
+                if (!urls.isEmpty()) {
+                    argument.append(urlArgument(urls.first()));
+                }
+                break;
+            case 'c':
+                argument.append(entry.name);
+                break;
+            case 'k':
+                argument.append(entry.path);
+                break;
+            default:
+                // Eskimiş (%d %D %n %N %v %m) ve yanlış yerdeki kodlar atılır
+                break;
+            }
+        }
+
+        // Yalnızca boş açılan bir koddan oluşan argüman hiç verilmez
+        if (expanded && argument.isEmpty()) {
+            continue;
+        }
+        arguments.append(argument);
+    }
+    return arguments;
+}
+
+// Terminal=true uygulamaları için terminal öykünücüsü
+QStringList terminalCommand()
+{
+    const QString terminal = QString::fromLocal8Bit(qgetenv("TERMINAL"));
+    if (!terminal.isEmpty() && !QStandardPaths::findExecutable(terminal).isEmpty()) {
+        return { terminal, "-e" };
+    }
+    for (const QString &candidate : { QStringLiteral("x-terminal-emulator"), QStringLiteral("xterm") }) {
+        if (!QStandardPaths::findExecutable(candidate).isEmpty()) {
+            return { candidate, "-e" };
+        }
+    }
+    return QStringList();
+}
+
+// Başlatma bildirimi değerleri: boşluk ve tırnak içerebilir
+QByteArray quoted(const QString &value)
+{
+    QByteArray result = value.toUtf8();
+    result.replace('\\', "\\\\");
+    result.replace('"', "\\\"");
+    return '"' + result + '"';
+}
+
+// posix_spawn çalışan iş parçacığında çağrılır. Çocuk kendi süreç
+// grubunda, boş sinyal maskesi ve varsayılan sinyal işleyicileriyle başlar;
+// stdin /dev/null olur. glibc posix_spawn'ı CLONE_VFORK ile yapar: kabuğun
+// belleği kopyalanmaz.
+int spawnProcess(const QByteArrayList &arguments, const QByteArrayList &environment,
+                 const QByteArray &workingDirectory, pid_t *pid)
+{
+    QByteArrayList argumentData = arguments;
+#ifndef SPAWN_HAS_CHDIR
+    // Dizin değiştirme eylemi yoksa kabuk dizini değiştirip programı çalıştırır
+    if (!workingDirectory.isEmpty()) {
+        argumentData = QByteArrayList { "/bin/sh", "-c", "cd \"$0\" && exec \"$@\"", workingDirectory }
+                       + arguments;
+    }
+#endif
+
+    std::vector<char *> argv;
+    for (QByteArray &argument : argumentData) {
+        argv.push_back(argument.data());
+    }
+    argv.push_back(nullptr);
+
+    QByteArrayList environmentData = environment;
+    std::vector<char *> envp;
+    for (QByteArray &variable : environmentData) {
+        envp.push_back(variable.data());
+    }
+    envp.push_back(nullptr);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+#ifdef SPAWN_HAS_CHDIR
+    if (!workingDirectory.isEmpty()) {
+        posix_spawn_file_actions_addchdir_np(&actions, workingDirectory.constData());
+    }
+#endif
+#ifdef SPAWN_HAS_CLOSEFROM
+    // Kabuğun CLOEXEC olmadan açılmış tanımlayıcıları uygulamaya sızmaz
+    posix_spawn_file_actions_addclosefrom_np(&actions, STDERR_FILENO + 1);
+#endif
+
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigset_t defaults;
+    sigfillset(&defaults);
+    sigdelset(&defaults, SIGKILL);
+    sigdelset(&defaults, SIGSTOP);
+
+    posix_spawnattr_t attributes;
+    posix_spawnattr_init(&attributes);
+    posix_spawnattr_setsigmask(&attributes, &mask);
+    posix_spawnattr_setsigdefault(&attributes, &defaults);
+    posix_spawnattr_setpgroup(&attributes, 0);
+    posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETPGROUP | POSIX_SPAWN_SETSIGMASK
+                                              | POSIX_SPAWN_SETSIGDEF);
+
+    const int error = posix_spawnp(pid, argv.front(), &actions, &attributes, argv.data(), envp.data());
+
+    posix_spawnattr_destroy(&attributes);
+    posix_spawn_file_actions_destroy(&actions);
+    return error;
+}
+
+// XConnection iş parçacığında çalışır; durağan değişkenlere yalnızca o dokunur.
+// İleti NUL ile biter ve 20 baytlık parçalar halinde köke gönderilir (ilki
+// _NET_STARTUP_INFO_BEGIN, diğerleri _NET_STARTUP_INFO).
+void sendStartupInfo(xcb_connection_t *connection, xcb_window_t root, const QByteArray &message)
+{
+    static xcb_atom_t beginAtom = XCB_ATOM_NONE;
+    static xcb_atom_t infoAtom = XCB_ATOM_NONE;
+    static xcb_window_t sender = XCB_WINDOW_NONE;
+
+    if (sender == XCB_WINDOW_NONE) {
+        const char *beginName = "_NET_STARTUP_INFO_BEGIN";
+        const char *infoName = "_NET_STARTUP_INFO";
+        const xcb_intern_atom_cookie_t beginCookie = xcb_intern_atom(connection, false, strlen(beginName), beginName);
+        const xcb_intern_atom_cookie_t infoCookie = xcb_intern_atom(connection, false, strlen(infoName), infoName);
+        xcb_intern_atom_reply_t *beginReply = xcb_intern_atom_reply(connection, beginCookie, nullptr);
+        xcb_intern_atom_reply_t *infoReply = xcb_intern_atom_reply(connection, infoCookie, nullptr);
+        if (beginReply) {
+            beginAtom = beginReply->atom;
+        }
+        if (infoReply) {
+            infoAtom = infoReply->atom;
+        }
+        free(beginReply);
+        free(infoReply);
+        if (beginAtom == XCB_ATOM_NONE || infoAtom == XCB_ATOM_NONE) {
+            return;
+        }
+
+        // İletiler bir pencere adına gönderilmeli; hiç eşlenmez
+        sender = xcb_generate_id(connection);
+        const uint32_t overrideRedirect = 1;
+        xcb_create_window(connection, 0, sender, root, -100, -100, 1, 1, 0,
+                          XCB_WINDOW_CLASS_INPUT_ONLY, XCB_COPY_FROM_PARENT,
+                          XCB_CW_OVERRIDE_REDIRECT, &overrideRedirect);
+    }
+
+    QByteArray data = message;
+    data.append('\0');
+    for (int offset = 0; offset < data.size(); offset += 20) {
+        xcb_client_message_event_t event;
+        std::memset(&event, 0, sizeof(event));
+        event.response_type = XCB_CLIENT_MESSAGE;
+        event.format = 8;
+        event.window = sender;
+        event.type = offset == 0 ? beginAtom : infoAtom;
+        std::memcpy(event.data.data8, data.constData() + offset, size_t(qMin(20, data.size() - offset)));
+        xcb_send_event(connection, false, root, XCB_EVENT_MASK_PROPERTY_CHANGE,
+                       reinterpret_cast<const char *>(&event));
+    }
+    xcb_flush(connection);
+}
+
+} // namespace
+
+AppLauncher *AppLauncher::instance()
+{
+    static AppLauncher *launcher = new AppLauncher(QCoreApplication::instance());
+    return launcher;
+}
+
+AppLauncher::AppLauncher(QObject *parent)
+    : QObject(parent)
+    , m_worker(new QThreadPool(this))
+    , m_reapTimer(new QTimer(this))
+    , m_nextId(1)
+{
+    // Tek çalışan: başlatmalar istendiği sırayla yapılır
+    m_worker->setMaxThreadCount(1);
+
+    m_reapTimer->setInterval(ReapInterval);
+    connect(m_reapTimer, &QTimer::timeout, this, &AppLauncher::reapChildren);
+}
+
+AppLauncher::~AppLauncher()
+{
+    m_worker->waitForDone();
+}
+
+QStringList AppLauncher::splitExec(const QString &exec)
+{
+    QVector<ExecToken> tokens;
+    if (!tokenize(exec, &tokens)) {
+        return QStringList();
+    }
+
+    QStringList arguments;
+    for (const ExecToken &token : qAsConst(tokens)) {
+        arguments.append(token.text);
+    }
+    return arguments;
+}
+
+QVector<QStringList> AppLauncher::commandLines(const AppEntry &entry, const QList<QUrl> &urls)
+{
+    QVector<ExecToken> tokens;
+    if (!tokenize(entry.exec, &tokens) || tokens.isEmpty()) {
+        return QVector<QStringList>();
+    }
+
+    // %f/%u tek dosya alır: birden çok dosya için uygulama dosya başına çalıştırılır
+    bool singleFile = false;
+    bool fileList = false;
+    for (const ExecToken &token : qAsConst(tokens)) {
+        if (token.quoted) {
+            continue;
+        }
+        singleFile = singleFile || token.text.contains("%f") || token.text.contains("%u");
+        fileList = fileList || token.text == "%F" || token.text == "%U";
+    }
+
+    QVector<QList<QUrl>> invocations;
+    if (singleFile && !fileList && urls.size() > 1) {
+        for (const QUrl &url : urls) {
+            invocations.append({ url });
+        }
+    } else {
+        invocations.append(urls);
+    }
+
+    const QStringList terminal = entry.terminal ? terminalCommand() : QStringList();
+    QVector<QStringList> commands;
+    for (const QList<QUrl> &files : qAsConst(invocations)) {
+        const QStringList arguments = expandTokens(tokens, entry, files);
+        if (!arguments.isEmpty()) {
+            commands.append(terminal + arguments);
+        }
+    }
+    return commands;
+}
+
+bool AppLauncher::launch(const AppEntry &entry, const QList<QUrl> &urls)
+{
+    const QVector<QStringList> commands = commandLines(entry, urls);
+    if (commands.isEmpty()) {
+        return false;
+    }
+
+    // Katalog dışı komutlar Exec satırıyla sayılır (elle eklenen favoriler)
+    UsageStore::instance()->recordLaunch(entry.id.isEmpty() ? entry.exec : entry.id);
+
+    QString desktopName = entry.id.toLower();
+    if (desktopName.endsWith(".desktop")) {
+        desktopName.chop(8);
+    }
+
+    bool ok = true;
+    for (const QStringList &arguments : commands) {
+        Launch launch;
+        launch.name = entry.name;
+        launch.iconName = entry.icon;
+        launch.desktopName = desktopName;
+        ok = start(launch, arguments, entry.workingDirectory, entry.startupNotify) && ok;
+    }
+    return ok;
+}
+
+bool AppLauncher::launchCommand(const QString &command, const QString &name, const QString &iconName)
+{
+    AppEntry entry;
+    entry.exec = command;
+    entry.name = name;
+    entry.icon = iconName;
+    return launch(entry);
+}
+
+bool AppLauncher::launchProgram(const QString &program, const QStringList &arguments)
+{
+    Launch launch;
+    launch.name = QFileInfo(program).fileName();
+    return start(launch, QStringList(program) + arguments, QString(), false);
+}
+
+bool AppLauncher::start(Launch launch, const QStringList &arguments, const QString &workingDirectory,
+                        bool notify)
+{
+    if (arguments.isEmpty() || arguments.first().isEmpty()) {
+        return false;
+    }
+
+    launch.id = m_nextId++;
+    launch.program = QFileInfo(arguments.first()).fileName().toLower();
+    if (launch.name.isEmpty()) {
+        launch.name = QFileInfo(arguments.first()).fileName();
+    }
+
+    // Kabuğun kendi başlatma kimliği çocuklara geçmez
+    QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+    environment.remove("DESKTOP_STARTUP_ID");
+    if (notify && XConnection::instance()->isValid()) {
+        launch.startupId = startupId(launch.program);
+        environment.insert("DESKTOP_STARTUP_ID", QString::fromUtf8(launch.startupId));
+    }
+
+    QByteArrayList argv;
+    for (const QString &argument : arguments) {
+        argv.append(QFile::encodeName(argument));
+    }
+    QByteArrayList envp;
+    for (const QString &variable : environment.toStringList()) {
+        envp.append(variable.toLocal8Bit());
+    }
+    const QByteArray directory = QFile::encodeName(workingDirectory);
+
+    if (!launch.startupId.isEmpty()) {
+        sendStartupMessage("new: ID=" + quoted(QString::fromUtf8(launch.startupId))
+                           + " NAME=" + quoted(launch.name)
+                           + " SCREEN=" + QByteArray::number(QX11Info::appScreen())
+                           + " BIN=" + quoted(launch.program)
+                           + (launch.iconName.isEmpty() ? QByteArray() : " ICON=" + quoted(launch.iconName))
+                           + " DESCRIPTION=" + quoted("Başlatılıyor: " + launch.name));
+    }
+
+    // Meşgul imleci ilk başlatmayla konur, sonuncusu bitince kaldırılır
+    if (m_launches.isEmpty()) {
+        QGuiApplication::setOverrideCursor(QCursor(Qt::BusyCursor));
+    }
+    const int id = launch.id;
+    m_launches.insert(id, launch);
+    emit launchStarted(id, launch.name, launch.iconName);
+    QTimer::singleShot(StartupTimeout, this, [this, id]() { finish(id); });
+
+    AppLauncher *launcher = this;
+    m_worker->start([launcher, id, argv, envp, directory]() {
+        pid_t pid = 0;
+        const int error = spawnProcess(argv, envp, directory, &pid);
+        QMetaObject::invokeMethod(launcher, [launcher, id, pid, error]() {
+            launcher->spawned(id, pid, error);
+        }, Qt::QueuedConnection);
+    });
+    return true;
+}
+
+void AppLauncher::spawned(int id, qint64 pid, int error)
+{
+    if (error != 0) {
+        qWarning() << "Uygulama başlatılamadı:" << m_launches.value(id).program << strerror(error);
+        finish(id);
+        return;
+    }
+
+    auto it = m_launches.find(id);
+    if (it != m_launches.end()) {
+        it->pid = pid;
+    }
+    // Geri bildirim bitmiş olsa da çocuk toplanmalı
+    watchChild(pid, id);
+}
+
+void AppLauncher::watchChild(qint64 pid, int id)
+{
+    m_children.insert(pid, id);
+
+#ifdef SYS_pidfd_open
+    // pidfd süreç bitince okunabilir olur; yoklama gerekmez (Linux 5.3+)
+    const int fd = int(syscall(SYS_pidfd_open, pid_t(pid), 0));
+    if (fd >= 0) {
+        QSocketNotifier *notifier = new QSocketNotifier(fd, QSocketNotifier::Read, this);
+        connect(notifier, &QSocketNotifier::activated, this, &AppLauncher::reapChildren);
+        m_pidfds.insert(pid, notifier);
+        return;
+    }
+#endif
+
+    m_reapTimer->start();
+}
+
+void AppLauncher::reapChildren()
+{
+    const QList<qint64> children = m_children.keys();
+    for (qint64 pid : children) {
+        int status = 0;
+        const pid_t result = waitpid(pid_t(pid), &status, WNOHANG);
+        if (result == 0 || (result < 0 && errno == EINTR)) {
+            continue;
+        }
+
+        if (QSocketNotifier *notifier = m_pidfds.take(pid)) {
+            notifier->setEnabled(false);
+            ::close(int(notifier->socket()));
+            notifier->deleteLater();
+        }
+        // Penceresi açılmadan biten uygulamanın geri bildirimi kalkar
+        finish(m_children.take(pid));
+    }
+
+    if (m_children.size() == m_pidfds.size()) {
+        m_reapTimer->stop();
+    }
+}
+
+void AppLauncher::windowMapped(qint64 pid, const QString &wmClass, const QString &wmInstance)
+{
+    if (m_launches.isEmpty()) {
+        return;
+    }
+
+    // Pid kesin eşleşmedir; uygulama başka bir süreçten açılıyorsa WM_CLASS
+    // program adıyla ya da .desktop kimliğiyle karşılaştırılır
+    const QString windowClass = wmClass.toLower();
+    const QString instance = wmInstance.toLower();
+    int match = 0;
+    for (const Launch &launch : qAsConst(m_launches)) {
+        const bool matches = (pid > 0 && launch.pid == pid)
+                             || launch.program == instance || launch.program == windowClass
+                             || (!launch.desktopName.isEmpty()
+                                 && (launch.desktopName == windowClass
+                                     || launch.desktopName.endsWith('.' + windowClass)));
+        // Aynı uygulama birden çok kez başlatıldıysa en eskisi biter
+        if (matches && (match == 0 || launch.id < match)) {
+            match = launch.id;
+        }
+    }
+    if (match != 0) {
+        finish(match);
+    }
+}
+
+void AppLauncher::finish(int id)
+{
+    auto it = m_launches.find(id);
+    if (it == m_launches.end()) {
+        return;
+    }
+
+    if (!it->startupId.isEmpty()) {
+        sendStartupMessage("remove: ID=" + quoted(QString::fromUtf8(it->startupId)));
+    }
+    m_launches.erase(it);
+    emit launchFinished(id);
+
+    if (m_launches.isEmpty()) {
+        QGuiApplication::restoreOverrideCursor();
+    }
+}
+
+QByteArray AppLauncher::startupId(const QString &program)
+{
+    // Spesifikasyonun önerdiği biçim; _TIME, odak çalma önlemesi için kullanıcı zamanıdır
+    QByteArray id = "xenora-ui/" + QFile::encodeName(program)
+                    + '/' + QByteArray::number(QCoreApplication::applicationPid())
+                    + '-' + QByteArray::number(m_nextId)
+                    + '-' + QSysInfo::machineHostName().toUtf8();
+    id.replace(' ', '_');
+    return id + "_TIME" + QByteArray::number(QX11Info::appUserTime());
+}
+
+void AppLauncher::sendStartupMessage(const QByteArray &message)
+{
+    XConnection *x = XConnection::instance();
+    if (!x->isValid()) {
+        return;
+    }
+
+    const xcb_window_t root = x->rootWindow();
+    x->post([root, message](xcb_connection_t *connection) {
+        sendStartupInfo(connection, root, message);
+    });
+}
@@ -0,0 +1,87 @@
+#ifndef APPLAUNCHER_H
+#define APPLAUNCHER_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QStringList>
+#include <QUrl>
+#include <QVector>
+
+class QSocketNotifier;
+class QThreadPool;
+class QTimer;
+struct AppEntry;
+
+// Kabuktan uygulama başlatmanın tek yolu. Exec satırı masaüstü girdisi
+// spesifikasyonuna göre argümanlara bölünür ve alan kodları açılır.
+// Süreçler posix_spawn ile, tek bir arka plan iş parçacığında oluşturulur;
+// GUI iş parçacığı fork/exec beklemez. Her uygulama kendi süreç grubunda
+// başlar ve sinyal maskesi/işleyicileri sıfırlanır; çocuklar pidfd ile
+// izlenip toplanır. StartupNotify=true olan uygulamalara
+// DESKTOP_STARTUP_ID verilir ve başlatma bildirimi (_NET_STARTUP_INFO)
+// yayılır. İlk penceresi açılana, süreç bitene ya da süre dolana dek
+// meşgul imleci gösterilir ve launchStarted/launchFinished sinyalleriyle
+// görev çubuğuna yer tutucu düğme konur.
+class AppLauncher : public QObject
+{
+    Q_OBJECT
+
+public:
+    static AppLauncher *instance();
+    ~AppLauncher();
+
+    // Masaüstü girdisini başlatır; dosyalar %f/%F/%u/%U alan kodlarına verilir.
+    // Başlatma UsageStore'a kimliğiyle (kimlik yoksa Exec satırıyla) yazılır
+    bool launch(const AppEntry &entry, const QList<QUrl> &urls = QList<QUrl>());
+    // Exec biçiminde düz komut (ör. elle eklenen favoriler)
+    bool launchCommand(const QString &command, const QString &name = QString(),
+                       const QString &iconName = QString());
+    // Programı verilen argümanlarla başlatır (ör. "İle Aç...")
+    bool launchProgram(const QString &program, const QStringList &arguments);
+
+    // Exec satırını argümanlara böler: tırnaklar ve \" \` \$ \\ kaçışları
+    static QStringList splitExec(const QString &exec);
+    // Alan kodları açılmış komut satırları; %f/%u ile birden çok dosya
+    // verilirse dosya başına bir komut döner
+    static QVector<QStringList> commandLines(const AppEntry &entry, const QList<QUrl> &urls);
+
+    // Görev çubuğu yeni bir pencere gördüğünde çağırır; eşleşen başlatma biter
+    void windowMapped(qint64 pid, const QString &wmClass, const QString &wmInstance);
+
+signals:
+    void launchStarted(int id, const QString &name, const QString &iconName);
+    void launchFinished(int id);
+
+private:
+    explicit AppLauncher(QObject *parent = nullptr);
+
+    struct Launch {
+        int id = 0;
+        QString name;
+        QString iconName;
+        QByteArray startupId;   // Boşsa başlatma bildirimi yoktur
+        QString program;        // Küçük harf program adı (WM_CLASS eşleşmesi için)
+        QString desktopName;    // Küçük harf .desktop kimliği, uzantısız
+        qint64 pid = 0;
+    };
+
+    bool start(Launch launch, const QStringList &arguments, const QString &workingDirectory,
+               bool notify);
+    void spawned(int id, qint64 pid, int error);
+    void watchChild(qint64 pid, int id);
+    void reapChildren();
+    void finish(int id);
+
+    QByteArray startupId(const QString &program);
+    void sendStartupMessage(const QByteArray &message);
+
+    QThreadPool *m_worker;               // posix_spawn çağrıları sırayla burada
+    QHash<int, Launch> m_launches;       // Penceresi beklenen başlatmalar
+    QHash<qint64, int> m_children;       // Toplanmamış çocuk pid -> başlatma
+    QHash<qint64, QSocketNotifier *> m_pidfds;
+    QTimer *m_reapTimer;                 // pidfd yoksa çocuklar yoklanarak toplanır
+    int m_nextId;
+};
+
+#endif // APPLAUNCHER_H
@@ -0,0 +1,506 @@
+#include "appprefetcher.h"
+#include "appcatalog.h"
+#include "applauncher.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QQueue>
+#include <QStandardPaths>
+#include <QThread>
+#include <QThreadPool>
+#include <QTimer>
+#include <QDebug>
+#include <algorithm>
+#include <cstring>
+#include <elf.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+// Son prefetch isteğinden sonra bu kadar olay yoksa kabuk boşta sayılır (ms)
+const int IdleDelay = 10000;
+
+// Bir turda okunmaya verilen en fazla veri; büyük bir tarayıcı ve
+// kütüphaneleri sığar, belleği az sistemlerde önbellek süpürülmez
+const qint64 MaxPrefetchBytes = 512 * 1024 * 1024;
+
+// linux/ioprio.h: IOPRIO_WHO_PROCESS, IOPRIO_CLASS_IDLE
+const int IoprioWhoProcess = 1;
+const int IoprioClassIdle = 3;
+const int IoprioClassShift = 13;
+
+struct ElfInfo {
+    bool is64 = false;
+    quint16 machine = 0;
+    QString interpreter;     // PT_INTERP (dinamik yükleyici)
+    QStringList needed;      // DT_NEEDED
+    QStringList rpath;       // DT_RPATH
+    QStringList runpath;     // DT_RUNPATH
+};
+
+// Dosyadaki konumdan NUL ile biten dize; sınır dışına taşarsa boş
+QString stringAt(const uchar *data, qint64 size, qint64 offset, qint64 limit)
+{
+    if (offset < 0 || offset >= size) {
+        return QString();
+    }
+    const qint64 end = qMin(size, limit);
+    const void *terminator = std::memchr(data + offset, '\0', size_t(end - offset));
+    if (!terminator) {
+        return QString();
+    }
+    return QFile::decodeName(reinterpret_cast<const char *>(data + offset));
+}
+
+// Program başlıklarından yükleme bölümleri, yükleyici ve dinamik bölüm;
+// dinamik bölümdeki dize tablosu adresi PT_LOAD eşlemeleriyle dosya konumuna çevrilir
+template<typename Ehdr, typename Phdr, typename Dyn>
+bool parseElf(const uchar *data, qint64 size, ElfInfo *info)
+{
+    if (size < qint64(sizeof(Ehdr))) {
+        return false;
+    }
+    Ehdr header;
+    std::memcpy(&header, data, sizeof(header));
+    info->machine = header.e_machine;
+
+    if (header.e_phentsize != sizeof(Phdr)
+        || qint64(header.e_phoff) + qint64(header.e_phnum) * qint64(sizeof(Phdr)) > size) {
+        return false;
+    }
+
+    QVector<Phdr> loads;
+    Phdr dynamic = {};
+    bool hasDynamic = false;
+    for (int i = 0; i < header.e_phnum; ++i) {
+        Phdr segment;
+        std::memcpy(&segment, data + header.e_phoff + i * sizeof(Phdr), sizeof(segment));
+        if (segment.p_type == PT_LOAD) {
+            loads.append(segment);
+        } else if (segment.p_type == PT_DYNAMIC) {
+            dynamic = segment;
+            hasDynamic = true;
+        } else if (segment.p_type == PT_INTERP) {
+            info->interpreter = stringAt(data, size, qint64(segment.p_offset),
+                                         qint64(segment.p_offset + segment.p_filesz));
+        }
+    }
+    if (!hasDynamic) {
+        // Statik bağlı program: kütüphane yok
+        return true;
+    }
+
+    auto offsetOf = [&loads](quint64 address) -> qint64 {
+        for (const Phdr &load : loads) {
+            if (address >= load.p_vaddr && address < load.p_vaddr + load.p_filesz) {
+                return qint64(address - load.p_vaddr + load.p_offset);
+            }
+        }
+        return -1;
+    };
+
+    QVector<quint64> needed;
+    quint64 strtab = 0, strsz = 0, rpath = 0, runpath = 0;
+    bool hasRpath = false, hasRunpath = false;
+    const qint64 count = qint64(dynamic.p_filesz / sizeof(Dyn));
+    if (qint64(dynamic.p_offset) + count * qint64(sizeof(Dyn)) > size) {
+        return false;
+    }
+    for (qint64 i = 0; i < count; ++i) {
+        Dyn entry;
+        std::memcpy(&entry, data + dynamic.p_offset + i * sizeof(Dyn), sizeof(entry));
+        if (entry.d_tag == DT_NULL) {
+            break;
+        }
+        switch (entry.d_tag) {
+        case DT_NEEDED: needed.append(entry.d_un.d_val); break;
+        case DT_STRTAB: strtab = entry.d_un.d_ptr; break;
+        case DT_STRSZ: strsz = entry.d_un.d_val; break;
+        case DT_RPATH: rpath = entry.d_un.d_val; hasRpath = true; break;
+        case DT_RUNPATH: runpath = entry.d_un.d_val; hasRunpath = true; break;
+        default: break;
+        }
+    }
+
+    const qint64 table = offsetOf(strtab);
+    if (table < 0) {
+        return false;
+    }
+    const qint64 tableEnd = table + qint64(strsz);
+    auto string = [&](quint64 offset) {
+        return stringAt(data, size, table + qint64(offset), tableEnd);
+    };
+
+    for (quint64 offset : qAsConst(needed)) {
+        const QString name = string(offset);
+        if (!name.isEmpty()) {
+            info->needed.append(name);
+        }
+    }
+    if (hasRpath) {
+        info->rpath = string(rpath).split(':', Qt::SkipEmptyParts);
+    }
+    if (hasRunpath) {
+        info->runpath = string(runpath).split(':', Qt::SkipEmptyParts);
+    }
+    return true;
+}
+
+bool readElf(const QString &path, ElfInfo *info)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly) || file.size() < EI_NIDENT) {
+        return false;
+    }
+    const qint64 size = file.size();
+    const uchar *data = file.map(0, size);
+    if (!data || std::memcmp(data, ELFMAG, SELFMAG) != 0) {
+        return false;
+    }
+
+    // Yalnızca bu makinenin bayt sırasındaki dosyalar okunur
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    const int hostData = ELFDATA2LSB;
+#else
+    const int hostData = ELFDATA2MSB;
+#endif
+    if (data[EI_DATA] != hostData) {
+        return false;
+    }
+
+    info->is64 = data[EI_CLASS] == ELFCLASS64;
+    if (info->is64) {
+        return parseElf<Elf64_Ehdr, Elf64_Phdr, Elf64_Dyn>(data, size, info);
+    }
+    if (data[EI_CLASS] == ELFCLASS32) {
+        return parseElf<Elf32_Ehdr, Elf32_Phdr, Elf32_Dyn>(data, size, info);
+    }
+    return false;
+}
+
+// Aday kütüphane, onu isteyen dosyayla aynı sınıf ve mimaride mi
+// (ör. /usr/lib'deki 32 bitlik kopyalar atlanır)
+bool elfMatches(const QString &path, const ElfInfo &from)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const QByteArray header = file.read(20);
+    if (header.size() < 20 || !header.startsWith(ELFMAG)) {
+        return false;
+    }
+    quint16 machine;
+    std::memcpy(&machine, header.constData() + 18, sizeof(machine));
+    return (uchar(header.at(EI_CLASS)) == ELFCLASS64) == from.is64 && machine == from.machine;
+}
+
+void readLdConfig(const QString &path, QStringList *directories, QSet<QString> *visited)
+{
+    if (visited->contains(path)) {
+        return;
+    }
+    visited->insert(path);
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    for (QByteArray line : file.readAll().split('\n')) {
+        const int comment = line.indexOf('#');
+        if (comment >= 0) {
+            line.truncate(comment);
+        }
+        line = line.trimmed();
+        if (line.isEmpty()) {
+            continue;
+        }
+        if (line.startsWith("include ")) {
+            // "include /etc/ld.so.conf.d/*.conf"; göreli yollar dosyanın dizinine göredir
+            QString glob = QString::fromLocal8Bit(line.mid(8).trimmed());
+            if (QFileInfo(glob).isRelative()) {
+                glob = QFileInfo(path).absolutePath() + '/' + glob;
+            }
+            const QFileInfo pattern(glob);
+            QDir directory(pattern.absolutePath());
+            const QStringList names = directory.entryList(QStringList(pattern.fileName()), QDir::Files, QDir::Name);
+            for (const QString &name : names) {
+                readLdConfig(directory.filePath(name), directories, visited);
+            }
+        } else {
+            directories->append(QString::fromLocal8Bit(line));
+        }
+    }
+}
+
+// ld.so'nun varsayılan arama dizinleri: ld.so.conf ve mimari alt dizinleri
+QStringList systemLibraryDirectories()
+{
+    QStringList directories;
+    QSet<QString> visited;
+    readLdConfig("/etc/ld.so.conf", &directories, &visited);
+    directories << "/lib64" << "/usr/lib64" << "/lib" << "/usr/lib";
+    return directories;
+}
+
+QString multiarchDirectory(quint16 machine)
+{
+    switch (machine) {
+    case EM_X86_64: return "x86_64-linux-gnu";
+    case EM_386: return "i386-linux-gnu";
+    case EM_AARCH64: return "aarch64-linux-gnu";
+    case EM_ARM: return "arm-linux-gnueabihf";
+    default: return QString();
+    }
+}
+
+// Kütüphane, ld.so'nun sırasıyla aranır: RUNPATH yoksa RPATH, LD_LIBRARY_PATH,
+// RUNPATH, sistem dizinleri
+QString resolveLibrary(const QString &name, const ElfInfo &from, const QString &fromPath,
+                       const QStringList &systemDirectories)
+{
+    if (name.contains('/')) {
+        return QFileInfo(name).exists() ? name : QString();
+    }
+
+    QStringList directories;
+    if (from.runpath.isEmpty()) {
+        directories += from.rpath;
+    }
+    directories += QString::fromLocal8Bit(qgetenv("LD_LIBRARY_PATH")).split(':', Qt::SkipEmptyParts);
+    directories += from.runpath;
+    const QString multiarch = multiarchDirectory(from.machine);
+    if (!multiarch.isEmpty()) {
+        directories << "/lib/" + multiarch << "/usr/lib/" + multiarch;
+    }
+    directories += systemDirectories;
+
+    const QString origin = QFileInfo(fromPath).absolutePath();
+    for (QString directory : qAsConst(directories)) {
+        directory.replace("${ORIGIN}", origin).replace("$ORIGIN", origin);
+        const QString candidate = directory + '/' + name;
+        if (QFileInfo(candidate).isFile() && elfMatches(candidate, from)) {
+            return candidate;
+        }
+    }
+    return QString();
+}
+
+// Komutun gerçek dosyası; betiklerde "#!" yorumlayıcısı da eklenir
+QStringList programFiles(const QString &command)
+{
+    const QStringList arguments = AppLauncher::splitExec(AppCatalog::plainCommand(command));
+    if (arguments.isEmpty()) {
+        return QStringList();
+    }
+
+    // Ortam değişkeni atayan "env" sarmalayıcıları atlanır
+    int first = 0;
+    if (QFileInfo(arguments.first()).fileName() == "env") {
+        first = 1;
+        while (first < arguments.size() && arguments.at(first).contains('=')) {
+            ++first;
+        }
+    }
+    if (first >= arguments.size()) {
+        return QStringList();
+    }
+
+    const QString program = QStandardPaths::findExecutable(arguments.at(first));
+    if (program.isEmpty()) {
+        return QStringList();
+    }
+
+    QStringList files(QFileInfo(program).canonicalFilePath());
+    QFile file(files.first());
+    if (file.open(QIODevice::ReadOnly)) {
+        const QByteArray line = file.readLine(256);
+        if (line.startsWith("#!")) {
+            const QList<QByteArray> shebang = line.mid(2).trimmed().split(' ');
+            if (!shebang.isEmpty() && !shebang.first().isEmpty()) {
+                files.append(QFileInfo(QFile::decodeName(shebang.first())).canonicalFilePath());
+            }
+        }
+    }
+    files.removeAll(QString());
+    return files;
+}
+
+// Önce bellekteki sayfalar sayılır, sonra dosya okunmaya verilir. Okunacak
+// veri kalan bütçeyi aşarsa dosyanın yalnızca bütçeye sığan başı verilir.
+bool prefetchFile(const QString &path, qint64 budget, AppPrefetcher::FileReport *report, qint64 *bytes)
+{
+    const int fd = ::open(QFile::encodeName(path).constData(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat status;
+    if (fstat(fd, &status) != 0 || status.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+
+    const qint64 pageSize = sysconf(_SC_PAGESIZE);
+    const qint64 size = status.st_size;
+    report->path = path;
+    report->pages = (size + pageSize - 1) / pageSize;
+
+    // Eşleme sayfa okumaz; mincore yalnızca sayfa önbelleğine bakar.
+    // Bakılamazsa bütün sayfalar okunacak sayılır.
+    std::vector<unsigned char> residency(size_t(report->pages), 0);
+    void *mapping = mmap(nullptr, size_t(size), PROT_READ, MAP_SHARED, fd, 0);
+    if (mapping != MAP_FAILED) {
+        if (mincore(mapping, size_t(size), residency.data()) != 0) {
+            std::fill(residency.begin(), residency.end(), 0);
+        }
+        munmap(mapping, size_t(size));
+    }
+
+    // Bütçeyi aşacak ilk okunmamış sayfada kesilir
+    qint64 length = size;
+    qint64 missing = 0;
+    for (qint64 page = 0; page < report->pages; ++page) {
+        if (residency[size_t(page)] & 1) {
+            ++report->residentPages;
+        } else if (length == size) {
+            if (missing + pageSize > budget) {
+                length = page * pageSize;
+            } else {
+                missing += pageSize;
+            }
+        }
+    }
+
+    // Uzunluk 0 fadvise'ta "dosyanın sonuna dek" anlamına gelir
+    if (length > 0) {
+        posix_fadvise(fd, 0, length, POSIX_FADV_WILLNEED);
+    }
+    ::close(fd);
+
+    // Kesildiyse bütçe bu dosyada tükenmiştir; tur burada biter
+    *bytes += length < size ? budget : missing;
+    return true;
+}
+
+// Çalışan iş parçacığında: programlar ve kütüphane kapanışları genişlik öncelikli gezilir
+QVector<AppPrefetcher::FileReport> prefetchCommands(const QStringList &commands)
+{
+    // Bu iş parçacığının okumaları yalnızca disk boşken yapılır
+#ifdef SYS_ioprio_set
+    syscall(SYS_ioprio_set, IoprioWhoProcess, 0, IoprioClassIdle << IoprioClassShift);
+#endif
+    QThread::currentThread()->setPriority(QThread::IdlePriority);
+
+    const QStringList systemDirectories = systemLibraryDirectories();
+    QVector<AppPrefetcher::FileReport> reports;
+    QSet<QString> visited;
+    QQueue<QString> queue;
+    qint64 bytes = 0;
+
+    for (const QString &command : commands) {
+        for (const QString &file : programFiles(command)) {
+            if (!visited.contains(file)) {
+                visited.insert(file);
+                queue.enqueue(file);
+            }
+        }
+    }
+
+    while (!queue.isEmpty() && bytes < MaxPrefetchBytes) {
+        const QString path = queue.dequeue();
+        AppPrefetcher::FileReport report;
+        if (!prefetchFile(path, MaxPrefetchBytes - bytes, &report, &bytes)) {
+            continue;
+        }
+        reports.append(report);
+
+        // Dosya artık önbelleğe alınıyor; başlık okumaları diski beklemez
+        ElfInfo info;
+        if (!readElf(path, &info)) {
+            continue;
+        }
+        QStringList dependencies = info.needed;
+        if (!info.interpreter.isEmpty()) {
+            dependencies.prepend(info.interpreter);
+        }
+        for (const QString &name : qAsConst(dependencies)) {
+            const QString library = QFileInfo(resolveLibrary(name, info, path, systemDirectories)).canonicalFilePath();
+            if (!library.isEmpty() && !visited.contains(library)) {
+                visited.insert(library);
+                queue.enqueue(library);
+            }
+        }
+    }
+    return reports;
+}
+
+} // namespace
+
+AppPrefetcher::AppPrefetcher(QObject *parent)
+    : QObject(parent)
+    , m_idleTimer(new QTimer(this))
+    , m_worker(new QThreadPool(this))
+{
+    // Tek çalışan: iş parçacığının G/Ç önceliği kalıcı olarak düşüktür
+    m_worker->setMaxThreadCount(1);
+    m_worker->setExpiryTimeout(-1);
+
+    m_idleTimer->setSingleShot(true);
+    m_idleTimer->setInterval(IdleDelay);
+    connect(m_idleTimer, &QTimer::timeout, this, &AppPrefetcher::start);
+}
+
+AppPrefetcher::~AppPrefetcher()
+{
+    m_worker->clear();
+    m_worker->waitForDone();
+}
+
+void AppPrefetcher::prefetch(const QStringList &commands)
+{
+    for (const QString &command : commands) {
+        if (!command.isEmpty() && !m_done.contains(command)) {
+            m_done.insert(command);
+            m_pending.append(command);
+        }
+    }
+
+    // Her yeni istek bekleme süresini baştan başlatır (açılış sırasında ertelenir)
+    if (!m_pending.isEmpty()) {
+        m_idleTimer->start();
+    }
+}
+
+void AppPrefetcher::start()
+{
+    const QStringList commands = m_pending;
+    m_pending.clear();
+
+    AppPrefetcher *prefetcher = this;
+    m_worker->start([prefetcher, commands]() {
+        const QVector<FileReport> files = prefetchCommands(commands);
+        QMetaObject::invokeMethod(prefetcher, [prefetcher, files]() {
+            prefetcher->report(files);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void AppPrefetcher::report(const QVector<FileReport> &files)
+{
+    qint64 pages = 0;
+    qint64 residentPages = 0;
+    for (const FileReport &file : files) {
+        pages += file.pages;
+        residentPages += file.residentPages;
+    }
+
+    qInfo() << "Önbellek ısıtma:" << files.size() << "dosya," << residentPages << "/" << pages
+            << "sayfa zaten bellekteydi";
+    emit prefetched(files.size(), pages, residentPages);
+}
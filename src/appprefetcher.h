@@ -0,0 +1,53 @@
+#ifndef APPPREFETCHER_H
+#define APPPREFETCHER_H
+
+#include <QObject>
+#include <QSet>
+#include <QStringList>
+#include <QVector>
+
+class QThreadPool;
+class QTimer;
+
+// Favori uygulamaların ilk tıklamada diski beklememesi için sayfa
+// önbelleğini önceden ısıtır. Kabuk bir süre boşta kaldıktan sonra her
+// komutun programı PATH'te bulunur; ELF dinamik bölümündeki DT_NEEDED
+// kayıtları ve yükleyici (PT_INTERP) izlenerek paylaşılan kütüphaneleri
+// de toplanır. Dosyalar düşük öncelikli bir iş parçacığında, boşta G/Ç
+// sınıfıyla posix_fadvise(WILLNEED) ile okunmaya verilir. Her dosyanın
+// okunmadan önce bellekte olan sayfaları mincore ile sayılır ve raporlanır.
+class AppPrefetcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit AppPrefetcher(QObject *parent = nullptr);
+    ~AppPrefetcher();
+
+    // Exec biçiminde komutlar; daha önce ısıtılanlar atlanır. Son istekten
+    // sonra kabuk boşta kalınca çalışır.
+    void prefetch(const QStringList &commands);
+
+    struct FileReport {
+        QString path;
+        qint64 pages = 0;
+        qint64 residentPages = 0;  // fadvise'tan önce zaten önbellekte olanlar
+    };
+
+signals:
+    // Bir ısıtma turu bitti; sayfa toplamları dosya raporlarının toplamıdır
+    void prefetched(int files, qint64 pages, qint64 residentPages);
+
+private slots:
+    void start();
+
+private:
+    void report(const QVector<FileReport> &files);
+
+    QStringList m_pending;
+    QSet<QString> m_done;   // Isıtılmış ya da kuyruktaki komutlar
+    QTimer *m_idleTimer;
+    QThreadPool *m_worker;
+};
+
+#endif // APPPREFETCHER_H
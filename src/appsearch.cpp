@@ -0,0 +1,327 @@
+#include "appsearch.h"
+#include "appcatalog.h"
+#include <QFileInfo>
+#include <QProcess>
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// Arama metnindeki alan ayırıcısı: ad, genel ad, anahtar sözcükler, program
+const char FieldSeparator = '\x01';
+
+// Okumalar 16 baytlık bloklarla yapılır; tamponun sonu bu kadar doldurulur
+const int Padding = 16;
+
+bool isSeparator(char c)
+{
+    switch (c) {
+    case FieldSeparator:
+    case ' ':
+    case '-':
+    case '_':
+    case '.':
+    case '/':
+    case ';':
+    case ',':
+    case '(':
+    case ')':
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Aranabilir biçim: Unicode basit katlama İ ve ı'yı olduğu gibi bırakır.
+// Türkçe klavyede "I" küçük harfle "ı" olduğundan İ, I, ı ve i aynı harf sayılır.
+QByteArray fold(const QString &text)
+{
+    QString folded = text.toCaseFolded();
+    folded.replace(QChar(0x0130), QLatin1Char('i'));
+    folded.replace(QChar(0x0131), QLatin1Char('i'));
+    return folded.toUtf8();
+}
+
+// text[0, length) içinde c'nin ilk konumu; yoksa -1. Tamponun en az 15
+// bayt ötesi okunabilir olmalı (m_text dolgusu)
+int findByte(const char *text, int length, char c)
+{
+#if defined(__SSE2__)
+    const __m128i needle = _mm_set1_epi8(c);
+    for (int i = 0; i < length; i += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i));
+        int bits = _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+        if (length - i < 16) {
+            bits &= (1 << (length - i)) - 1;
+        }
+        if (bits) {
+            return i + __builtin_ctz(bits);
+        }
+    }
+    return -1;
+#else
+    const void *found = std::memchr(text, c, size_t(length));
+    return found ? int(static_cast<const char *>(found) - text) : -1;
+#endif
+}
+
+int findSubstring(const char *text, int length, const QByteArray &query)
+{
+    const int last = length - query.size();
+    for (int from = 0; from <= last; ) {
+        const int index = findByte(text + from, last - from + 1, query.at(0));
+        if (index < 0) {
+            return -1;
+        }
+        const int position = from + index;
+        if (std::memcmp(text + position + 1, query.constData() + 1, size_t(query.size() - 1)) == 0) {
+            return position;
+        }
+        from = position + 1;
+    }
+    return -1;
+}
+
+int fieldAt(const char *text, int position)
+{
+    int field = 0;
+    for (int i = 0; i < position; ++i) {
+        field += text[i] == FieldSeparator;
+    }
+    return field;
+}
+
+// Çalıştırılan programın adı (ör. "/usr/bin/gnome-terminal --x" -> "gnome-terminal")
+QString programName(const QString &exec)
+{
+    const QStringList arguments = QProcess::splitCommand(AppCatalog::plainCommand(exec));
+    return arguments.isEmpty() ? QString() : QFileInfo(arguments.first()).fileName();
+}
+
+} // namespace
+
+AppSearch::AppSearch(QObject *parent)
+    : QObject(parent)
+    , m_dirty(true)
+{
+    connect(AppCatalog::instance(), &AppCatalog::catalogChanged, this, [this]() {
+        m_dirty = true;
+        m_steps.clear();
+    });
+}
+
+void AppSearch::reset()
+{
+    m_steps.clear();
+}
+
+quint64 AppSearch::signature(const char *text, int length)
+{
+    // Harf ve rakamlar ayrı bitlerde; diğer baytlar kalan bitlere katlanır
+    quint64 bits = 0;
+    for (int i = 0; i < length; ++i) {
+        const uchar c = uchar(text[i]);
+        int bit;
+        if (c >= 'a' && c <= 'z') {
+            bit = c - 'a';
+        } else if (c >= '0' && c <= '9') {
+            bit = 26 + (c - '0');
+        } else {
+            bit = 36 + c % 28;
+        }
+        bits |= quint64(1) << bit;
+    }
+    return bits;
+}
+
+void AppSearch::buildIndex()
+{
+    AppCatalog *catalog = AppCatalog::instance();
+    const int count = catalog->count();
+
+    m_text.clear();
+    m_offsets.resize(count + 1);
+    m_signatures.resize(count);
+    m_words.clear();
+
+    for (int i = 0; i < count; ++i) {
+        const AppEntry entry = catalog->entry(i);
+        QString keywords = entry.keywords;
+        keywords.replace(';', ' ');
+
+        const QByteArray text = fold(entry.name + FieldSeparator + entry.genericName + FieldSeparator
+                                     + keywords + FieldSeparator + programName(entry.exec));
+        const quint32 offset = quint32(m_text.size());
+        m_offsets[i] = offset;
+        m_text.append(text);
+        m_signatures[i] = signature(text.constData(), text.size());
+
+        for (int start = 0; start < text.size(); ) {
+            if (isSeparator(text.at(start))) {
+                ++start;
+                continue;
+            }
+            int end = start;
+            while (end < text.size() && !isSeparator(text.at(end))) {
+                ++end;
+            }
+            m_words.append({ offset + quint32(start), quint32(end - start), i });
+            start = end;
+        }
+    }
+    m_offsets[count] = quint32(m_text.size());
+    m_text.append(QByteArray(Padding, '\0'));
+
+    const char *base = m_text.constData();
+    std::sort(m_words.begin(), m_words.end(), [base](const Word &a, const Word &b) {
+        const int order = std::memcmp(base + a.offset, base + b.offset, qMin(a.length, b.length));
+        return order != 0 ? order < 0 : a.length < b.length;
+    });
+
+    m_dirty = false;
+}
+
+QVector<int> AppSearch::search(const QString &query)
+{
+    if (m_dirty) {
+        buildIndex();
+    }
+
+    const QByteArray folded = fold(query.trimmed());
+    if (folded.isEmpty()) {
+        m_steps.clear();
+        return QVector<int>();
+    }
+
+    // Silinen karakterler: o uzunluktaki sonuç yığında zaten var
+    while (!m_steps.isEmpty() && !folded.startsWith(m_steps.last().query)) {
+        m_steps.removeLast();
+    }
+
+    QVector<Match> matches;
+    if (!m_steps.isEmpty() && m_steps.last().query == folded) {
+        matches = m_steps.last().matches;
+    } else {
+        if (folded.size() < 3) {
+            // Tek iki harf için bulanık eşleşme neredeyse her şeyi tutar
+            matches = prefixMatches(folded);
+        } else if (!m_steps.isEmpty() && m_steps.last().query.size() >= 3) {
+            // Uzantıyla eşleşen her metin önceki sorguyla da eşleşir
+            matches = fuzzyMatches(folded, &m_steps.last().matches);
+        } else {
+            matches = fuzzyMatches(folded, nullptr);
+        }
+
+        std::sort(matches.begin(), matches.end(), [](const Match &a, const Match &b) {
+            return a.score != b.score ? a.score > b.score : a.entry < b.entry;
+        });
+        m_steps.append({ folded, matches });
+    }
+
+    QVector<int> entries;
+    entries.reserve(matches.size());
+    for (const Match &match : qAsConst(matches)) {
+        entries.append(match.entry);
+    }
+    return entries;
+}
+
+QVector<AppSearch::Match> AppSearch::prefixMatches(const QByteArray &query) const
+{
+    const char *base = m_text.constData();
+    const quint32 length = quint32(query.size());
+
+    // Sorguyla başlayan ilk sözcük ikili aramayla bulunur
+    auto first = std::lower_bound(m_words.constBegin(), m_words.constEnd(), query,
+                                  [base, length](const Word &word, const QByteArray &key) {
+        const int order = std::memcmp(base + word.offset, key.constData(), qMin(word.length, length));
+        return order != 0 ? order < 0 : word.length < length;
+    });
+
+    QVector<Match> matches;
+    QVector<bool> seen(m_signatures.size(), false);
+    for (auto it = first; it != m_words.constEnd(); ++it) {
+        if (it->length < length || std::memcmp(base + it->offset, query.constData(), length) != 0) {
+            break;
+        }
+        if (!seen.at(it->entry)) {
+            seen[it->entry] = true;
+            matches.append({ it->entry, score(it->entry, query) });
+        }
+    }
+    return matches;
+}
+
+QVector<AppSearch::Match> AppSearch::fuzzyMatches(const QByteArray &query, const QVector<Match> *candidates) const
+{
+    QVector<Match> matches;
+
+    if (candidates) {
+        for (const Match &candidate : *candidates) {
+            const int value = score(candidate.entry, query);
+            if (value > 0) {
+                matches.append({ candidate.entry, value });
+            }
+        }
+        return matches;
+    }
+
+    // Sorgudaki her karakteri içermeyen girdiler metne bakmadan elenir
+    const quint64 required = signature(query.constData(), query.size());
+    const quint64 *signatures = m_signatures.constData();
+    for (int i = 0; i < m_signatures.size(); ++i) {
+        if ((signatures[i] & required) != required) {
+            continue;
+        }
+        const int value = score(i, query);
+        if (value > 0) {
+            matches.append({ i, value });
+        }
+    }
+    return matches;
+}
+
+int AppSearch::score(int entry, const QByteArray &query) const
+{
+    const char *text = m_text.constData() + m_offsets.at(entry);
+    const int length = int(m_offsets.at(entry + 1) - m_offsets.at(entry));
+
+    // Bitişik eşleşme: alan ve konum öne çıkarır; ada göre tam eşleşme en üstte
+    const int position = findSubstring(text, length, query);
+    if (position >= 0) {
+        const bool wordStart = position == 0 || isSeparator(text[position - 1]);
+        const bool wholeName = position == 0
+                               && (query.size() == length || text[query.size()] == FieldSeparator);
+        return 10000 - fieldAt(text, position) * 1000 + (wholeName ? 1000 : 0)
+               + (position == 0 ? 500 : 0) + (wordStart ? 500 : 0) - qMin(position, 200);
+    }
+
+    // Alt dizi eşleşmesi: sözcük başları ve ardışık harfler ödüllendirilir, boşluklar cezalandırılır
+    int value = 0;
+    int first = -1;
+    int previous = -1;
+    int from = 0;
+    for (int i = 0; i < query.size(); ++i) {
+        const int index = findByte(text + from, length - from, query.at(i));
+        if (index < 0) {
+            return 0;
+        }
+        const int position = from + index;
+        if (first < 0) {
+            first = position;
+        }
+        if (position == 0 || isSeparator(text[position - 1])) {
+            value += 40;
+        }
+        if (previous >= 0) {
+            value += position == previous + 1 ? 30 : -qMin(position - previous - 1, 20);
+        }
+        previous = position;
+        from = position + 1;
+    }
+    return qMax(1, 2000 + value - fieldAt(text, first) * 300);
+}
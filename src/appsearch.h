@@ -0,0 +1,64 @@
+#ifndef APPSEARCH_H
+#define APPSEARCH_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QVector>
+
+// Başlat menüsündeki "Ara" için uygulama katalogu üzerinde artımlı bulanık
+// arama. Her uygulama için ad, genel ad, anahtar sözcükler ve çalıştırılan
+// program küçük harfe katlanıp tek bir bitişik tamponda tutulur.
+//  - 1-2 karakterlik sorgular sıralı sözcük başı (önek) dizininden ikili
+//    aramayla yanıtlanır.
+//  - Daha uzun sorgularda adaylar her girdinin karakter imzasıyla (64 bit)
+//    elenir, kalanlar SSE2 ile bayt arayan eşleyiciyle puanlanır.
+//  - Sorgu bir önceki sorgunun uzantısıysa yalnızca önceki eşleşmeler
+//    yeniden puanlanır; silmede önceki adımların sonuçları yığından döner.
+// Dizin katalog değiştiğinde ilk aramada yeniden kurulur.
+class AppSearch : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit AppSearch(QObject *parent = nullptr);
+
+    // Eşleşen uygulamaların katalog sıra numaraları (AppCatalog::entry(int)), en iyisi önce
+    QVector<int> search(const QString &query);
+
+    // Yeni arama oturumu: önceki sonuçlar unutulur
+    void reset();
+
+private:
+    struct Match {
+        int entry;
+        int score;
+    };
+
+    // Sözcük başı dizini kaydı; m_text içindeki konumu gösterir
+    struct Word {
+        quint32 offset;
+        quint32 length;
+        int entry;
+    };
+
+    struct Step {
+        QByteArray query;
+        QVector<Match> matches;
+    };
+
+    void buildIndex();
+    QVector<Match> prefixMatches(const QByteArray &query) const;
+    QVector<Match> fuzzyMatches(const QByteArray &query, const QVector<Match> *candidates) const;
+    int score(int entry, const QByteArray &query) const;
+    static quint64 signature(const char *text, int length);
+
+    QByteArray m_text;           // Girdilerin arama metinleri art arda; sonunda 16 bayt dolgu
+    QVector<quint32> m_offsets;  // Girdi i: [m_offsets[i], m_offsets[i + 1])
+    QVector<quint64> m_signatures;
+    QVector<Word> m_words;       // Sözcük metnine göre sıralı
+    bool m_dirty;
+
+    QVector<Step> m_steps;       // Bu oturumda yazılan sorguların sonuçları
+};
+
+#endif // APPSEARCH_H
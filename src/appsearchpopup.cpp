@@ -0,0 +1,133 @@
+#include "appsearchpopup.h"
+#include "appsearch.h"
+#include "appcatalog.h"
+#include "applauncher.h"
+#include "blurservice.h"
+#include "iconcache.h"
+#include <QCoreApplication>
+#include <QKeyEvent>
+#include <QLineEdit>
+#include <QListWidget>
+#include <QVBoxLayout>
+
+namespace {
+
+// Listede gösterilen en fazla sonuç
+const int MaxResults = 12;
+
+} // namespace
+
+AppSearchPopup::AppSearchPopup(QWidget *parent)
+    : QWidget(parent, Qt::Popup | Qt::FramelessWindowHint)
+    , m_search(new AppSearch(this))
+{
+    setAttribute(Qt::WA_TranslucentBackground);
+    BlurService::instance()->installBackdrop(this, 10);
+    setFixedWidth(360);
+    setStyleSheet(
+        "QLineEdit { background-color: rgba(10, 15, 35, 0.8); color: #e0e5ff; border: 1px solid rgba(120, 80, 255, 0.5);"
+        " border-radius: 6px; padding: 6px; }"
+        "QListWidget { background: transparent; color: #e0e5ff; border: none; }"
+        "QListWidget::item { padding: 4px; }"
+        "QListWidget::item:selected { background-color: rgba(120, 80, 255, 0.3); border-radius: 5px; }"
+    );
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setContentsMargins(8, 8, 8, 8);
+    layout->setSpacing(6);
+
+    m_input = new QLineEdit(this);
+    m_input->setPlaceholderText("Uygulama ara...");
+    m_input->installEventFilter(this);
+    layout->addWidget(m_input);
+
+    m_results = new QListWidget(this);
+    m_results->setIconSize(QSize(24, 24));
+    m_results->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    m_results->setFixedHeight(MaxResults * 32);
+    layout->addWidget(m_results);
+
+    connect(m_input, &QLineEdit::textChanged, this, &AppSearchPopup::updateResults);
+    connect(m_input, &QLineEdit::returnPressed, this, &AppSearchPopup::launchCurrent);
+    connect(m_results, &QListWidget::itemActivated, this, &AppSearchPopup::launchCurrent);
+
+    // Katalog yenilenince sıra numaraları başka uygulamaları gösterir; liste
+    // yeniden kurulur (AppSearch önce bağlandığından dizini zaten geçersizdir)
+    connect(AppCatalog::instance(), &AppCatalog::catalogChanged, this, [this]() {
+        if (isVisible()) {
+            updateResults(m_input->text());
+        } else {
+            m_entries.clear();
+            m_results->clear();
+        }
+    });
+}
+
+void AppSearchPopup::popup(const QPoint &position, const QString &text)
+{
+    // Metin değişmese de sonuçlar tazelenmeli; textChanged bastırılıp bir kez güncellenir
+    m_search->reset();
+    {
+        const QSignalBlocker blocker(m_input);
+        m_input->setText(text);
+    }
+    updateResults(text);
+
+    adjustSize();
+    move(position);
+    show();
+    m_input->setFocus();
+}
+
+bool AppSearchPopup::eventFilter(QObject *watched, QEvent *event)
+{
+    // Odak giriş kutusunda kalırken ok tuşları listede gezinir
+    if (watched == m_input && event->type() == QEvent::KeyPress) {
+        const int key = static_cast<QKeyEvent *>(event)->key();
+        if (key == Qt::Key_Up || key == Qt::Key_Down || key == Qt::Key_PageUp || key == Qt::Key_PageDown) {
+            QCoreApplication::sendEvent(m_results, event);
+            return true;
+        }
+    }
+    return QWidget::eventFilter(watched, event);
+}
+
+void AppSearchPopup::updateResults(const QString &text)
+{
+    m_entries = m_search->search(text);
+    if (m_entries.size() > MaxResults) {
+        m_entries.resize(MaxResults);
+    }
+
+    // Satırlar yeniden kullanılır; her tuşta öğe oluşturulup silinmez
+    AppCatalog *catalog = AppCatalog::instance();
+    for (int row = 0; row < MaxResults; ++row) {
+        QListWidgetItem *item = m_results->item(row);
+        if (row >= m_entries.size()) {
+            if (item) {
+                item->setHidden(true);
+            }
+            continue;
+        }
+        if (!item) {
+            item = new QListWidgetItem(m_results);
+        }
+        const int entry = m_entries.at(row);
+        item->setText(catalog->name(entry));
+        item->setIcon(IconCache::instance()->icon(catalog->iconName(entry)));
+        item->setHidden(false);
+    }
+
+    m_results->setCurrentRow(m_entries.isEmpty() ? -1 : 0);
+}
+
+void AppSearchPopup::launchCurrent()
+{
+    const int row = m_results->currentRow();
+    if (row < 0 || row >= m_entries.size()) {
+        return;
+    }
+
+    AppLauncher::instance()->launch(AppCatalog::instance()->entry(m_entries.at(row)));
+    hide();
+}
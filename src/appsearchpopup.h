@@ -0,0 +1,38 @@
+#ifndef APPSEARCHPOPUP_H
+#define APPSEARCHPOPUP_H
+
+#include <QWidget>
+#include <QVector>
+
+class QLineEdit;
+class QListWidget;
+class AppSearch;
+
+// Başlat menüsünden açılan "yazdıkça ara" penceresi. Her tuş vuruşunda
+// AppSearch'ten sonuç alınır ve yalnızca ilk sonuçlar listelenir; Enter
+// seçili uygulamayı başlatır.
+class AppSearchPopup : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit AppSearchPopup(QWidget *parent = nullptr);
+
+    // Verilen sorguyla (ör. menüde yazılmaya başlanan harf) noktaya hizalı açılır
+    void popup(const QPoint &position, const QString &text = QString());
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private slots:
+    void updateResults(const QString &text);
+    void launchCurrent();
+
+private:
+    QLineEdit *m_input;
+    QListWidget *m_results;
+    AppSearch *m_search;
+    QVector<int> m_entries;  // Listelenen satırların katalog sıra numaraları
+};
+
+#endif // APPSEARCHPOPUP_H
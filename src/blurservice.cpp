@@ -0,0 +1,298 @@
+#include "blurservice.h"
+#include <QCoreApplication>
+#include <QGuiApplication>
+#include <QScreen>
+#include <QPainter>
+#include <QPainterPath>
+#include <QWidget>
+#include <QEvent>
+#include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QMetaObject>
+#include <QVector>
+#include <functional>
+
+namespace {
+
+// Bulanıklık küçültülmüş görüntüde hesaplanır; sonuç zaten yumuşak olduğundan
+// kalite kaybı görünmez, maliyet ise yaklaşık Downscale² kat düşer
+const int Downscale = 4;
+
+class ChunkJob : public QRunnable
+{
+public:
+    ChunkJob(const std::function<void()> &fn, QSemaphore *done)
+        : m_fn(fn), m_done(done)
+    {
+    }
+
+    void run() override
+    {
+        m_fn();
+        if (m_done) {
+            m_done->release();
+        }
+    }
+
+private:
+    std::function<void()> m_fn;
+    QSemaphore *m_done;
+};
+
+// [0, count) aralığını iş parçacıklarına böler; son parçayı çağıran iş parçacığı işler
+void parallelFor(int count, const std::function<void(int, int)> &fn)
+{
+    const int threads = qBound(1, QThread::idealThreadCount(), 8);
+    const int chunk = (count + threads - 1) / threads;
+
+    QSemaphore done;
+    int started = 0;
+    for (int begin = chunk; begin < count; begin += chunk) {
+        const int end = qMin(count, begin + chunk);
+        QThreadPool::globalInstance()->start(new ChunkJob([fn, begin, end]() { fn(begin, end); }, &done));
+        ++started;
+    }
+
+    fn(0, qMin(count, chunk));
+    done.acquire(started);
+}
+
+// Tek boyutlu kutu ortalaması; kenarlarda son piksel tekrarlanır
+void boxPass(const quint32 *src, quint32 *dst, int count, int radius)
+{
+    const quint32 window = radius * 2 + 1;
+    const quint32 inverse = (1u << 16) / window;
+    // Kesme yerine yuvarlama: aksi halde her geçiş bir birim karartır. Çarpan
+    // aşağı kesildiğinden sonuç 255'i aşmaz, komşu kanala taşmaz
+    const quint32 half = 1u << 15;
+    quint32 a = 0, r = 0, g = 0, b = 0;
+
+    for (int i = -radius; i <= radius; ++i) {
+        const quint32 p = src[qBound(0, i, count - 1)];
+        a += p >> 24; r += (p >> 16) & 0xff; g += (p >> 8) & 0xff; b += p & 0xff;
+    }
+
+    for (int i = 0; i < count; ++i) {
+        dst[i] = (((a * inverse + half) >> 16) << 24) | (((r * inverse + half) >> 16) << 16)
+                 | (((g * inverse + half) >> 16) << 8) | ((b * inverse + half) >> 16);
+
+        const quint32 add = src[qMin(i + radius + 1, count - 1)];
+        const quint32 sub = src[qMax(i - radius, 0)];
+        a += (add >> 24) - (sub >> 24);
+        r += ((add >> 16) & 0xff) - ((sub >> 16) & 0xff);
+        g += ((add >> 8) & 0xff) - ((sub >> 8) & 0xff);
+        b += (add & 0xff) - (sub & 0xff);
+    }
+}
+
+// Bir satır ya da sütunu ardışık tampona alıp üç geçiş uygular (Gauss yaklaşımı)
+void blurLine(quint32 *data, int count, int stride, int radius, quint32 *first, quint32 *second)
+{
+    for (int i = 0; i < count; ++i) {
+        first[i] = data[i * stride];
+    }
+
+    boxPass(first, second, count, radius);
+    boxPass(second, first, count, radius);
+    boxPass(first, second, count, radius);
+
+    for (int i = 0; i < count; ++i) {
+        data[i * stride] = second[i];
+    }
+}
+
+QRect desktopRectOf(const QWidget *widget)
+{
+    const QPoint origin = QGuiApplication::primaryScreen()->virtualGeometry().topLeft();
+    return QRect(widget->mapToGlobal(QPoint(0, 0)) - origin, widget->size());
+}
+
+} // namespace
+
+BlurService *BlurService::instance()
+{
+    static BlurService *service = new BlurService(QCoreApplication::instance());
+    return service;
+}
+
+BlurService::BlurService(QObject *parent)
+    : QObject(parent)
+    , m_pool(new QThreadPool(this))
+    , m_radius(15)
+    , m_generation(0)
+{
+    // Koordinatör iş ayrı havuzda çalışır; parçaları genel havuza dağıtır
+    m_pool->setMaxThreadCount(1);
+}
+
+BlurService::~BlurService()
+{
+    m_pool->clear();
+    m_pool->waitForDone();
+}
+
+void BlurService::setRadius(int radius)
+{
+    if (m_radius == radius) {
+        return;
+    }
+
+    m_radius = radius;
+    for (auto it = m_surfaces.begin(); it != m_surfaces.end(); ++it) {
+        scheduleBlur(it.key());
+    }
+}
+
+void BlurService::setSurface(int id, const QRect &geometry, const QImage &image)
+{
+    Surface &surface = m_surfaces[id];
+    const bool moved = surface.geometry != geometry;
+    surface.geometry = geometry;
+    surface.source = image;
+    if (moved) {
+        surface.blurred = QImage();
+    }
+
+    scheduleBlur(id);
+}
+
+void BlurService::removeSurface(int id)
+{
+    auto it = m_surfaces.find(id);
+    if (it != m_surfaces.end()) {
+        const QRect geometry = it->geometry;
+        m_surfaces.erase(it);
+        emit backdropChanged(geometry);
+    }
+}
+
+void BlurService::scheduleBlur(int id)
+{
+    Surface &surface = m_surfaces[id];
+    surface.generation = ++m_generation;
+
+    const QImage source = surface.source;
+    const QSize size = surface.geometry.size();
+    const int radius = m_radius;
+    const int generation = surface.generation;
+
+    if (source.isNull() || size.isEmpty()) {
+        surface.blurred = QImage();
+        emit backdropChanged(surface.geometry);
+        return;
+    }
+
+    BlurService *service = this;
+    QThreadPool *pool = m_pool;
+    pool->start(new ChunkJob([service, id, generation, source, size, radius]() {
+        const QSize smallSize = (source.size() / Downscale).expandedTo(QSize(1, 1));
+        QImage small = source.scaled(smallSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation)
+                           .convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        BlurService::blur(small, qMax(1, radius / Downscale));
+
+        // Boyama sırasında ölçekleme olmasın diye mantıksal boyuta büyütülür
+        QImage blurred = small.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+
+        QMetaObject::invokeMethod(service, [service, id, generation, blurred]() {
+            auto it = service->m_surfaces.find(id);
+            if (it == service->m_surfaces.end() || it->generation != generation) {
+                return;
+            }
+            it->blurred = blurred;
+            emit service->backdropChanged(it->geometry);
+        }, Qt::QueuedConnection);
+    }, nullptr));
+}
+
+bool BlurService::hasBackdrop(const QRect &desktopRect) const
+{
+    for (const Surface &surface : m_surfaces) {
+        if (surface.geometry.intersects(desktopRect) && !surface.blurred.isNull()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void BlurService::paint(QPainter *painter, const QRect &target, const QRect &desktopRect) const
+{
+    const QPoint offset = target.topLeft() - desktopRect.topLeft();
+
+    for (const Surface &surface : m_surfaces) {
+        const QRect area = surface.geometry.intersected(desktopRect);
+        if (area.isEmpty() || surface.blurred.isNull()) {
+            continue;
+        }
+
+        // Ölçeksiz kopyalama: kaynak ve hedef aynı boyutta
+        painter->drawImage(area.translated(offset), surface.blurred,
+                           area.translated(-surface.geometry.topLeft()));
+    }
+}
+
+void BlurService::installBackdrop(QWidget *widget, int cornerRadius)
+{
+    if (m_backdropWidgets.contains(widget)) {
+        m_backdropWidgets[widget] = cornerRadius;
+        return;
+    }
+
+    m_backdropWidgets.insert(widget, cornerRadius);
+    widget->installEventFilter(this);
+    connect(widget, &QObject::destroyed, this, [this, widget]() {
+        m_backdropWidgets.remove(widget);
+    });
+}
+
+bool BlurService::eventFilter(QObject *watched, QEvent *event)
+{
+    if (event->type() == QEvent::Paint) {
+        QWidget *widget = static_cast<QWidget *>(watched);
+        const int cornerRadius = m_backdropWidgets.value(widget);
+
+        // Widget kendi içeriğini bunun üzerine çizer
+        QPainter painter(widget);
+        if (cornerRadius > 0) {
+            QPainterPath path;
+            path.addRoundedRect(widget->rect(), cornerRadius, cornerRadius);
+            painter.setClipPath(path);
+        }
+        paint(&painter, widget->rect(), desktopRectOf(widget));
+    }
+
+    return QObject::eventFilter(watched, event);
+}
+
+void BlurService::blur(QImage &image, int radius)
+{
+    if (image.isNull() || radius <= 0) {
+        return;
+    }
+
+    if (image.format() != QImage::Format_ARGB32_Premultiplied && image.format() != QImage::Format_RGB32) {
+        image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    }
+
+    const int width = image.width();
+    const int height = image.height();
+    const int stride = image.bytesPerLine() / 4;
+    quint32 *pixels = reinterpret_cast<quint32 *>(image.bits());
+
+    // Yatay geçiş: her iş parçacığı kendi satır aralığını işler
+    parallelFor(height, [=](int begin, int end) {
+        QVector<quint32> first(width), second(width);
+        for (int y = begin; y < end; ++y) {
+            blurLine(pixels + y * stride, width, 1, radius, first.data(), second.data());
+        }
+    });
+
+    // Dikey geçiş: sütun aralıkları paylaştırılır
+    parallelFor(width, [=](int begin, int end) {
+        QVector<quint32> first(height), second(height);
+        for (int x = begin; x < end; ++x) {
+            blurLine(pixels + x, height, stride, radius, first.data(), second.data());
+        }
+    });
+}
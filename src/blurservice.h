@@ -0,0 +1,67 @@
+#ifndef BLURSERVICE_H
+#define BLURSERVICE_H
+
+#include <QObject>
+#include <QHash>
+#include <QImage>
+#include <QRect>
+
+class QPainter;
+class QThreadPool;
+class QWidget;
+
+// Duvar kağıdının bulanık kopyasını yalnızca duvar kağıdı veya tema
+// değiştiğinde üretir. Masaüstü, panel ve açılır menüler bu hazır sonucu
+// örnekler; etkileşim sırasında yeniden bulanıklaştırma yapılmaz.
+class BlurService : public QObject
+{
+    Q_OBJECT
+
+public:
+    static BlurService *instance();
+    ~BlurService();
+
+    void setRadius(int radius);
+    int radius() const { return m_radius; }
+
+    // Bir ekran yüzeyinin duvar kağıdını günceller (geometri masaüstü koordinatlarında)
+    void setSurface(int id, const QRect &geometry, const QImage &image);
+    void removeSurface(int id);
+
+    bool hasBackdrop(const QRect &desktopRect) const;
+
+    // desktopRect bölgesinin bulanık arka planını target alanına kopyalar
+    void paint(QPainter *painter, const QRect &target, const QRect &desktopRect) const;
+
+    // Üst düzey açılır pencerelerin kendi çiziminden önce arka planı çizer
+    void installBackdrop(QWidget *widget, int cornerRadius = 0);
+
+    // Ayrılabilir üç geçişli kutu bulanıklığı; satır/sütunlar iş parçacıklarına bölünür
+    static void blur(QImage &image, int radius);
+
+signals:
+    void backdropChanged(const QRect &desktopRect);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    explicit BlurService(QObject *parent = nullptr);
+
+    struct Surface {
+        QRect geometry;
+        QImage source;
+        QImage blurred;
+        int generation;
+    };
+
+    void scheduleBlur(int id);
+
+    QHash<int, Surface> m_surfaces;
+    QHash<QWidget *, int> m_backdropWidgets;
+    QThreadPool *m_pool;
+    int m_radius;
+    int m_generation;
+};
+
+#endif // BLURSERVICE_H
@@ -0,0 +1,99 @@
+#include "desktopfileactions.h"
+#include "iconcache.h"
+#include "appcatalog.h"
+#include "applauncher.h"
+#include <QMenu>
+#include <QAction>
+#include <QMessageBox>
+#include <QDesktopServices>
+#include <QUrl>
+#include <QFileDialog>
+#include <QInputDialog>
+#include <QDir>
+
+namespace DesktopFileActions {
+
+void launch(const QFileInfo &fileInfo)
+{
+    if (fileInfo.suffix().toLower() == "desktop") {
+        // Exec satırı alan kodlarıyla birlikte başlatıcıda açılır
+        const AppEntry entry = AppCatalog::readDesktopFile(fileInfo.absoluteFilePath());
+        if (entry.isValid()) {
+            AppLauncher::instance()->launch(entry);
+        }
+    } else if (fileInfo.isDir()) {
+        // Klasör için dosya yöneticisini aç
+        AppLauncher::instance()->launchProgram("xdg-open", QStringList() << fileInfo.absoluteFilePath());
+    } else {
+        // Normal dosyayı varsayılan uygulamayla aç
+        QDesktopServices::openUrl(QUrl::fromLocalFile(fileInfo.absoluteFilePath()));
+    }
+}
+
+void execContextMenu(const QFileInfo &fileInfo, QWidget *parent, const QPoint &globalPos)
+{
+    QMenu menu(parent);
+    
+    menu.addAction(IconCache::instance()->icon("document-open"), "Aç", [fileInfo]() { launch(fileInfo); });
+    
+    if (!fileInfo.isDir()) {
+        menu.addAction("İle Aç...", [parent, fileInfo]() {
+            QString program = QFileDialog::getOpenFileName(parent, "Uygulama Seç", "/usr/bin");
+            if (!program.isEmpty()) {
+                AppLauncher::instance()->launchProgram(program, QStringList() << fileInfo.absoluteFilePath());
+            }
+        });
+    }
+    
+    menu.addSeparator();
+    
+    menu.addAction(IconCache::instance()->icon("edit-cut"), "Kes");
+    menu.addAction(IconCache::instance()->icon("edit-copy"), "Kopyala");
+    
+    menu.addSeparator();
+    
+    menu.addAction(IconCache::instance()->icon("edit-delete"), "Sil", [parent, fileInfo]() {
+        if (QMessageBox::question(parent, "Sil", 
+                                 QString("\"%1\" öğesini silmek istediğinize emin misiniz?").arg(fileInfo.fileName())) == QMessageBox::Yes) {
+            
+            if (fileInfo.isDir()) {
+                QDir dir(fileInfo.absoluteFilePath());
+                dir.removeRecursively();
+            } else {
+                QFile file(fileInfo.absoluteFilePath());
+                file.remove();
+            }
+            
+            // Simge, masaüstü dizin izleyicisi tarafından kaldırılır
+        }
+    });
+    
+    menu.addAction(IconCache::instance()->icon("edit-rename"), "Yeniden Adlandır", [parent, fileInfo]() {
+        QString newName = QInputDialog::getText(parent, "Yeniden Adlandır", 
+                                              "Yeni ad:", QLineEdit::Normal, fileInfo.fileName());
+        if (!newName.isEmpty() && newName != fileInfo.fileName()) {
+            QString newPath = fileInfo.absolutePath() + "/" + newName;
+            QFile file(fileInfo.absoluteFilePath());
+            // Etiket, masaüstü dizin izleyicisi yeniden adlandırmayı görünce güncellenir
+            if (!file.rename(newPath)) {
+                QMessageBox::warning(parent, "Hata", "Yeniden adlandırma başarısız oldu.");
+            }
+        }
+    });
+    
+    menu.addSeparator();
+    
+    menu.addAction(IconCache::instance()->icon("document-properties"), "Özellikler", [parent, fileInfo]() {
+        // Dosya özellikleri penceresi
+        QMessageBox::information(parent, "Özellikler", 
+                               QString("Ad: %1\nTür: %2\nBoyut: %3 bayt\nKonum: %4")
+                               .arg(fileInfo.fileName())
+                               .arg(fileInfo.isDir() ? "Klasör" : fileInfo.suffix() + " dosyası")
+                               .arg(fileInfo.size())
+                               .arg(fileInfo.absolutePath()));
+    });
+    
+    menu.exec(globalPos);
+}
+
+} // namespace DesktopFileActions
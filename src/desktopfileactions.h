@@ -0,0 +1,19 @@
+#ifndef DESKTOPFILEACTIONS_H
+#define DESKTOPFILEACTIONS_H
+
+#include <QFileInfo>
+#include <QPoint>
+
+class QWidget;
+
+// Masaüstündeki dosyalar üzerindeki işlemler (açma ve sağ tık menüsü)
+namespace DesktopFileActions {
+
+// .desktop dosyaları başlatıcıyla, klasörler dosya yöneticisiyle, diğer
+// dosyalar varsayılan uygulamayla açılır
+void launch(const QFileInfo &fileInfo);
+void execContextMenu(const QFileInfo &fileInfo, QWidget *parent, const QPoint &globalPos);
+
+} // namespace DesktopFileActions
+
+#endif // DESKTOPFILEACTIONS_H
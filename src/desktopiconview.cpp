@@ -0,0 +1,821 @@
+#include "desktopiconview.h"
+#include "desktopfileactions.h"
+#include "iconcache.h"
+#include "thumbnailservice.h"
+#include <QApplication>
+#include <QContextMenuEvent>
+#include <QDateTime>
+#include <QDragEnterEvent>
+#include <QDropEvent>
+#include <QKeyEvent>
+#include <QDrag>
+#include <QMimeData>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QScreen>
+#include <QStandardPaths>
+#include <QTimer>
+#include <QUrl>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+namespace {
+
+const int LabelWidth = 76;
+const int LabelTop = 56;
+const int LabelPadding = 3;
+
+} // namespace
+
+IconSortMode iconSortModeFromString(const QString &name)
+{
+    if (name == "name") return IconSortMode::Name;
+    if (name == "type") return IconSortMode::Type;
+    if (name == "date") return IconSortMode::Date;
+    return IconSortMode::Manual;
+}
+
+QString iconSortModeToString(IconSortMode mode)
+{
+    switch (mode) {
+    case IconSortMode::Name: return "name";
+    case IconSortMode::Type: return "type";
+    case IconSortMode::Date: return "date";
+    default: return "manual";
+    }
+}
+
+DesktopIconView::DesktopIconView(QWidget *parent)
+    : QWidget(parent)
+    , m_directory(QStandardPaths::writableLocation(QStandardPaths::DesktopLocation))
+    , m_hovered(-1)
+    , m_current(-1)
+    , m_anchor(-1)
+    , m_pressed(-1)
+    , m_pressMoved(false)
+    , m_banding(false)
+    , m_bandToggle(false)
+    , m_bandTimer(new QTimer(this))
+{
+    // Arka plan boyanmaz; altındaki duvar kağıdı görünür
+    setAttribute(Qt::WA_NoSystemBackground);
+    setMouseTracking(true);
+    setFocusPolicy(Qt::StrongFocus);
+    setAcceptDrops(true);
+    
+    // Sürükleme sırasında gelen fare hareketleri biriktirilir, seçim en fazla
+    // ekran yenileme hızında bir kez hesaplanır
+    m_bandTimer->setSingleShot(true);
+    connect(m_bandTimer, &QTimer::timeout, this, &DesktopIconView::applyRubberBand);
+    
+    // Görüntü dosyalarının küçük resimleri arka planda hazırlanır
+    connect(ThumbnailService::instance(), &ThumbnailService::thumbnailReady,
+            this, &DesktopIconView::onThumbnailReady);
+}
+
+DesktopIconView::~DesktopIconView()
+{
+}
+
+void DesktopIconView::setupEntry(Entry &entry, const QFileInfo &fileInfo)
+{
+    entry.name = fileInfo.fileName();
+    entry.isDir = fileInfo.isDir();
+    entry.nameKey = entry.name.toCaseFolded();
+    entry.typeKey = entry.isDir ? QString() : fileInfo.suffix().toCaseFolded();
+    entry.modified = fileInfo.lastModified().toMSecsSinceEpoch();
+
+    // Aynı türdeki dosyalar tek bir piksel haritasını paylaşır; görüntüler
+    // küçük resmi gelene kadar tür simgesiyle çizilir
+    entry.pixmap = IconCache::instance()->filePixmap(fileInfo, IconSize, devicePixelRatioF());
+    if (ThumbnailService::canThumbnail(fileInfo)) {
+        const int size = qRound(IconSize * devicePixelRatioF());
+        const QImage thumbnail = ThumbnailService::instance()->cached(fileInfo, size);
+        if (!thumbnail.isNull()) {
+            entry.pixmap = thumbnailPixmap(thumbnail);
+        } else {
+            ThumbnailService::instance()->request(fileInfo, size);
+        }
+    }
+
+    // Kısaltılmış etiketin düzeni bir kez hazırlanır, her boyamada yeniden hesaplanmaz
+    const QString elided = fontMetrics().elidedText(entry.name, Qt::ElideMiddle, LabelWidth - 2 * LabelPadding);
+    entry.label = QStaticText(elided);
+    entry.label.setTextFormat(Qt::PlainText);
+    entry.label.setPerformanceHint(QStaticText::AggressiveCaching);
+    entry.label.prepare(QTransform(), font());
+}
+
+void DesktopIconView::addEntry(const QFileInfo &fileInfo, const QPoint &position)
+{
+    Entry entry;
+    entry.position = position;
+    entry.selected = false;
+    setupEntry(entry, fileInfo);
+
+    m_indexByName.insert(entry.name, m_entries.size());
+    m_entries.append(entry);
+    insertIntoIndex(m_entries.size() - 1);
+    update(cellRect(m_entries.size() - 1));
+}
+
+void DesktopIconView::updateEntry(const QString &name, const QFileInfo &fileInfo)
+{
+    const int index = m_indexByName.value(name, -1);
+    if (index < 0) {
+        return;
+    }
+
+    setupEntry(m_entries[index], fileInfo);
+    update(cellRect(index));
+}
+
+void DesktopIconView::renameEntry(const QString &oldName, const QFileInfo &fileInfo)
+{
+    const int index = m_indexByName.take(oldName);
+    setupEntry(m_entries[index], fileInfo);
+    m_indexByName.insert(m_entries.at(index).name, index);
+    update(cellRect(index));
+}
+
+void DesktopIconView::removeEntry(const QString &name)
+{
+    const int index = m_indexByName.value(name, -1);
+    if (index < 0) {
+        return;
+    }
+
+    update(cellRect(index));
+    m_indexByName.remove(name);
+    ThumbnailService::instance()->cancel(fileInfoAt(index).absoluteFilePath());
+
+    // Son kayıt boşalan yere taşınır; silme O(1)
+    const int last = m_entries.size() - 1;
+    removeFromIndex(index);
+    if (index != last) {
+        removeFromIndex(last);
+        m_entries[index] = m_entries.at(last);
+        m_indexByName[m_entries.at(index).name] = index;
+        insertIntoIndex(index);
+    }
+    m_entries.removeLast();
+
+    // Seçim kümesi taşınan son kaydı izler
+    m_selected.remove(index);
+    if (m_selected.remove(last)) {
+        m_selected.insert(index);
+    }
+
+    // Bant sırasında indisler kaydığından başlangıç seçimi yeniden kurulur
+    if (m_banding) {
+        m_bandBase.remove(index);
+        if (m_bandBase.remove(last)) {
+            m_bandBase.insert(index);
+        }
+    }
+
+    for (int *tracked : { &m_hovered, &m_current, &m_anchor, &m_pressed }) {
+        if (*tracked == index) {
+            *tracked = -1;
+        } else if (*tracked == last) {
+            *tracked = index;
+        }
+    }
+}
+
+QVector<QPoint> DesktopIconView::positions() const
+{
+    QVector<QPoint> result;
+    result.reserve(m_entries.size());
+    for (const Entry &entry : m_entries) {
+        result.append(entry.position);
+    }
+    return result;
+}
+
+QPoint DesktopIconView::position(const QString &name) const
+{
+    const int index = m_indexByName.value(name, -1);
+    return index < 0 ? QPoint() : m_entries.at(index).position;
+}
+
+void DesktopIconView::moveEntry(const QString &name, const QPoint &position)
+{
+    const int index = m_indexByName.value(name, -1);
+    if (index < 0 || m_entries.at(index).position == position) {
+        return;
+    }
+
+    update(cellRect(index));
+    removeFromIndex(index);
+    m_entries[index].position = position;
+    insertIntoIndex(index);
+    update(cellRect(index));
+}
+
+void DesktopIconView::arrange(const QRect &area, IconSortMode mode)
+{
+    QVector<int> order(m_entries.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    // Klasörler her modda önce gelir; anahtarlar önceden hesaplandığından
+    // karşılaştırma dosya sistemine dokunmaz
+    auto byName = [this](int a, int b) {
+        const Entry &ea = m_entries.at(a);
+        const Entry &eb = m_entries.at(b);
+        if (ea.isDir != eb.isDir) {
+            return ea.isDir;
+        }
+        return ea.nameKey < eb.nameKey;
+    };
+
+    switch (mode) {
+    case IconSortMode::Manual:
+        // Görsel sıra (satır, sütun) korunarak yeniden dizilir
+        std::sort(order.begin(), order.end(), [this](int a, int b) {
+            const QPoint &pa = m_entries.at(a).position;
+            const QPoint &pb = m_entries.at(b).position;
+            return pa.y() != pb.y() ? pa.y() < pb.y() : pa.x() < pb.x();
+        });
+        break;
+    case IconSortMode::Name:
+        std::sort(order.begin(), order.end(), byName);
+        break;
+    case IconSortMode::Type:
+        std::sort(order.begin(), order.end(), [this, &byName](int a, int b) {
+            const Entry &ea = m_entries.at(a);
+            const Entry &eb = m_entries.at(b);
+            if (ea.isDir != eb.isDir || ea.typeKey == eb.typeKey) {
+                return byName(a, b);
+            }
+            return ea.typeKey < eb.typeKey;
+        });
+        break;
+    case IconSortMode::Date:
+        std::sort(order.begin(), order.end(), [this, &byName](int a, int b) {
+            const Entry &ea = m_entries.at(a);
+            const Entry &eb = m_entries.at(b);
+            if (ea.isDir != eb.isDir || ea.modified == eb.modified) {
+                return byName(a, b);
+            }
+            return ea.modified > eb.modified;
+        });
+        break;
+    }
+
+    const int maxColumns = qMax(1, (area.width() - 20) / GridSpacing);
+    for (int i = 0; i < order.size(); ++i) {
+        m_entries[order.at(i)].position = QPoint(area.x() + 10 + (i % maxColumns) * GridSpacing,
+                                                 area.y() + 10 + (i / maxColumns) * GridSpacing);
+    }
+
+    rebuildIndex();
+    update();
+}
+
+QPixmap DesktopIconView::thumbnailPixmap(const QImage &image) const
+{
+    const qreal dpr = devicePixelRatioF();
+    QPixmap pixmap = QPixmap::fromImage(image.scaled(QSize(IconSize, IconSize) * dpr,
+                                                     Qt::KeepAspectRatio, Qt::SmoothTransformation));
+    pixmap.setDevicePixelRatio(dpr);
+    return pixmap;
+}
+
+void DesktopIconView::onThumbnailReady(const QString &path, const QImage &image)
+{
+    const QFileInfo fileInfo(path);
+    if (fileInfo.absolutePath() != QFileInfo(m_directory).absoluteFilePath()) {
+        return;
+    }
+
+    const int index = m_indexByName.value(fileInfo.fileName(), -1);
+    if (index < 0) {
+        return;
+    }
+
+    m_entries[index].pixmap = thumbnailPixmap(image);
+    update(cellRect(index));
+}
+
+QFileInfo DesktopIconView::fileInfoAt(int index) const
+{
+    return QFileInfo(m_directory + "/" + m_entries.at(index).name);
+}
+
+QRect DesktopIconView::cellRect(int index) const
+{
+    return QRect(m_entries.at(index).position, QSize(CellWidth, CellHeight));
+}
+
+int DesktopIconView::bucketOf(int coordinate)
+{
+    return int(std::floor(double(coordinate) / GridSpacing));
+}
+
+quint64 DesktopIconView::bucketKey(int column, int row)
+{
+    return (quint64(quint32(row)) << 32) | quint32(column);
+}
+
+void DesktopIconView::insertIntoIndex(int index)
+{
+    const QPoint &position = m_entries.at(index).position;
+    m_buckets[bucketKey(bucketOf(position.x()), bucketOf(position.y()))].append(index);
+}
+
+void DesktopIconView::removeFromIndex(int index)
+{
+    const QPoint &position = m_entries.at(index).position;
+    auto it = m_buckets.find(bucketKey(bucketOf(position.x()), bucketOf(position.y())));
+    if (it == m_buckets.end()) {
+        return;
+    }
+
+    it->removeOne(index);
+    if (it->isEmpty()) {
+        m_buckets.erase(it);
+    }
+}
+
+void DesktopIconView::rebuildIndex()
+{
+    m_buckets.clear();
+    for (int i = 0; i < m_entries.size(); ++i) {
+        insertIntoIndex(i);
+    }
+}
+
+QVector<int> DesktopIconView::entriesIn(const QRect &rect) const
+{
+    QVector<int> result;
+    if (rect.isEmpty()) {
+        return result;
+    }
+
+    // Hücre kovadan büyük olmadığından sol ve üst komşu kovalar da taranır
+    const int left = bucketOf(rect.left() - CellWidth + 1);
+    const int right = bucketOf(rect.right());
+    const int top = bucketOf(rect.top() - CellHeight + 1);
+    const int bottom = bucketOf(rect.bottom());
+
+    for (int row = top; row <= bottom; ++row) {
+        for (int column = left; column <= right; ++column) {
+            auto it = m_buckets.constFind(bucketKey(column, row));
+            if (it == m_buckets.constEnd()) {
+                continue;
+            }
+            for (int index : it.value()) {
+                if (cellRect(index).intersects(rect)) {
+                    result.append(index);
+                }
+            }
+        }
+    }
+    return result;
+}
+
+int DesktopIconView::indexAt(const QPoint &pos) const
+{
+    const QVector<int> hits = entriesIn(QRect(pos, QSize(1, 1)));
+    return hits.isEmpty() ? -1 : hits.last();
+}
+
+int DesktopIconView::neighbour(int index, int dx, int dy) const
+{
+    // Izgara adımlarıyla ilerleyerek o yöndeki ilk simgeyi bul
+    const QPoint origin = cellRect(index).center();
+    for (int step = 1; ; ++step) {
+        const QPoint point = origin + QPoint(dx, dy) * (GridSpacing * step);
+        if (!rect().contains(point)) {
+            return -1;
+        }
+        const int found = indexAt(point);
+        if (found >= 0 && found != index) {
+            return found;
+        }
+    }
+}
+
+void DesktopIconView::setHovered(int index)
+{
+    if (m_hovered == index) {
+        return;
+    }
+
+    // Yalnızca eski ve yeni simgenin alanı yeniden boyanır
+    if (m_hovered >= 0) {
+        update(cellRect(m_hovered));
+    }
+    m_hovered = index;
+    if (m_hovered >= 0) {
+        update(cellRect(m_hovered));
+    }
+}
+
+void DesktopIconView::setCurrent(int index)
+{
+    if (m_current == index) {
+        return;
+    }
+
+    if (m_current >= 0) {
+        update(cellRect(m_current));
+    }
+    m_current = index;
+    if (m_current >= 0) {
+        update(cellRect(m_current));
+    }
+}
+
+void DesktopIconView::setEntrySelected(int index, bool selected)
+{
+    if (m_entries.at(index).selected == selected) {
+        return;
+    }
+
+    m_entries[index].selected = selected;
+    if (selected) {
+        m_selected.insert(index);
+    } else {
+        m_selected.remove(index);
+    }
+    update(cellRect(index));
+}
+
+void DesktopIconView::clearSelection()
+{
+    // Yalnızca seçili girdiler gezilir; simge sayısından bağımsız
+    const QSet<int> selected = m_selected;
+    for (int index : selected) {
+        setEntrySelected(index, false);
+    }
+}
+
+void DesktopIconView::selectOnly(int index)
+{
+    clearSelection();
+    if (index >= 0) {
+        setEntrySelected(index, true);
+    }
+}
+
+void DesktopIconView::selectRange(int from, int to)
+{
+    // Masaüstünde aralık, iki simgenin kapsadığı dikdörtgendir
+    clearSelection();
+    if (from < 0) {
+        from = to;
+    }
+    for (int index : entriesIn(cellRect(from).united(cellRect(to)))) {
+        setEntrySelected(index, true);
+    }
+}
+
+QList<QUrl> DesktopIconView::selectedUrls() const
+{
+    QList<QUrl> urls;
+    for (int index : m_selected) {
+        urls << QUrl::fromLocalFile(fileInfoAt(index).absoluteFilePath());
+    }
+    return urls;
+}
+
+void DesktopIconView::applyRubberBand()
+{
+    if (!m_banding) {
+        return;
+    }
+
+    const QRect band = QRect(m_pressPosition, m_bandEnd).normalized();
+
+    // Yalnızca eski ve yeni bandın kapsadığı simgeler yeniden değerlendirilir
+    for (int index : entriesIn(band.united(m_bandRect))) {
+        const bool inBand = cellRect(index).intersects(band);
+        const bool base = m_bandBase.contains(index);
+        setEntrySelected(index, m_bandToggle ? base != inBand : base || inBand);
+    }
+
+    update(m_bandRect.adjusted(-1, -1, 1, 1));
+    update(band.adjusted(-1, -1, 1, 1));
+    m_bandRect = band;
+}
+
+void DesktopIconView::paintEntry(QPainter &painter, const Entry &entry, const QPoint &origin, bool hovered) const
+{
+    painter.setPen(Qt::NoPen);
+
+    if (hovered || entry.selected) {
+        // Üzerine gelindiğinde veya seçiliyken arka planı çiz
+        painter.setBrush(QColor(255, 255, 255, entry.selected ? 70 : 40));
+        painter.drawRoundedRect(QRect(origin, QSize(CellWidth, CellHeight)), 8, 8);
+    }
+
+    // Küçük resimler kare olmayabilir; simge alanında ortalanır
+    const QSize pixmapSize = entry.pixmap.size() / entry.pixmap.devicePixelRatio();
+    painter.drawPixmap(origin.x() + (CellWidth - pixmapSize.width()) / 2,
+                       origin.y() + 4 + (IconSize - pixmapSize.height()) / 2, entry.pixmap);
+
+    // Metin için kontrastlı yarı saydam zemin
+    const QSizeF textSize = entry.label.size();
+    const QRectF labelRect(origin.x() + (CellWidth - textSize.width()) / 2 - LabelPadding,
+                           origin.y() + LabelTop,
+                           textSize.width() + 2 * LabelPadding,
+                           textSize.height() + 2);
+    painter.setBrush(QColor(0, 0, 0, hovered ? 100 : 70));
+    painter.drawRoundedRect(labelRect, 4, 4);
+
+    painter.setPen(Qt::white);
+    painter.drawStaticText(labelRect.topLeft() + QPointF(LabelPadding, 1), entry.label);
+}
+
+void DesktopIconView::paintEvent(QPaintEvent *event)
+{
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    // Yalnızca kirli alana düşen simgeler dizinden alınır
+    QVector<int> dirty = entriesIn(event->rect());
+    std::sort(dirty.begin(), dirty.end());
+    for (int index : qAsConst(dirty)) {
+        paintEntry(painter, m_entries.at(index), m_entries.at(index).position, index == m_hovered);
+    }
+
+    if (hasFocus() && m_current >= 0 && cellRect(m_current).intersects(event->rect())) {
+        painter.setPen(QPen(QColor(255, 255, 255, 120), 1, Qt::DotLine));
+        painter.setBrush(Qt::NoBrush);
+        painter.drawRoundedRect(QRectF(cellRect(m_current)).adjusted(0.5, 0.5, -0.5, -0.5), 8, 8);
+    }
+
+    if (m_banding && !m_bandRect.isEmpty()) {
+        painter.setPen(QColor(255, 255, 255, 140));
+        painter.setBrush(QColor(255, 255, 255, 40));
+        painter.drawRect(QRectF(m_bandRect).adjusted(0.5, 0.5, -0.5, -0.5));
+    }
+}
+
+void DesktopIconView::mousePressEvent(QMouseEvent *event)
+{
+    const int index = indexAt(event->pos());
+    const bool control = event->modifiers() & Qt::ControlModifier;
+    const bool shift = event->modifiers() & Qt::ShiftModifier;
+
+    m_pressPosition = event->pos();
+    m_pressed = -1;
+    m_pressMoved = false;
+
+    if (event->button() == Qt::LeftButton) {
+        if (index < 0) {
+            // Boş alanda lastik bant başlar; Ctrl mevcut seçimi korur ve tersine çevirir
+            if (!control) {
+                clearSelection();
+            }
+            m_banding = true;
+            m_bandToggle = control;
+            m_bandEnd = event->pos();
+            m_bandRect = QRect();
+            m_bandBase = m_selected;
+        } else if (shift) {
+            selectRange(m_anchor, index);
+            setCurrent(index);
+        } else if (control) {
+            setEntrySelected(index, !m_entries.at(index).selected);
+            m_anchor = index;
+            setCurrent(index);
+        } else {
+            // Seçili bir simgeye basılırsa çoklu seçim sürükleme için korunur
+            if (!m_entries.at(index).selected) {
+                selectOnly(index);
+            }
+            m_pressed = index;
+            m_anchor = index;
+            setCurrent(index);
+        }
+    } else if (index >= 0 && !m_entries.at(index).selected) {
+        selectOnly(index);
+        m_anchor = index;
+        setCurrent(index);
+    }
+
+    QWidget::mousePressEvent(event);
+}
+
+void DesktopIconView::mouseMoveEvent(QMouseEvent *event)
+{
+    if (m_banding) {
+        m_bandEnd = event->pos();
+        if (!m_bandTimer->isActive()) {
+            const qreal refreshRate = screen() ? screen()->refreshRate() : 60.0;
+            m_bandTimer->start(qMax(1, qRound(1000.0 / qMax<qreal>(refreshRate, 1.0))));
+        }
+        return;
+    }
+
+    if ((event->buttons() & Qt::LeftButton) && m_pressed >= 0) {
+        if ((event->pos() - m_pressPosition).manhattanLength() >= QApplication::startDragDistance()) {
+            const int index = m_pressed;
+            m_pressed = -1;
+            m_pressMoved = true;
+            startDrag(index, m_pressPosition);
+        }
+        return;
+    }
+
+    setHovered(indexAt(event->pos()));
+}
+
+void DesktopIconView::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (m_banding) {
+        m_bandEnd = event->pos();
+        m_bandTimer->stop();
+        applyRubberBand();
+
+        m_banding = false;
+        m_bandBase.clear();
+        update(m_bandRect.adjusted(-1, -1, 1, 1));
+        m_bandRect = QRect();
+    } else if (m_pressed >= 0 && !m_pressMoved && event->button() == Qt::LeftButton) {
+        // Sürüklenmeden bırakılan tıklama çoklu seçimi tek simgeye indirir
+        selectOnly(m_pressed);
+    }
+
+    m_pressed = -1;
+    QWidget::mouseReleaseEvent(event);
+}
+
+void DesktopIconView::mouseDoubleClickEvent(QMouseEvent *event)
+{
+    const int index = indexAt(event->pos());
+    if (event->button() == Qt::LeftButton && index >= 0) {
+        DesktopFileActions::launch(fileInfoAt(index));
+    }
+    QWidget::mouseDoubleClickEvent(event);
+}
+
+void DesktopIconView::keyPressEvent(QKeyEvent *event)
+{
+    if (event->matches(QKeySequence::SelectAll)) {
+        for (int i = 0; i < m_entries.size(); ++i) {
+            setEntrySelected(i, true);
+        }
+        return;
+    }
+
+    int dx = 0;
+    int dy = 0;
+    switch (event->key()) {
+    case Qt::Key_Left:  dx = -1; break;
+    case Qt::Key_Right: dx = 1;  break;
+    case Qt::Key_Up:    dy = -1; break;
+    case Qt::Key_Down:  dy = 1;  break;
+    case Qt::Key_Escape:
+        clearSelection();
+        return;
+    case Qt::Key_Space:
+        if (m_current >= 0) {
+            setEntrySelected(m_current, !(event->modifiers() & Qt::ControlModifier) || !m_entries.at(m_current).selected);
+        }
+        return;
+    case Qt::Key_Return:
+    case Qt::Key_Enter:
+        for (int index : qAsConst(m_selected)) {
+            DesktopFileActions::launch(fileInfoAt(index));
+        }
+        return;
+    default:
+        QWidget::keyPressEvent(event);
+        return;
+    }
+
+    int target = -1;
+    if (m_current < 0) {
+        // Odak yoksa sol üstteki simgeden başla
+        QVector<int> visible = entriesIn(rect());
+        for (int index : qAsConst(visible)) {
+            const QPoint &p = m_entries.at(index).position;
+            if (target < 0 || p.y() < m_entries.at(target).position.y()
+                || (p.y() == m_entries.at(target).position.y() && p.x() < m_entries.at(target).position.x())) {
+                target = index;
+            }
+        }
+    } else {
+        target = neighbour(m_current, dx, dy);
+    }
+
+    if (target < 0) {
+        return;
+    }
+
+    if (event->modifiers() & Qt::ShiftModifier) {
+        selectRange(m_anchor, target);
+    } else if (!(event->modifiers() & Qt::ControlModifier)) {
+        // Ctrl yalnızca odağı taşır, seçime dokunmaz
+        selectOnly(target);
+        m_anchor = target;
+    }
+    setCurrent(target);
+}
+
+void DesktopIconView::leaveEvent(QEvent *event)
+{
+    setHovered(-1);
+    QWidget::leaveEvent(event);
+}
+
+void DesktopIconView::dragEnterEvent(QDragEnterEvent *event)
+{
+    // Yalnızca masaüstünün kendi simgeleri taşınır
+    if (event->source() == this) {
+        event->setDropAction(Qt::MoveAction);
+        event->accept();
+    } else {
+        event->ignore();
+    }
+}
+
+void DesktopIconView::dragMoveEvent(QDragMoveEvent *event)
+{
+    if (event->source() == this) {
+        event->setDropAction(Qt::MoveAction);
+        event->accept();
+    } else {
+        event->ignore();
+    }
+}
+
+void DesktopIconView::dropEvent(QDropEvent *event)
+{
+    if (event->source() != this) {
+        event->ignore();
+        return;
+    }
+
+    // Seçili simgeler aynı uzaklıkla serbestçe kaydırılır; görünür alanda kalır
+    const QPoint delta = event->pos() - m_pressPosition;
+    const QRect bounds = rect().adjusted(0, 0, -CellWidth, -CellHeight);
+    QStringList moved;
+    for (int i : qAsConst(m_selected)) {
+        const QPoint target = m_entries.at(i).position + delta;
+        moveEntry(m_entries.at(i).name,
+                  QPoint(qBound(bounds.left(), target.x(), qMax(bounds.left(), bounds.right())),
+                         qBound(bounds.top(), target.y(), qMax(bounds.top(), bounds.bottom()))));
+        moved << m_entries.at(i).name;
+    }
+
+    event->setDropAction(Qt::MoveAction);
+    event->accept();
+
+    if (!moved.isEmpty()) {
+        emit entriesMoved(moved);
+    }
+}
+
+void DesktopIconView::contextMenuEvent(QContextMenuEvent *event)
+{
+    const int index = indexAt(event->pos());
+    if (index < 0) {
+        // Boş alan: masaüstü menüsü üst widget'ta açılır
+        event->ignore();
+        return;
+    }
+
+    // Menü tek dosyaya etki ettiğinden seçim tıklanan simgeye indirilir
+    selectOnly(index);
+    m_anchor = index;
+    setCurrent(index);
+    DesktopFileActions::execContextMenu(fileInfoAt(index), this, event->globalPos());
+}
+
+void DesktopIconView::startDrag(int index, const QPoint &pos)
+{
+    const Entry &entry = m_entries.at(index);
+
+    // Sürükleme işlemini başlat
+    QDrag *drag = new QDrag(this);
+    QMimeData *mimeData = new QMimeData;
+
+    // URL olarak dosya/klasör yolunu ekle
+    // Çoklu seçimde tüm seçili öğeler birlikte sürüklenir
+    QList<QUrl> urls = selectedUrls();
+    if (urls.isEmpty()) {
+        urls << QUrl::fromLocalFile(fileInfoAt(index).absoluteFilePath());
+    }
+    mimeData->setUrls(urls);
+    drag->setMimeData(mimeData);
+
+    // Sürükleme sırasındaki görüntü simgenin kendisinden üretilir
+    QPixmap pixmap(CellWidth, CellHeight);
+    pixmap.fill(Qt::transparent);
+    QPainter painter(&pixmap);
+    painter.setRenderHint(QPainter::Antialiasing);
+    paintEntry(painter, entry, QPoint(0, 0), true);
+    painter.end();
+
+    drag->setPixmap(pixmap);
+    drag->setHotSpot(pos - entry.position);
+
+    drag->exec(Qt::CopyAction | Qt::MoveAction | Qt::LinkAction);
+}
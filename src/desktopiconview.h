@@ -0,0 +1,142 @@
+#ifndef DESKTOPICONVIEW_H
+#define DESKTOPICONVIEW_H
+
+#include <QWidget>
+#include <QFileInfo>
+#include <QHash>
+#include <QSet>
+#include <QPixmap>
+#include <QStaticText>
+#include <QUrl>
+#include <QVector>
+
+class QTimer;
+
+// Simgelerin otomatik dizilme ölçütü; Manual kullanıcının yerleştirdiği konumları korur
+enum class IconSortMode {
+    Manual,
+    Name,
+    Type,
+    Date
+};
+
+IconSortMode iconSortModeFromString(const QString &name);
+QString iconSortModeToString(IconSortMode mode);
+
+// Tüm masaüstü simgelerini tek bir widget'ta, düz bir dizi üzerinden çizer.
+// Simge başına QObject yoktur; etiket düzeni önbelleklenir ve yalnızca
+// değişen simgenin alanı yeniden boyanır. İsabet testleri ve seçim
+// dikdörtgeni sorguları tekdüze bir ızgara dizini üzerinden yapılır; maliyet
+// simge sayısıyla değil sorgulanan alanla orantılıdır.
+class DesktopIconView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit DesktopIconView(QWidget *parent = nullptr);
+    ~DesktopIconView();
+
+    static constexpr int CellWidth = 80;
+    static constexpr int CellHeight = 90;
+    static constexpr int IconSize = 48;
+    static constexpr int GridSpacing = 90;
+
+    void addEntry(const QFileInfo &fileInfo, const QPoint &position);
+    void updateEntry(const QString &name, const QFileInfo &fileInfo);
+    void renameEntry(const QString &oldName, const QFileInfo &fileInfo);
+    void removeEntry(const QString &name);
+
+    QVector<QPoint> positions() const;
+    QPoint position(const QString &name) const;
+    void moveEntry(const QString &name, const QPoint &position);
+    QStringList names() const { return m_indexByName.keys(); }
+    int count() const { return m_entries.size(); }
+
+    // Simgeleri ızgaraya yeniden dizer; Manual modda mevcut görsel sıra korunur
+    void arrange(const QRect &area, IconSortMode mode = IconSortMode::Manual);
+
+signals:
+    // Kullanıcı simgeleri sürükleyip masaüstünde yeni bir yere bıraktı
+    void entriesMoved(const QStringList &names);
+
+private slots:
+    void onThumbnailReady(const QString &path, const QImage &image);
+    void applyRubberBand();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+    void keyPressEvent(QKeyEvent *event) override;
+    void leaveEvent(QEvent *event) override;
+    void dragEnterEvent(QDragEnterEvent *event) override;
+    void dragMoveEvent(QDragMoveEvent *event) override;
+    void dropEvent(QDropEvent *event) override;
+    void contextMenuEvent(QContextMenuEvent *event) override;
+
+private:
+    // Simge başına tutulan tek kayıt; piksel haritası aynı türdeki dosyalarla paylaşılır
+    struct Entry {
+        QString name;
+        QPoint position;
+        QPixmap pixmap;
+        QStaticText label;
+        // Otomatik dizme anahtarları girdi başına bir kez hesaplanır
+        QString nameKey;
+        QString typeKey;
+        qint64 modified;
+        bool isDir;
+        bool selected;
+    };
+
+    void setupEntry(Entry &entry, const QFileInfo &fileInfo);
+    QPixmap thumbnailPixmap(const QImage &image) const;
+    QFileInfo fileInfoAt(int index) const;
+    QRect cellRect(int index) const;
+
+    // Izgara dizini: her simge sol üst köşesinin düştüğü kovada tutulur
+    static int bucketOf(int coordinate);
+    static quint64 bucketKey(int column, int row);
+    void insertIntoIndex(int index);
+    void removeFromIndex(int index);
+    void rebuildIndex();
+    QVector<int> entriesIn(const QRect &rect) const;
+    int indexAt(const QPoint &pos) const;
+    int neighbour(int index, int dx, int dy) const;
+
+    void setHovered(int index);
+    void setCurrent(int index);
+    void setEntrySelected(int index, bool selected);
+    void clearSelection();
+    void selectOnly(int index);
+    void selectRange(int from, int to);
+    QList<QUrl> selectedUrls() const;
+
+    void paintEntry(QPainter &painter, const Entry &entry, const QPoint &origin, bool hovered) const;
+    void startDrag(int index, const QPoint &pos);
+
+    QString m_directory;
+    QVector<Entry> m_entries;
+    QHash<QString, int> m_indexByName;
+    QHash<quint64, QVector<int>> m_buckets;
+    QSet<int> m_selected;   // Seçili girdiler; seçim işlemleri yalnızca bunları gezer
+
+    int m_hovered;
+    int m_current;   // Klavye odağı
+    int m_anchor;    // Shift ile aralık seçiminin başlangıcı
+    int m_pressed;
+    bool m_pressMoved;
+    QPoint m_pressPosition;
+
+    // Lastik bant seçimi; fare hareketleri ekran yenileme hızına sıkıştırılır
+    bool m_banding;
+    bool m_bandToggle;
+    QPoint m_bandEnd;
+    QRect m_bandRect;
+    QSet<int> m_bandBase;
+    QTimer *m_bandTimer;
+};
+
+#endif // DESKTOPICONVIEW_H
@@ -0,0 +1,233 @@
+#include "desktoplayoutstore.h"
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThreadPool>
+#include <QTimer>
+#include <QDebug>
+#include <cstring>
+
+namespace {
+
+const quint32 LayoutMagic = 0x58444c59; // "XDLY"
+const quint32 LayoutVersion = 1;
+
+// Yazmalar bu süre içinde birleştirilir
+const int SaveDelay = 1000;
+
+struct LayoutHeader {
+    quint32 magic;
+    quint32 version;
+    quint32 count;
+    quint32 reserved;
+};
+
+// Her kaydın ardından nameLength bayt UTF-8 ad gelir
+struct LayoutRecord {
+    qint32 x;
+    qint32 y;
+    quint16 nameLength;
+};
+
+const int RecordSize = 10; // Hizalama dolgusu olmadan x, y, nameLength
+
+static_assert(sizeof(LayoutHeader) == 16, "LayoutHeader 16 bayt olmalı");
+
+void writeFile(const QString &path, const QByteArray &data)
+{
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Masaüstü düzeni yazılamadı:" << path;
+        return;
+    }
+    file.write(data);
+    file.commit();
+}
+
+} // namespace
+
+DesktopLayoutStore::DesktopLayoutStore(QObject *parent)
+    : QObject(parent)
+    , m_directory(QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + "/xenoraos/desktop-layouts")
+    , m_saveTimer(new QTimer(this))
+    , m_writer(new QThreadPool(this))
+{
+    QDir().mkpath(m_directory);
+
+    m_saveTimer->setSingleShot(true);
+    m_saveTimer->setInterval(SaveDelay);
+    connect(m_saveTimer, &QTimer::timeout, this, &DesktopLayoutStore::save);
+
+    // Tek yazıcı: dosyalar sırayla, en son anlık görüntü en son yazılır
+    m_writer->setMaxThreadCount(1);
+}
+
+DesktopLayoutStore::~DesktopLayoutStore()
+{
+    flush();
+    m_writer->waitForDone();
+}
+
+QString DesktopLayoutStore::layoutKey(const QRect &area)
+{
+    if (area.isEmpty()) {
+        return QString();
+    }
+    return QString("%1x%2+%3+%4").arg(area.width()).arg(area.height()).arg(area.x()).arg(area.y());
+}
+
+QString DesktopLayoutStore::filePath(const QString &key) const
+{
+    return m_directory + "/" + key + ".layout";
+}
+
+bool DesktopLayoutStore::setLayoutKey(const QString &key)
+{
+    if (key == m_key) {
+        return false;
+    }
+
+    flush();
+    m_key = key;
+    load();
+    return true;
+}
+
+void DesktopLayoutStore::load()
+{
+    m_positions.clear();
+    if (m_key.isEmpty()) {
+        return;
+    }
+
+    QFile file(filePath(m_key));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    // Dosya küçüktür; tek okumayla alınır ve bellekte ayrıştırılır
+    const QByteArray data = file.readAll();
+    if (data.size() < int(sizeof(LayoutHeader))) {
+        return;
+    }
+
+    LayoutHeader header;
+    std::memcpy(&header, data.constData(), sizeof(header));
+    if (header.magic != LayoutMagic || header.version != LayoutVersion) {
+        return;
+    }
+
+    m_positions.reserve(int(header.count));
+    const char *cursor = data.constData() + sizeof(header);
+    const char *end = data.constData() + data.size();
+
+    for (quint32 i = 0; i < header.count; ++i) {
+        if (end - cursor < RecordSize) {
+            break;
+        }
+
+        LayoutRecord record;
+        std::memcpy(&record.x, cursor, 4);
+        std::memcpy(&record.y, cursor + 4, 4);
+        std::memcpy(&record.nameLength, cursor + 8, 2);
+        cursor += RecordSize;
+
+        if (end - cursor < record.nameLength) {
+            break;
+        }
+
+        m_positions.insert(QString::fromUtf8(cursor, record.nameLength), QPoint(record.x, record.y));
+        cursor += record.nameLength;
+    }
+}
+
+QByteArray DesktopLayoutStore::serialize() const
+{
+    QByteArray data;
+    data.reserve(int(sizeof(LayoutHeader)) + m_positions.size() * (RecordSize + 24));
+
+    LayoutHeader header;
+    header.magic = LayoutMagic;
+    header.version = LayoutVersion;
+    header.count = 0;
+    header.reserved = 0;
+    data.append(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    for (auto it = m_positions.constBegin(); it != m_positions.constEnd(); ++it) {
+        const QByteArray name = it.key().toUtf8();
+        if (name.size() > 0xffff) {
+            continue;
+        }
+
+        const qint32 x = it.value().x();
+        const qint32 y = it.value().y();
+        const quint16 nameLength = quint16(name.size());
+        data.append(reinterpret_cast<const char *>(&x), 4);
+        data.append(reinterpret_cast<const char *>(&y), 4);
+        data.append(reinterpret_cast<const char *>(&nameLength), 2);
+        data.append(name);
+        ++header.count;
+    }
+
+    std::memcpy(data.data(), &header, sizeof(header));
+    return data;
+}
+
+void DesktopLayoutStore::setPosition(const QString &name, const QPoint &position)
+{
+    auto it = m_positions.find(name);
+    if (it != m_positions.end() && it.value() == position) {
+        return;
+    }
+
+    m_positions.insert(name, position);
+    scheduleSave();
+}
+
+void DesktopLayoutStore::rename(const QString &oldName, const QString &newName)
+{
+    if (!m_positions.contains(oldName)) {
+        return;
+    }
+
+    m_positions.insert(newName, m_positions.take(oldName));
+    scheduleSave();
+}
+
+void DesktopLayoutStore::remove(const QString &name)
+{
+    if (m_positions.remove(name) > 0) {
+        scheduleSave();
+    }
+}
+
+void DesktopLayoutStore::scheduleSave()
+{
+    // Art arda gelen değişiklikler tek yazmada birleşir
+    if (!m_key.isEmpty() && !m_saveTimer->isActive()) {
+        m_saveTimer->start();
+    }
+}
+
+void DesktopLayoutStore::save()
+{
+    if (m_key.isEmpty()) {
+        return;
+    }
+
+    // Anlık görüntü GUI iş parçacığında alınır, disk işi arka planda yapılır
+    const QString path = filePath(m_key);
+    const QByteArray data = serialize();
+    m_writer->start([path, data]() {
+        writeFile(path, data);
+    });
+}
+
+void DesktopLayoutStore::flush()
+{
+    if (m_saveTimer->isActive()) {
+        m_saveTimer->stop();
+        save();
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef DESKTOPLAYOUTSTORE_H
+#define DESKTOPLAYOUTSTORE_H
+
+#include <QObject>
+#include <QHash>
+#include <QPoint>
+#include <QRect>
+#include <QString>
+
+class QThreadPool;
+class QTimer;
+
+// Kullanıcının yerleştirdiği masaüstü simgelerinin konumlarını saklar. Her
+// ekran geometrisi için ayrı, küçük bir ikili dosya tutulur; açılışta tek
+// okumayla yüklenir. Değişiklikler biriktirilir ve arka planda tek seferde
+// yazılır.
+class DesktopLayoutStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DesktopLayoutStore(QObject *parent = nullptr);
+    ~DesktopLayoutStore();
+
+    // Simge alanının geometrisinden türetilen anahtar ("1920x1080+0+0")
+    static QString layoutKey(const QRect &area);
+
+    // Etkin düzeni değiştirir; önceki düzenin bekleyen yazması hemen yapılır.
+    // Anahtar değiştiyse true döner.
+    bool setLayoutKey(const QString &key);
+    QString layoutKey() const { return m_key; }
+
+    bool contains(const QString &name) const { return m_positions.contains(name); }
+    QPoint position(const QString &name) const { return m_positions.value(name); }
+
+    void setPosition(const QString &name, const QPoint &position);
+    void rename(const QString &oldName, const QString &newName);
+    void remove(const QString &name);
+
+    // Bekleyen değişiklikleri beklemeden yazar
+    void flush();
+
+private slots:
+    void save();
+
+private:
+    QString filePath(const QString &key) const;
+    QByteArray serialize() const;
+    void load();
+    void scheduleSave();
+
+    QString m_directory;
+    QString m_key;
+    QHash<QString, QPoint> m_positions;
+    QTimer *m_saveTimer;
+    QThreadPool *m_writer;
+};
+
+#endif // DESKTOPLAYOUTSTORE_H
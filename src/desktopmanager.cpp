@@ -1,22 +1,61 @@
 #include "desktopmanager.h"
-#include "desktopicon.h" // DesktopIcon sınıfını içe aktarın
+#include "desktopiconview.h"
+#include "desktoplayoutstore.h"
+#include "wallpaperloader.h"
+#include "blurservice.h"
 #include <QPainter>
 #include <QDir>
 #include <QStandardPaths>
 #include <QResizeEvent>
+#include <QPaintEvent>
+#include <QGuiApplication>
+#include <QScreen>
 #include <QDebug> // QDebug başlık dosyasını ekleyin
+#include <algorithm>
 
 DesktopManager::DesktopManager(QWidget *parent)
     : QWidget(parent)
+    , m_nextSurfaceId(1)
+    , m_wallpaperMode(WallpaperMode::Fill)
+    , m_wallpaperLoader(new WallpaperLoader(this))
+    , m_iconView(new DesktopIconView(this))
+    , m_layoutStore(new DesktopLayoutStore(this))
+    , m_sortMode(IconSortMode::Manual)
+    , m_changeNotifier(new FileChangeNotifier(this))
+    , m_iconsLoaded(false)
 {
-    // Masaüstü klasörünü izle
+    // Duvar kağıdı arka planda çözümlenir, hazır olunca buraya gelir
+    connect(m_wallpaperLoader, &WallpaperLoader::wallpaperReady,
+            this, &DesktopManager::onWallpaperReady);
+    connect(m_wallpaperLoader, &WallpaperLoader::wallpaperFailed,
+            this, &DesktopManager::onWallpaperFailed);
+    
+    // Bulanık arka plan hazır olduğunda yalnızca ilgili alanı yeniden çiz
+    connect(BlurService::instance(), &BlurService::backdropChanged,
+            this, QOverload<const QRect &>::of(&QWidget::update));
+    
+    // Ekran takılıp çıkarıldığında yalnızca değişen yüzeyler yeniden ölçeklenir
+    connect(qApp, &QGuiApplication::screenAdded, this, &DesktopManager::updateScreens);
+    connect(qApp, &QGuiApplication::screenRemoved, this, &DesktopManager::updateScreens);
+    connect(qApp, &QGuiApplication::primaryScreenChanged, this, &DesktopManager::updateScreens);
+    
+    // Masaüstü klasörünü izle; olay patlamaları tek bir değişiklik kümesine
+    // toplanır ve yenileme hızı sınırlanır
     QString desktopPath = QStandardPaths::writableLocation(QStandardPaths::DesktopLocation);
-    m_fileWatcher.addPath(desktopPath);
+    if (m_changeNotifier->addPath(desktopPath)) {
+        connect(m_changeNotifier, &FileChangeNotifier::changesReady,
+                this, &DesktopManager::applyDesktopChanges);
+    } else {
+        // inotify yoksa dizin düzeyinde izleme ve tam taramaya geri dön
+        m_fileWatcher.addPath(desktopPath);
+        connect(&m_fileWatcher, &QFileSystemWatcher::directoryChanged,
+                this, &DesktopManager::refreshDesktopIcons);
+    }
     
-    connect(&m_fileWatcher, &QFileSystemWatcher::directoryChanged,
-            this, &DesktopManager::refreshDesktopIcons);
+    connect(m_iconView, &DesktopIconView::entriesMoved, this, &DesktopManager::onIconsMoved);
     
-    loadIcons();
+    // Simgeler, pencere ilk kez ekran boyutuna getirildiğinde yüklenir
+    updateScreens();
 }
 
 DesktopManager::~DesktopManager()
@@ -27,20 +66,173 @@ void DesktopManager::setWallpaper(const QString &path)
 {
     m_wallpaperPath = path;
     
+    for (ScreenSurface &surface : m_surfaces) {
+        surface.stale = true;
+    }
+    
     if (path.isEmpty()) {
         // Eğer yol boşsa, null pixmap olarak işaretle
-        m_wallpaper = QPixmap();
-    } else {
-        // Duvar kağıdını yükle ve kontrol et
-        m_wallpaper = QPixmap(path);
-        if (m_wallpaper.isNull()) {
-            qWarning() << "Duvar kağıdı yüklenemedi:" << path;
-        } else if (size().isValid()) {
-            // Sadece geçerli bir pixmap ve boyut varsa ölçeklendir
-            m_wallpaper = m_wallpaper.scaled(size(), Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        m_wallpaperLoader->cancel();
+        for (ScreenSurface &surface : m_surfaces) {
+            surface.wallpaper = QPixmap();
+            BlurService::instance()->setSurface(surface.id, surface.geometry, QImage());
+        }
+        update();
+        return;
+    }
+    
+    // Yeni görüntü hazır olana kadar eski kare ekranda kalır
+    requestWallpaper();
+}
+
+void DesktopManager::setWallpaperMode(WallpaperMode mode)
+{
+    if (m_wallpaperMode == mode) {
+        return;
+    }
+    
+    m_wallpaperMode = mode;
+    setWallpaper(m_wallpaperPath);
+}
+
+void DesktopManager::updateScreens()
+{
+    const QRect virtualGeometry = QGuiApplication::primaryScreen()->virtualGeometry();
+    const bool spanChanged = m_spanSize != virtualGeometry.size();
+    m_spanSize = virtualGeometry.size();
+    
+    QVector<ScreenSurface> surfaces;
+    for (QScreen *screen : QGuiApplication::screens()) {
+        connect(screen, &QScreen::geometryChanged, this, &DesktopManager::updateScreens, Qt::UniqueConnection);
+        
+        ScreenSurface surface;
+        surface.id = 0;
+        surface.screen = screen;
+        surface.spanRect = screen->geometry().translated(-virtualGeometry.topLeft());
+        surface.geometry = surface.spanRect;
+        surface.dpr = screen->devicePixelRatio();
+        surface.stale = true;
+        
+        // Değişmeyen ekranlar mevcut görüntüsünü korur
+        for (const ScreenSurface &old : qAsConst(m_surfaces)) {
+            if (old.screen == screen) {
+                surface.id = old.id;
+                surface.wallpaper = old.wallpaper;
+                surface.stale = old.stale || old.geometry != surface.geometry || old.dpr != surface.dpr
+                                || (spanChanged && m_wallpaperMode == WallpaperMode::Span);
+                break;
+            }
+        }
+        
+        if (surface.id == 0) {
+            surface.id = m_nextSurfaceId++;
+        }
+        surfaces.append(surface);
+    }
+    
+    // Çıkarılan ekranların bulanık kopyaları bırakılır
+    for (const ScreenSurface &old : qAsConst(m_surfaces)) {
+        bool kept = false;
+        for (const ScreenSurface &surface : qAsConst(surfaces)) {
+            kept = kept || surface.id == old.id;
+        }
+        if (!kept) {
+            BlurService::instance()->removeSurface(old.id);
         }
     }
     
+    m_surfaces = surfaces;
+    
+    requestWallpaper();
+    
+    // Simgeler yalnızca simge alanının geometrisi değiştiğinde yeniden yerleşir;
+    // her geometrinin kendi kayıtlı düzeni vardır. Widget henüz varsayılan
+    // boyutundayken hiçbir ekrana karşılık gelmeyen düzen açılmaz, yazılmaz.
+    if (hasScreenGeometry()) {
+        const bool keyChanged = m_layoutStore->setLayoutKey(DesktopLayoutStore::layoutKey(iconArea()));
+        if (!m_iconsLoaded) {
+            m_iconsLoaded = true;
+            loadIcons();
+        } else if (keyChanged) {
+            arrangeIcons();
+        }
+    }
+    update();
+}
+
+void DesktopManager::requestWallpaper()
+{
+    if (m_wallpaperPath.isEmpty()) {
+        return;
+    }
+    
+    QVector<WallpaperTarget> targets;
+    for (ScreenSurface &surface : m_surfaces) {
+        if (!surface.stale || surface.geometry.isEmpty()) {
+            continue;
+        }
+        
+        WallpaperTarget target;
+        target.id = surface.id;
+        target.size = surface.geometry.size() * surface.dpr;
+        target.dpr = surface.dpr;
+        target.spanRect = surface.spanRect;
+        
+        // Önbellekte hazır ölçeklenmiş kayıt varsa doğrudan kullan
+        QImage cached = m_wallpaperLoader->cached(m_wallpaperPath, m_wallpaperMode, m_spanSize, target);
+        if (!cached.isNull()) {
+            applyWallpaper(surface, cached);
+            continue;
+        }
+        
+        targets.append(target);
+    }
+    
+    if (targets.isEmpty()) {
+        m_wallpaperLoader->cancel();
+        return;
+    }
+    
+    m_wallpaperLoader->load(m_wallpaperPath, m_wallpaperMode, m_spanSize, targets);
+}
+
+void DesktopManager::onWallpaperReady(const QString &path, int targetId, const QImage &image)
+{
+    if (path != m_wallpaperPath) {
+        return;
+    }
+    
+    for (ScreenSurface &surface : m_surfaces) {
+        if (surface.id == targetId) {
+            applyWallpaper(surface, image);
+            break;
+        }
+    }
+}
+
+void DesktopManager::applyWallpaper(ScreenSurface &surface, const QImage &image)
+{
+    surface.wallpaper = QPixmap::fromImage(image);
+    surface.wallpaper.setDevicePixelRatio(surface.dpr);
+    surface.stale = false;
+    
+    // Bulanık kopya yalnızca duvar kağıdı değiştiğinde bir kez üretilir
+    BlurService::instance()->setSurface(surface.id, surface.geometry, image);
+    update(surface.geometry);
+}
+
+void DesktopManager::onWallpaperFailed(const QString &path)
+{
+    if (path != m_wallpaperPath) {
+        return;
+    }
+    
+    qWarning() << "Duvar kağıdı yüklenemedi:" << path;
+    for (ScreenSurface &surface : m_surfaces) {
+        surface.wallpaper = QPixmap();
+        surface.stale = false;
+        BlurService::instance()->setSurface(surface.id, surface.geometry, QImage());
+    }
     update();
 }
 
@@ -49,29 +241,99 @@ QString DesktopManager::currentWallpaper() const
     return m_wallpaperPath;
 }
 
+QRect DesktopManager::iconArea() const
+{
+    // Simgeler birincil ekranda yerleştirilir
+    for (const ScreenSurface &surface : m_surfaces) {
+        if (surface.screen == QGuiApplication::primaryScreen()) {
+            return surface.geometry.intersected(rect());
+        }
+    }
+    return rect();
+}
+
+bool DesktopManager::hasScreenGeometry() const
+{
+    for (const ScreenSurface &surface : m_surfaces) {
+        if (surface.screen == QGuiApplication::primaryScreen()) {
+            return !surface.geometry.isEmpty() && rect().contains(surface.geometry);
+        }
+    }
+    return false;
+}
+
 void DesktopManager::refreshDesktopIcons()
 {
-    // Mevcut simgeleri temizle
-    qDeleteAll(m_icons);
-    m_icons.clear();
+    // Dizini tek geçişte tara, yalnızca değişen simgeleri güncelle
+    QString desktopPath = QStandardPaths::writableLocation(QStandardPaths::DesktopLocation);
+    reconcileIcons(DirectoryScanner::scan(desktopPath));
+}
+
+void DesktopManager::applyDesktopChanges(const FileChangeBatch &batch)
+{
+    if (batch.overflow) {
+        refreshDesktopIcons();
+        return;
+    }
     
-    // Yeniden yükle
-    loadIcons();
-    update();
+    // Mevcut durumdan yola çıkılır; yalnızca olayda adı geçen girdiler yeniden okunur
+    QHash<QString, DirectoryEntry> entries;
+    entries.reserve(m_iconRecords.size() + batch.created.size());
+    for (auto it = m_iconRecords.constBegin(); it != m_iconRecords.constEnd(); ++it) {
+        entries.insert(it.key(), it.value());
+    }
+    
+    for (const QString &name : batch.removed) {
+        entries.remove(name);
+    }
+    
+    QSet<QString> changed = batch.created;
+    changed.unite(batch.modified);
+    for (const QString &name : qAsConst(changed)) {
+        if (name.startsWith('.')) {
+            continue;
+        }
+        
+        DirectoryEntry entry;
+        if (DirectoryScanner::stat(batch.directory, name, &entry)) {
+            entries.insert(name, entry);
+        } else {
+            entries.remove(name);
+        }
+    }
+    
+    reconcileIcons(entries.values().toVector());
 }
 
 void DesktopManager::paintEvent(QPaintEvent *event)
 {
-    Q_UNUSED(event);
-    
     QPainter painter(this);
     
-    // Duvar kağıdını çiz
-    if (!m_wallpaper.isNull()) {
-        painter.drawPixmap(rect(), m_wallpaper, m_wallpaper.rect());
-    } else {
-        // Duvar kağıdı yoksa koyu arka plan kullan
-        painter.fillRect(rect(), QColor(40, 40, 40));
+    // Hiçbir ekrana düşmeyen alanlar koyu arka planla doldurulur
+    QRegion uncovered(event->rect());
+    const BlurService *blur = BlurService::instance();
+    
+    // Her ekranın duvar kağıdını kendi alanına çiz
+    for (const ScreenSurface &surface : qAsConst(m_surfaces)) {
+        if (!surface.geometry.intersects(event->rect())) {
+            continue;
+        }
+        
+        if (blur->hasBackdrop(surface.geometry)) {
+            // Önceden hesaplanmış bulanık arka plan: düz kopyalama
+            blur->paint(&painter, surface.geometry, surface.geometry);
+        } else if (!surface.wallpaper.isNull()) {
+            // Yeni ölçek gelene kadar eski kare bu alana gerilerek çizilir
+            painter.drawPixmap(surface.geometry, surface.wallpaper);
+        } else {
+            // Duvar kağıdı yoksa koyu arka plan kullan
+            painter.fillRect(surface.geometry, QColor(40, 40, 40));
+        }
+        uncovered -= surface.geometry;
+    }
+    
+    for (const QRect &rect : uncovered) {
+        painter.fillRect(rect, QColor(40, 40, 40));
     }
 }
 
@@ -79,65 +341,195 @@ void DesktopManager::resizeEvent(QResizeEvent *event)
 {
     Q_UNUSED(event);
     
-    // Duvar kağıdını yeniden boyutlandır
-    if (!m_wallpaperPath.isEmpty()) {
-        m_wallpaper = QPixmap(m_wallpaperPath).scaled(size(), Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
-    }
+    m_iconView->setGeometry(rect());
     
-    // Simgeleri yeniden düzenle
-    arrangeIcons();
+    // Ekran yüzeylerini yeni pencere alanına göre güncelle; yalnızca boyutu
+    // değişen ekranlar arka planda yeniden ölçeklenir
+    updateScreens();
 }
 
 void DesktopManager::loadIcons()
 {
-    // Önceki simgeleri temizle
-    qDeleteAll(m_icons);
-    m_icons.clear();
-    
     // Masaüstü klasörünü bul
     QString desktopPath = QStandardPaths::writableLocation(QStandardPaths::DesktopLocation);
-    QDir desktopDir(desktopPath);
-    
-    // Masaüstündeki dosya ve klasörleri ara
-    QFileInfoList entries = desktopDir.entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot);
-    
-    // Simgeleri oluştur ve yerleştir
-    int row = 0;
-    int col = 0;
-    int iconSize = 90;
-    int maxColumns = (width() - 20) / iconSize;
-    
-    for (const QFileInfo &fileInfo : entries) {
-        DesktopIcon *icon = new DesktopIcon(fileInfo, this);
-        icon->move(10 + col * iconSize, 10 + row * iconSize);
-        icon->show();
-        m_icons.append(icon);
+    
+    // İlk yüklemede mevcut durum boş; tüm girdiler yeni simge olarak eklenir
+    reconcileIcons(DirectoryScanner::scan(desktopPath));
+}
+
+void DesktopManager::reconcileIcons(QVector<DirectoryEntry> entries)
+{
+    // Yükleme öncesi değişiklikler atılır; ilk yükleme dizini baştan tarar
+    if (!m_iconsLoaded) {
+        return;
+    }
+    
+    QString desktopPath = QStandardPaths::writableLocation(QStandardPaths::DesktopLocation);
+    
+    // Yeni girdiler ada göre sırayla yerleşsin
+    std::sort(entries.begin(), entries.end(), [](const DirectoryEntry &a, const DirectoryEntry &b) {
+        return a.name.compare(b.name, Qt::CaseInsensitive) < 0;
+    });
+    
+    QHash<QString, DirectoryEntry> previous = m_iconRecords;
+    QHash<QString, DirectoryEntry> current;
+    current.reserve(entries.size());
+    QVector<DirectoryEntry> added;
+    
+    // Değişmeyen girdilere dokunulmaz; içeriği değişenler yerinde güncellenir
+    for (const DirectoryEntry &entry : qAsConst(entries)) {
+        auto it = previous.find(entry.name);
+        if (it == previous.end()) {
+            added.append(entry);
+            continue;
+        }
+        
+        if (!it.value().sameContent(entry)) {
+            m_iconView->updateEntry(entry.name, QFileInfo(desktopPath + "/" + entry.name));
+        }
+        previous.erase(it);
+        current.insert(entry.name, entry);
+    }
+    
+    // Kaybolan girdiler; aynı inode yeni bir adla göründüyse yeniden adlandırmadır
+    QHash<quint64, QString> removedByInode;
+    for (auto it = previous.constBegin(); it != previous.constEnd(); ++it) {
+        removedByInode.insert(it.value().inode, it.key());
+    }
+    
+    // Yeni simgeler boş ilk ızgara hücresine yerleşir, diğerleri yerinde kalır
+    QSet<quint64> occupied;
+    for (const QPoint &position : m_iconView->positions()) {
+        occupied.insert(slotOf(position));
+    }
+    
+    // Önce yeniden adlandırmalar ve kayıtlı konumu olanlar, sonra kalanlar boş hücrelere
+    QVector<QFileInfo> unplaced;
+    for (const DirectoryEntry &entry : qAsConst(added)) {
+        const QFileInfo fileInfo(desktopPath + "/" + entry.name);
         
-        // Sonraki sütun veya satıra geç
-        col++;
-        if (col >= maxColumns) {
-            col = 0;
-            row++;
+        const QString oldName = removedByInode.take(entry.inode);
+        if (!oldName.isEmpty()) {
+            // Yeniden adlandırma: simgenin konumu korunur
+            previous.remove(oldName);
+            m_iconView->renameEntry(oldName, fileInfo);
+            m_layoutStore->rename(oldName, entry.name);
+        } else if (m_layoutStore->contains(entry.name)) {
+            const QPoint position = m_layoutStore->position(entry.name);
+            m_iconView->addEntry(fileInfo, position);
+            occupied.insert(slotOf(position));
+        } else {
+            unplaced.append(fileInfo);
+        }
+        
+        current.insert(entry.name, entry);
+    }
+    
+    for (const QFileInfo &fileInfo : qAsConst(unplaced)) {
+        const QPoint position = takeFreeSlot(occupied);
+        m_iconView->addEntry(fileInfo, position);
+        m_layoutStore->setPosition(fileInfo.fileName(), position);
+    }
+    
+    for (auto it = previous.constBegin(); it != previous.constEnd(); ++it) {
+        m_iconView->removeEntry(it.key());
+        m_layoutStore->remove(it.key());
+    }
+    
+    m_iconRecords = current;
+    
+    // Otomatik dizmede yeni ve silinen girdiler sırayı değiştirir
+    if (m_sortMode != IconSortMode::Manual && (!added.isEmpty() || !previous.isEmpty())) {
+        arrangeIcons();
+    }
+}
+
+quint64 DesktopManager::slotOf(const QPoint &position) const
+{
+    const QRect area = iconArea();
+    const int col = (position.x() - area.x() - 10 + DesktopIconView::GridSpacing / 2) / DesktopIconView::GridSpacing;
+    const int row = (position.y() - area.y() - 10 + DesktopIconView::GridSpacing / 2) / DesktopIconView::GridSpacing;
+    return (quint64(quint32(row)) << 32) | quint32(col);
+}
+
+QPoint DesktopManager::takeFreeSlot(QSet<quint64> &occupied) const
+{
+    const QRect area = iconArea();
+    const int iconSize = 90;
+    const int maxColumns = qMax(1, (area.width() - 20) / iconSize);
+    
+    for (int index = 0; ; ++index) {
+        const int row = index / maxColumns;
+        const int col = index % maxColumns;
+        const quint64 key = (quint64(quint32(row)) << 32) | quint32(col);
+        if (!occupied.contains(key)) {
+            occupied.insert(key);
+            return QPoint(area.x() + 10 + col * iconSize, area.y() + 10 + row * iconSize);
         }
     }
 }
 
+void DesktopManager::setIconSortMode(IconSortMode mode)
+{
+    if (m_sortMode == mode) {
+        return;
+    }
+    
+    m_sortMode = mode;
+    arrangeIcons();
+}
+
+void DesktopManager::onIconsMoved(const QStringList &names)
+{
+    // Elle yerleştirme otomatik dizmeyi kapatır; diğer simgeler yerinde kalır
+    if (m_sortMode != IconSortMode::Manual) {
+        m_sortMode = IconSortMode::Manual;
+        for (const QString &name : m_iconView->names()) {
+            m_layoutStore->setPosition(name, m_iconView->position(name));
+        }
+        emit iconSortModeChanged(m_sortMode);
+        return;
+    }
+    
+    for (const QString &name : names) {
+        m_layoutStore->setPosition(name, m_iconView->position(name));
+    }
+}
+
 void DesktopManager::arrangeIcons()
 {
-    // Simgeleri grid düzeninde yerleştir
-    int row = 0;
-    int col = 0;
-    int iconSize = 90;
-    int maxColumns = (width() - 20) / iconSize;
+    const QRect area = iconArea();
+    if (area.isEmpty()) {
+        return;
+    }
     
-    for (DesktopIcon *icon : m_icons) {
-        icon->move(10 + col * iconSize, 10 + row * iconSize);
-        
-        // Sonraki sütun veya satıra geç
-        col++;
-        if (col >= maxColumns) {
-            col = 0;
-            row++;
+    if (m_sortMode != IconSortMode::Manual) {
+        // Sıralama anahtarları girdi eklenirken hesaplandı; burada yalnızca sıralanır
+        m_iconView->arrange(area, m_sortMode);
+        for (const QString &name : m_iconView->names()) {
+            m_layoutStore->setPosition(name, m_iconView->position(name));
         }
+        return;
+    }
+    
+    // Serbest yerleşim: bu geometri için kayıtlı konumlar uygulanır, kaydı
+    // olmayan simgeler boş hücrelere yerleşir
+    QSet<quint64> occupied;
+    QStringList unplaced;
+    for (const QString &name : m_iconView->names()) {
+        if (m_layoutStore->contains(name)) {
+            const QPoint position = m_layoutStore->position(name);
+            m_iconView->moveEntry(name, position);
+            occupied.insert(slotOf(position));
+        } else {
+            unplaced << name;
+        }
+    }
+    
+    unplaced.sort(Qt::CaseInsensitive);
+    for (const QString &name : qAsConst(unplaced)) {
+        const QPoint position = takeFreeSlot(occupied);
+        m_iconView->moveEntry(name, position);
+        m_layoutStore->setPosition(name, position);
     }
 }
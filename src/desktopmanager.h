@@ -5,8 +5,15 @@
 #include <QPixmap>
 #include <QVector>
 #include <QFileSystemWatcher>
+#include <QHash>
+#include <QSet>
+#include "wallpaperloader.h"
+#include "directoryscanner.h"
+#include "filechangenotifier.h"
+#include "desktopiconview.h"
 
-class DesktopIcon;
+class DesktopLayoutStore;
+class QScreen;
 
 class DesktopManager : public QWidget
 {
@@ -19,9 +26,26 @@ public:
     void setWallpaper(const QString &path);
     QString currentWallpaper() const;
 
+    void setWallpaperMode(WallpaperMode mode);
+    WallpaperMode wallpaperMode() const { return m_wallpaperMode; }
+
+    void setIconSortMode(IconSortMode mode);
+    IconSortMode iconSortMode() const { return m_sortMode; }
+
+signals:
+    // Simgeler elle taşındığında otomatik dizme kapanır
+    void iconSortModeChanged(IconSortMode mode);
+
 public slots:
     void refreshDesktopIcons();
 
+private slots:
+    void onWallpaperReady(const QString &path, int targetId, const QImage &image);
+    void onWallpaperFailed(const QString &path);
+    void applyDesktopChanges(const FileChangeBatch &batch);
+    void updateScreens();
+    void onIconsMoved(const QStringList &names);
+
 protected:
     void paintEvent(QPaintEvent *event) override;
     void resizeEvent(QResizeEvent *event) override;
@@ -29,10 +53,43 @@ protected:
 private:
     void loadIcons();
     void arrangeIcons();
+    void reconcileIcons(QVector<DirectoryEntry> entries);
+    quint64 slotOf(const QPoint &position) const;
+    QPoint takeFreeSlot(QSet<quint64> &occupied) const;
+    void requestWallpaper();
+    QRect iconArea() const;
+    // Pencere birincil ekranı kaplıyor mu (ilk boyutlanmadan önce kaplamaz)
+    bool hasScreenGeometry() const;
+
+    // Her ekran için ayrı çizim yüzeyi ve ölçeklenmiş duvar kağıdı
+    struct ScreenSurface {
+        int id;
+        QScreen *screen;
+        QRect geometry;   // Bu widget'ın koordinatlarında
+        QRect spanRect;   // Sanal masaüstündeki konum
+        qreal dpr;
+        QPixmap wallpaper;
+        bool stale;
+    };
+
+    void applyWallpaper(ScreenSurface &surface, const QImage &image);
 
-    QPixmap m_wallpaper;
+    QVector<ScreenSurface> m_surfaces;
+    QSize m_spanSize;
+    int m_nextSurfaceId;
     QString m_wallpaperPath;
-    QVector<DesktopIcon*> m_icons;
+    WallpaperMode m_wallpaperMode;
+    WallpaperLoader *m_wallpaperLoader;
+    // Tüm simgeler tek bir widget'ta çizilir
+    DesktopIconView *m_iconView;
+    // Serbest yerleşimde kullanıcının bıraktığı konumlar, ekran geometrisi başına
+    DesktopLayoutStore *m_layoutStore;
+    IconSortMode m_sortMode;
+    // Masaüstündeki her girdi için son görülen durum
+    QHash<QString, DirectoryEntry> m_iconRecords;
+    // Simgeler ilk gerçek ekran geometrisi gelince yüklenir
+    bool m_iconsLoaded;
+    FileChangeNotifier *m_changeNotifier;
     QFileSystemWatcher m_fileWatcher;
 };
 
@@ -0,0 +1,80 @@
+#include "directoryscanner.h"
+#include <QFile>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+bool statAt(int dirFd, const char *name, DirectoryEntry *entry)
+{
+#ifdef STATX_INO
+    // Yalnızca gereken alanlar istenir; çekirdek gereksiz öznitelikleri doldurmaz
+    struct statx info;
+    const unsigned int mask = STATX_TYPE | STATX_INO | STATX_MTIME;
+    if (statx(dirFd, name, 0, mask, &info) != 0
+        && statx(dirFd, name, AT_SYMLINK_NOFOLLOW, mask, &info) != 0) {
+        return false;
+    }
+    entry->inode = info.stx_ino;
+    entry->mtimeNs = qint64(info.stx_mtime.tv_sec) * 1000000000 + info.stx_mtime.tv_nsec;
+    entry->isDir = S_ISDIR(info.stx_mode);
+#else
+    struct stat info;
+    if (fstatat(dirFd, name, &info, 0) != 0
+        && fstatat(dirFd, name, &info, AT_SYMLINK_NOFOLLOW) != 0) {
+        return false;
+    }
+    entry->inode = info.st_ino;
+    entry->mtimeNs = qint64(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+    entry->isDir = S_ISDIR(info.st_mode);
+#endif
+    return true;
+}
+
+} // namespace
+
+QVector<DirectoryEntry> DirectoryScanner::scan(const QString &path)
+{
+    QVector<DirectoryEntry> entries;
+
+    DIR *dir = opendir(QFile::encodeName(path).constData());
+    if (!dir) {
+        return entries;
+    }
+
+    const int dirFd = dirfd(dir);
+    while (struct dirent *ent = readdir(dir)) {
+        // "." ve ".." dahil gizli girdiler masaüstünde gösterilmez
+        if (ent->d_name[0] == '.') {
+            continue;
+        }
+
+        DirectoryEntry entry;
+        if (!statAt(dirFd, ent->d_name, &entry)) {
+            continue;
+        }
+        entry.name = QFile::decodeName(ent->d_name);
+        entries.append(entry);
+    }
+
+    closedir(dir);
+    return entries;
+}
+
+bool DirectoryScanner::stat(const QString &directory, const QString &name, DirectoryEntry *entry)
+{
+    const int dirFd = open(QFile::encodeName(directory).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd < 0) {
+        return false;
+    }
+
+    const bool found = statAt(dirFd, QFile::encodeName(name).constData(), entry);
+    close(dirFd);
+
+    if (found) {
+        entry->name = name;
+    }
+    return found;
+}
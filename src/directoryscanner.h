@@ -0,0 +1,31 @@
+#ifndef DIRECTORYSCANNER_H
+#define DIRECTORYSCANNER_H
+
+#include <QString>
+#include <QVector>
+
+// Bir dizin girdisinin karşılaştırma için gereken özeti
+struct DirectoryEntry {
+    QString name;
+    quint64 inode;
+    qint64 mtimeNs;
+    bool isDir;
+
+    bool sameContent(const DirectoryEntry &other) const
+    {
+        return inode == other.inode && mtimeNs == other.mtimeNs && isDir == other.isDir;
+    }
+};
+
+// QDir/QFileInfo yerine tek readdir + statx geçişiyle dizin tarar
+class DirectoryScanner
+{
+public:
+    // Gizli dosyalar ("." ile başlayanlar) atlanır
+    static QVector<DirectoryEntry> scan(const QString &path);
+
+    // Tek bir girdiyi yeniden okur; dosya yoksa false döner
+    static bool stat(const QString &directory, const QString &name, DirectoryEntry *entry);
+};
+
+#endif // DIRECTORYSCANNER_H
@@ -0,0 +1,81 @@
+#include "edgetrigger.h"
+#include "xconnection.h"
+
+EdgeTrigger::EdgeTrigger(QObject *parent)
+    : QObject(parent)
+    , m_connection(nullptr)
+    , m_window(XCB_WINDOW_NONE)
+    , m_armed(false)
+{
+    XConnection *x = XConnection::instance();
+    if (!x->isValid()) {
+        return;
+    }
+
+    // EnterNotify, pencereyi oluşturan bağlantıya gelir
+    m_connection = x->connection();
+    m_window = xcb_generate_id(m_connection);
+    m_geometry = QRect(0, 0, 1, 1);
+
+    // Değerler maske bitlerinin sırasıyla verilir
+    const uint32_t values[] = { 1, XCB_EVENT_MASK_ENTER_WINDOW };
+    xcb_create_window(m_connection, 0, m_window, x->rootWindow(),
+                      int16_t(m_geometry.x()), int16_t(m_geometry.y()),
+                      uint16_t(m_geometry.width()), uint16_t(m_geometry.height()), 0,
+                      XCB_WINDOW_CLASS_INPUT_ONLY, XCB_COPY_FROM_PARENT,
+                      XCB_CW_OVERRIDE_REDIRECT | XCB_CW_EVENT_MASK, values);
+    xcb_flush(m_connection);
+
+    connect(x, &XConnection::pointerEntered, this, &EdgeTrigger::pointerEntered);
+}
+
+EdgeTrigger::~EdgeTrigger()
+{
+    if (m_window != XCB_WINDOW_NONE) {
+        xcb_destroy_window(m_connection, m_window);
+        xcb_flush(m_connection);
+    }
+}
+
+void EdgeTrigger::setGeometry(const QRect &rect)
+{
+    if (m_window == XCB_WINDOW_NONE || rect.isEmpty() || rect == m_geometry) {
+        return;
+    }
+
+    m_geometry = rect;
+    const uint32_t values[] = {
+        uint32_t(int32_t(rect.x())), uint32_t(int32_t(rect.y())),
+        uint32_t(rect.width()), uint32_t(rect.height())
+    };
+    xcb_configure_window(m_connection, m_window,
+                         XCB_CONFIG_WINDOW_X | XCB_CONFIG_WINDOW_Y
+                         | XCB_CONFIG_WINDOW_WIDTH | XCB_CONFIG_WINDOW_HEIGHT, values);
+    xcb_flush(m_connection);
+}
+
+void EdgeTrigger::setArmed(bool armed)
+{
+    if (m_window == XCB_WINDOW_NONE || armed == m_armed) {
+        return;
+    }
+
+    m_armed = armed;
+    if (armed) {
+        // Sonradan açılan pencerelerin üzerinde kalmak için her kurulumda yükseltilir
+        const uint32_t stackMode = XCB_STACK_MODE_ABOVE;
+        xcb_configure_window(m_connection, m_window, XCB_CONFIG_WINDOW_STACK_MODE, &stackMode);
+        xcb_map_window(m_connection, m_window);
+    } else {
+        xcb_unmap_window(m_connection, m_window);
+    }
+    xcb_flush(m_connection);
+}
+
+void EdgeTrigger::pointerEntered(xcb_window_t window)
+{
+    // Eşleme kaldırılırken kuyrukta kalmış olaylar yok sayılır
+    if (window == m_window && m_armed) {
+        emit triggered();
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef EDGETRIGGER_H
+#define EDGETRIGGER_H
+
+#include <QObject>
+#include <QRect>
+#include <xcb/xcb.h>
+
+// Ekran kenarında fareyi bekleyen ince, görünmez (InputOnly) pencere.
+// Pencere yöneticisinin dışında (override-redirect) en üstte durur ve
+// yalnızca EnterWindow olayını seçer; fare kenara değene dek hiçbir olay
+// ya da zamanlayıcı yoktur. Kurulu değilken pencere eşlenmez, girişleri
+// alttaki pencerelere bırakır.
+class EdgeTrigger : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit EdgeTrigger(QObject *parent = nullptr);
+    ~EdgeTrigger();
+
+    bool isValid() const { return m_window != XCB_WINDOW_NONE; }
+
+    // Kök pencere koordinatlarında (fiziksel piksel) şerit alanı
+    void setGeometry(const QRect &rect);
+    QRect geometry() const { return m_geometry; }
+
+    // Kurulu tetikleyici eşlenir ve yığının en üstüne çıkarılır
+    void setArmed(bool armed);
+    bool isArmed() const { return m_armed; }
+
+signals:
+    void triggered();
+
+private slots:
+    void pointerEntered(xcb_window_t window);
+
+private:
+    xcb_connection_t *m_connection;
+    xcb_window_t m_window;
+    QRect m_geometry;
+    bool m_armed;
+};
+
+#endif // EDGETRIGGER_H
@@ -0,0 +1,223 @@
+#include "filechangenotifier.h"
+#include <QFile>
+#include <QSocketNotifier>
+#include <QTimer>
+#include <QDebug>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+namespace {
+
+const uint32_t WatchMask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO
+                           | IN_CLOSE_WRITE | IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF;
+
+// Kaybolan dizin yeniden oluşturulana kadar deneme aralığı
+const int RewatchInterval = 1000;
+
+} // namespace
+
+FileChangeNotifier::FileChangeNotifier(QObject *parent)
+    : QObject(parent)
+    , m_fd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+    , m_notifier(nullptr)
+    , m_flushTimer(new QTimer(this))
+    , m_rewatchTimer(new QTimer(this))
+    , m_debounceInterval(150)
+    , m_maximumLatency(1000)
+    , m_minimumInterval(500)
+{
+    m_flushTimer->setSingleShot(true);
+    connect(m_flushTimer, &QTimer::timeout, this, &FileChangeNotifier::flush);
+    m_rewatchTimer->setInterval(RewatchInterval);
+    connect(m_rewatchTimer, &QTimer::timeout, this, &FileChangeNotifier::rewatchLost);
+
+    if (m_fd < 0) {
+        qWarning() << "inotify başlatılamadı:" << strerror(errno);
+        return;
+    }
+
+    m_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &FileChangeNotifier::readEvents);
+}
+
+FileChangeNotifier::~FileChangeNotifier()
+{
+    if (m_fd >= 0) {
+        close(m_fd);
+    }
+}
+
+bool FileChangeNotifier::addPath(const QString &directory)
+{
+    if (m_fd < 0) {
+        return false;
+    }
+
+    const int wd = inotify_add_watch(m_fd, QFile::encodeName(directory).constData(), WatchMask);
+    if (wd < 0) {
+        qWarning() << "Dizin izlenemiyor:" << directory << strerror(errno);
+        return false;
+    }
+
+    m_directories.insert(wd, directory);
+    return true;
+}
+
+void FileChangeNotifier::removePath(const QString &directory)
+{
+    m_lost.remove(directory);
+    if (m_lost.isEmpty()) {
+        m_rewatchTimer->stop();
+    }
+
+    const int wd = m_directories.key(directory, -1);
+    if (wd >= 0) {
+        inotify_rm_watch(m_fd, wd);
+        m_directories.remove(wd);
+        m_pending.remove(wd);
+    }
+}
+
+void FileChangeNotifier::readEvents()
+{
+    alignas(struct inotify_event) char buffer[16 * 1024];
+
+    for (;;) {
+        const ssize_t length = read(m_fd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            break;
+        }
+
+        for (ssize_t offset = 0; offset < length; ) {
+            const struct inotify_event *event = reinterpret_cast<const struct inotify_event *>(buffer + offset);
+            offset += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                // Olaylar kayboldu: izlenen tüm dizinler yeniden taranmalı
+                for (auto it = m_directories.constBegin(); it != m_directories.constEnd(); ++it) {
+                    FileChangeBatch &batch = m_pending[it.key()];
+                    batch.directory = it.value();
+                    batch.overflow = true;
+                }
+                continue;
+            }
+
+            if (!m_directories.contains(event->wd)) {
+                continue;
+            }
+
+            FileChangeBatch &batch = m_pending[event->wd];
+            batch.directory = m_directories.value(event->wd);
+
+            if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+                batch.overflow = true;
+                if (event->mask & IN_IGNORED) {
+                    // İzleme çekirdekçe kaldırıldı: yol yeniden izlenmeli
+                    watchLost(event->wd);
+                } else if (event->mask & IN_MOVE_SELF) {
+                    // İzleme taşınan dizinle gider; yol yeniden izlensin diye kaldırılır (IN_IGNORED gelir)
+                    inotify_rm_watch(m_fd, event->wd);
+                }
+                continue;
+            }
+
+            if (event->len == 0) {
+                continue;
+            }
+
+            // Ad başına son olayın türü geçerlidir; bir ad en fazla bir kümede bulunur.
+            // IN_MOVED_TO var olan bir dosyanın üzerine gelebildiğinden sonraki
+            // silme, pencere içinde oluşmuş görünse de her zaman bildirilir.
+            const QString name = QFile::decodeName(event->name);
+            if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                batch.removed.remove(name);
+                batch.modified.remove(name);
+                batch.created.insert(name);
+            } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                batch.created.remove(name);
+                batch.modified.remove(name);
+                batch.removed.insert(name);
+            } else if (event->mask & (IN_CLOSE_WRITE | IN_ATTRIB)) {
+                if (!batch.created.contains(name)) {
+                    batch.modified.insert(name);
+                }
+            }
+        }
+    }
+
+    if (!m_pending.isEmpty()) {
+        scheduleFlush();
+    }
+}
+
+void FileChangeNotifier::watchLost(int wd)
+{
+    // Bekleyen küme eski tanımlayıcıda kalır; taşma olarak yayılır
+    m_lost.insert(m_directories.take(wd));
+    rewatchLost();
+}
+
+void FileChangeNotifier::rewatchLost()
+{
+    for (auto it = m_lost.begin(); it != m_lost.end(); ) {
+        const QString directory = *it;
+        const int wd = inotify_add_watch(m_fd, QFile::encodeName(directory).constData(), WatchMask);
+        if (wd < 0) {
+            ++it;
+            continue;
+        }
+
+        // Dizin yokken yapılan değişiklikler kaçırıldı; tam tarama istenir
+        m_directories.insert(wd, directory);
+        FileChangeBatch &batch = m_pending[wd];
+        batch.directory = directory;
+        batch.overflow = true;
+        it = m_lost.erase(it);
+        scheduleFlush();
+    }
+
+    if (m_lost.isEmpty()) {
+        m_rewatchTimer->stop();
+    } else if (!m_rewatchTimer->isActive()) {
+        m_rewatchTimer->start();
+    }
+}
+
+void FileChangeNotifier::scheduleFlush()
+{
+    if (!m_firstPending.isValid()) {
+        m_firstPending.start();
+    }
+
+    // Her olayda bekleme yeniden başlar ama ilk olaydan itibaren üst sınırı aşmaz
+    qint64 delay = m_debounceInterval;
+    delay = qMin(delay, qMax<qint64>(0, m_maximumLatency - m_firstPending.elapsed()));
+
+    // Yenileme hızı sınırı: son yayından bu yana en az minimumInterval geçmeli
+    if (m_lastFlush.isValid()) {
+        delay = qMax(delay, m_minimumInterval - m_lastFlush.elapsed());
+    }
+
+    m_flushTimer->start(int(qMax<qint64>(0, delay)));
+}
+
+void FileChangeNotifier::flush()
+{
+    if (m_lastFlush.isValid() && m_lastFlush.elapsed() < m_minimumInterval) {
+        m_flushTimer->start(int(m_minimumInterval - m_lastFlush.elapsed()));
+        return;
+    }
+
+    QHash<int, FileChangeBatch> pending;
+    pending.swap(m_pending);
+    m_firstPending.invalidate();
+    m_lastFlush.start();
+
+    for (const FileChangeBatch &batch : qAsConst(pending)) {
+        if (!batch.isEmpty()) {
+            emit changesReady(batch);
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef FILECHANGENOTIFIER_H
+#define FILECHANGENOTIFIER_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QElapsedTimer>
+
+class QSocketNotifier;
+class QTimer;
+
+// Bir dizindeki değişikliklerin birleştirilmiş özeti. Her ad, bekleme
+// penceresindeki son olayına göre yalnızca bir kümede yer alır.
+struct FileChangeBatch {
+    QString directory;
+    QSet<QString> created;   // IN_CREATE, IN_MOVED_TO
+    QSet<QString> removed;   // IN_DELETE, IN_MOVED_FROM
+    QSet<QString> modified;  // IN_CLOSE_WRITE, IN_ATTRIB
+    bool overflow = false;   // Çekirdek kuyruğu taştı; tam tarama gerekir
+
+    bool isEmpty() const { return !overflow && created.isEmpty() && removed.isEmpty() && modified.isEmpty(); }
+};
+
+// QFileSystemWatcher yerine doğrudan inotify kullanır. Olay patlamalarını
+// bekleme penceresinde toplar, tek bir değişiklik kümesi olarak yayar ve
+// art arda iki yayın arasında en az belirli bir süre bırakır.
+class FileChangeNotifier : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FileChangeNotifier(QObject *parent = nullptr);
+    ~FileChangeNotifier();
+
+    bool isValid() const { return m_fd >= 0; }
+
+    bool addPath(const QString &directory);
+    void removePath(const QString &directory);
+
+    // Son olaydan sonra beklenecek süre
+    void setDebounceInterval(int msec) { m_debounceInterval = msec; }
+    // İlk olaydan itibaren en fazla bekleme; sürekli yazmada bile yayın yapılır
+    void setMaximumLatency(int msec) { m_maximumLatency = msec; }
+    // Art arda iki yayın arasındaki en kısa süre (yenileme hızı sınırı)
+    void setMinimumInterval(int msec) { m_minimumInterval = msec; }
+
+signals:
+    void changesReady(const FileChangeBatch &batch);
+
+private slots:
+    void readEvents();
+    void flush();
+    void rewatchLost();
+
+private:
+    void scheduleFlush();
+    void watchLost(int wd);
+
+    int m_fd;
+    QSocketNotifier *m_notifier;
+    QTimer *m_flushTimer;
+    QTimer *m_rewatchTimer;
+    QHash<int, QString> m_directories;
+    QHash<int, FileChangeBatch> m_pending;
+    QSet<QString> m_lost;   // Silinen/taşınan, yeniden oluşturulması beklenen dizinler
+
+    int m_debounceInterval;
+    int m_maximumLatency;
+    int m_minimumInterval;
+    QElapsedTimer m_firstPending;
+    QElapsedTimer m_lastFlush;
+};
+
+#endif // FILECHANGENOTIFIER_H
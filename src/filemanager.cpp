@@ -1,4 +1,7 @@
 #include "filemanager.h"
+#include "iconcache.h"
+#include "thumbnailservice.h"
+#include "applauncher.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QMenuBar>
@@ -8,7 +11,6 @@
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
-#include <QProcess>
 #include <QUrl>
 #include <QDesktopServices>
 #include <QClipboard>
@@ -16,6 +18,101 @@
 #include <QMimeData>
 #include <QShortcut>
 #include <QStandardPaths>
+#include <QScrollBar>
+#include <QTimer>
+#include <QDateTime>
+
+ThumbnailDelegate::ThumbnailDelegate(QFileSystemModel *model, QAbstractItemView *view)
+    : QStyledItemDelegate(view)
+    , m_model(model)
+    , m_view(view)
+    , m_cancelTimer(new QTimer(this))
+{
+    m_pixmaps.setMaxCost(500);
+    
+    connect(ThumbnailService::instance(), &ThumbnailService::thumbnailReady,
+            this, &ThumbnailDelegate::onThumbnailReady);
+    
+    // Kaydırma durduktan sonra görünmeyen öğelerin istekleri bırakılır
+    m_cancelTimer->setSingleShot(true);
+    m_cancelTimer->setInterval(150);
+    connect(m_cancelTimer, &QTimer::timeout, this, &ThumbnailDelegate::cancelHidden);
+    connect(view->verticalScrollBar(), &QScrollBar::valueChanged, m_cancelTimer, QOverload<>::of(&QTimer::start));
+    connect(view->horizontalScrollBar(), &QScrollBar::valueChanged, m_cancelTimer, QOverload<>::of(&QTimer::start));
+    connect(model, &QFileSystemModel::rootPathChanged, m_cancelTimer, QOverload<>::of(&QTimer::start));
+}
+
+QString ThumbnailDelegate::pixmapKey(const QFileInfo &fileInfo)
+{
+    return fileInfo.absoluteFilePath() + '|' + QString::number(fileInfo.lastModified().toSecsSinceEpoch());
+}
+
+void ThumbnailDelegate::initStyleOption(QStyleOptionViewItem *option, const QModelIndex &index) const
+{
+    QStyledItemDelegate::initStyleOption(option, index);
+    
+    if (index.column() != 0) {
+        return;
+    }
+    
+    const QFileInfo fileInfo = m_model->fileInfo(index);
+    if (!ThumbnailService::canThumbnail(fileInfo)) {
+        return;
+    }
+    
+    if (const QPixmap *pixmap = m_pixmaps.object(pixmapKey(fileInfo))) {
+        option->icon = QIcon(*pixmap);
+        return;
+    }
+    
+    // Yalnızca boyanan, yani görünür öğeler için istek yapılır
+    const QString path = fileInfo.absoluteFilePath();
+    if (!m_requested.contains(path)) {
+        m_requested.insert(path);
+        const QSize iconSize = m_view->iconSize() * m_view->devicePixelRatioF();
+        ThumbnailService::instance()->request(fileInfo, qMax(iconSize.width(), iconSize.height()),
+                                              ThumbnailService::Visible);
+    }
+}
+
+void ThumbnailDelegate::onThumbnailReady(const QString &path, const QImage &image)
+{
+    if (!m_requested.remove(path)) {
+        return;
+    }
+    
+    const QModelIndex index = m_model->index(path);
+    if (!index.isValid()) {
+        return;
+    }
+    
+    m_pixmaps.insert(pixmapKey(m_model->fileInfo(index)), new QPixmap(QPixmap::fromImage(image)));
+    m_view->update(index);
+}
+
+void ThumbnailDelegate::cancelHidden()
+{
+    const QRect visible = m_view->viewport()->rect();
+    
+    for (auto it = m_requested.begin(); it != m_requested.end(); ) {
+        // Başarısız olan istekler tekrar denenmesin diye kümede kalır
+        if (!ThumbnailService::instance()->isPending(*it)) {
+            ++it;
+            continue;
+        }
+        
+        const QModelIndex index = m_model->index(*it);
+        if (index.isValid() && m_view->visualRect(index).intersects(visible)) {
+            ++it;
+            continue;
+        }
+        
+        ThumbnailService::instance()->cancel(*it);
+        it = m_requested.erase(it);
+    }
+}
+
+/////////////////////////////////////////////
 
 FileManager::FileManager(QWidget *parent)
     : QMainWindow(parent)
@@ -23,7 +120,7 @@ FileManager::FileManager(QWidget *parent)
     , m_isNavigating(false)
 {
     setWindowTitle("XenoraOS Dosya Yöneticisi");
-    setWindowIcon(QIcon::fromTheme("system-file-manager"));
+    setWindowIcon(IconCache::instance()->icon("system-file-manager"));
     resize(900, 600);
     
     setupUI();
@@ -85,7 +182,12 @@ void FileManager::setupUI()
     m_fileModel->setFilter(QDir::AllEntries | QDir::NoDotAndDotDot);
     m_fileModel->setNameFilterDisables(false);
     
+    // Dosya simgeleri paylaşılan önbellekten, MIME türü başına bir kez çözülür
+    static CachedFileIconProvider iconProvider;
+    m_fileModel->setIconProvider(&iconProvider);
+    
     m_fileView->setModel(m_fileModel);
+    m_fileView->setItemDelegate(new ThumbnailDelegate(m_fileModel, m_fileView));
     m_sidebarView->setModel(m_fileModel);
     
     // Sadece klasörleri göster (yan panel için)
@@ -118,29 +220,29 @@ void FileManager::setupUI()
 
 void FileManager::setupActions()
 {
-    m_backAction = new QAction(QIcon::fromTheme("go-previous"), "Geri", this);
+    m_backAction = new QAction(IconCache::instance()->icon("go-previous"), "Geri", this);
     m_backAction->setShortcut(QKeySequence::Back);
     m_backAction->setEnabled(false);
     connect(m_backAction, &QAction::triggered, this, &FileManager::navigateBack);
     
-    m_forwardAction = new QAction(QIcon::fromTheme("go-next"), "İleri", this);
+    m_forwardAction = new QAction(IconCache::instance()->icon("go-next"), "İleri", this);
     m_forwardAction->setShortcut(QKeySequence::Forward);
     m_forwardAction->setEnabled(false);
     connect(m_forwardAction, &QAction::triggered, this, &FileManager::navigateForward);
     
-    m_upAction = new QAction(QIcon::fromTheme("go-up"), "Yukarı", this);
+    m_upAction = new QAction(IconCache::instance()->icon("go-up"), "Yukarı", this);
     m_upAction->setShortcut(QKeySequence(Qt::Key_Backspace));
     connect(m_upAction, &QAction::triggered, this, &FileManager::navigateUp);
     
-    m_homeAction = new QAction(QIcon::fromTheme("go-home"), "Ev Dizini", this);
+    m_homeAction = new QAction(IconCache::instance()->icon("go-home"), "Ev Dizini", this);
     m_homeAction->setShortcut(QKeySequence(Qt::ALT + Qt::Key_Home));
     connect(m_homeAction, &QAction::triggered, this, &FileManager::navigateHome);
     
-    m_refreshAction = new QAction(QIcon::fromTheme("view-refresh"), "Yenile", this);
+    m_refreshAction = new QAction(IconCache::instance()->icon("view-refresh"), "Yenile", this);
     m_refreshAction->setShortcut(QKeySequence::Refresh);
     connect(m_refreshAction, &QAction::triggered, this, &FileManager::refresh);
     
-    m_newFolderAction = new QAction(QIcon::fromTheme("folder-new"), "Yeni Klasör", this);
+    m_newFolderAction = new QAction(IconCache::instance()->icon("folder-new"), "Yeni Klasör", this);
     m_newFolderAction->setShortcut(QKeySequence(Qt::CTRL + Qt::SHIFT + Qt::Key_N));
     connect(m_newFolderAction, &QAction::triggered, this, &FileManager::createNewFolder);
 }
@@ -164,30 +266,30 @@ void FileManager::setupMenus()
 {
     // Dosya menüsü
     QMenu *fileMenu = menuBar()->addMenu("Dosya");
-    fileMenu->addAction(QIcon::fromTheme("document-new"), "Yeni Pencere", this, [this]() {
+    fileMenu->addAction(IconCache::instance()->icon("document-new"), "Yeni Pencere", this, [this]() {
         FileManager *fm = new FileManager();
         fm->show();
     });
     fileMenu->addSeparator();
     fileMenu->addAction(m_newFolderAction);
     fileMenu->addSeparator();
-    fileMenu->addAction(QIcon::fromTheme("window-close"), "Kapat", this, &QMainWindow::close, QKeySequence::Close);
+    fileMenu->addAction(IconCache::instance()->icon("window-close"), "Kapat", this, &QMainWindow::close, QKeySequence::Close);
     
     // Düzen menüsü
     QMenu *editMenu = menuBar()->addMenu("Düzen");
-    editMenu->addAction(QIcon::fromTheme("edit-cut"), "Kes", this, [this]() {
+    editMenu->addAction(IconCache::instance()->icon("edit-cut"), "Kes", this, [this]() {
         // Kesme işlemi kodu
     }, QKeySequence::Cut);
-    editMenu->addAction(QIcon::fromTheme("edit-copy"), "Kopyala", this, [this]() {
+    editMenu->addAction(IconCache::instance()->icon("edit-copy"), "Kopyala", this, [this]() {
         // Kopyalama işlemi kodu
     }, QKeySequence::Copy);
-    editMenu->addAction(QIcon::fromTheme("edit-paste"), "Yapıştır", this, [this]() {
+    editMenu->addAction(IconCache::instance()->icon("edit-paste"), "Yapıştır", this, [this]() {
         // Yapıştırma işlemi kodu
     }, QKeySequence::Paste);
     
     // Görünüm menüsü
     QMenu *viewMenu = menuBar()->addMenu("Görünüm");
-    viewMenu->addAction(QIcon::fromTheme("view-refresh"), "Yenile", this, &FileManager::refresh, QKeySequence::Refresh);
+    viewMenu->addAction(IconCache::instance()->icon("view-refresh"), "Yenile", this, &FileManager::refresh, QKeySequence::Refresh);
     
     QMenu *viewModeMenu = viewMenu->addMenu("Görünüm Modu");
     viewModeMenu->addAction("Simgeler", this, [this]() {
@@ -203,7 +305,7 @@ void FileManager::setupMenus()
     
     // Yardım menüsü
     QMenu *helpMenu = menuBar()->addMenu("Yardım");
-    helpMenu->addAction(QIcon::fromTheme("help-about"), "Hakkında", this, [this]() {
+    helpMenu->addAction(IconCache::instance()->icon("help-about"), "Hakkında", this, [this]() {
         QMessageBox::about(this, "XenoraOS Dosya Yöneticisi Hakkında",
                           "XenoraOS Dosya Yöneticisi\n"
                           "Sürüm 1.0\n\n"
@@ -370,11 +472,11 @@ void FileManager::handleContextMenu(const QPoint &pos)
         QFileInfo fileInfo(filePath);
         
         if (fileInfo.isDir()) {
-            menu.addAction(QIcon::fromTheme("folder-open"), "Aç", [this, index]() {
+            menu.addAction(IconCache::instance()->icon("folder-open"), "Aç", [this, index]() {
                 onFileActivated(index);
             });
         } else {
-            menu.addAction(QIcon::fromTheme("document-open"), "Aç", [this, index]() {
+            menu.addAction(IconCache::instance()->icon("document-open"), "Aç", [this, index]() {
                 onFileActivated(index);
             });
             
@@ -382,31 +484,31 @@ void FileManager::handleContextMenu(const QPoint &pos)
                 // Uygulama seçme diyaloğu
                 QString program = QInputDialog::getText(this, "İle Aç", "Uygulama:");
                 if (!program.isEmpty()) {
-                    QProcess::startDetached(program, QStringList() << filePath);
+                    AppLauncher::instance()->launchProgram(program, QStringList() << filePath);
                 }
             });
         }
         
         menu.addSeparator();
-        menu.addAction(QIcon::fromTheme("edit-cut"), "Kes");
-        menu.addAction(QIcon::fromTheme("edit-copy"), "Kopyala");
+        menu.addAction(IconCache::instance()->icon("edit-cut"), "Kes");
+        menu.addAction(IconCache::instance()->icon("edit-copy"), "Kopyala");
         menu.addSeparator();
-        menu.addAction(QIcon::fromTheme("edit-delete"), "Sil", [this, filePath]() {
+        menu.addAction(IconCache::instance()->icon("edit-delete"), "Sil", [this, filePath]() {
             if (QMessageBox::question(this, "Sil", QString("\"%1\" öğesini silmek istediğinize emin misiniz?").arg(QFileInfo(filePath).fileName())) == QMessageBox::Yes) {
                 QFile file(filePath);
                 file.remove();
             }
         });
-        menu.addAction(QIcon::fromTheme("edit-rename"), "Yeniden Adlandır", [this, index]() {
+        menu.addAction(IconCache::instance()->icon("edit-rename"), "Yeniden Adlandır", [this, index]() {
             m_fileView->edit(index);
         });
         menu.addSeparator();
-        menu.addAction(QIcon::fromTheme("document-properties"), "Özellikler");
+        menu.addAction(IconCache::instance()->icon("document-properties"), "Özellikler");
     } else {
         // Boş alana tıklandı
         menu.addAction(m_newFolderAction);
         menu.addSeparator();
-        menu.addAction(QIcon::fromTheme("edit-paste"), "Yapıştır");
+        menu.addAction(IconCache::instance()->icon("edit-paste"), "Yapıştır");
         menu.addSeparator();
         menu.addAction(m_refreshAction);
     }
@@ -11,6 +11,38 @@
 #include <QAction>
 #include <QSplitter>
 #include <QStatusBar>
+#include <QStyledItemDelegate>
+#include <QCache>
+#include <QSet>
+
+class QTimer;
+
+// Dosya listesinde görüntü dosyaları için küçük resim gösterir. Yalnızca
+// boyanan (görünür) öğeler için istek yapılır; kaydırma durunca görünür
+// alandan çıkan bekleyen istekler iptal edilir.
+class ThumbnailDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    ThumbnailDelegate(QFileSystemModel *model, QAbstractItemView *view);
+
+protected:
+    void initStyleOption(QStyleOptionViewItem *option, const QModelIndex &index) const override;
+
+private slots:
+    void onThumbnailReady(const QString &path, const QImage &image);
+    void cancelHidden();
+
+private:
+    static QString pixmapKey(const QFileInfo &fileInfo);
+
+    QFileSystemModel *m_model;
+    QAbstractItemView *m_view;
+    QTimer *m_cancelTimer;
+    QCache<QString, QPixmap> m_pixmaps;
+    mutable QSet<QString> m_requested;
+};
 
 class FileManager : public QMainWindow
 {
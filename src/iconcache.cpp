@@ -0,0 +1,173 @@
+#include "iconcache.h"
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QMimeDatabase>
+#include <QMutexLocker>
+#include <climits>
+
+namespace {
+
+const qint64 DefaultBudget = 32 * 1024 * 1024;
+const QString DirectoryKey = QStringLiteral("inode/directory");
+
+} // namespace
+
+uint qHash(const IconCache::Key &key, uint seed)
+{
+    return qHash(key.name, seed) ^ uint(key.size << 16) ^ uint(key.dprScaled << 4)
+           ^ uint(key.mode << 2) ^ uint(key.state);
+}
+
+IconCache *IconCache::instance()
+{
+    static IconCache *cache = new IconCache(QCoreApplication::instance());
+    return cache;
+}
+
+IconCache::IconCache(QObject *parent)
+    : QObject(parent)
+    , m_budget(0)
+    , m_hits(0)
+    , m_misses(0)
+{
+    setMemoryBudget(DefaultBudget);
+}
+
+IconCache::~IconCache()
+{
+}
+
+void IconCache::setMemoryBudget(qint64 bytes)
+{
+    // QCache maliyeti int olduğundan kilobayt cinsinden tutulur
+    m_budget = bytes;
+    m_pixmaps.setMaxCost(int(qMin<qint64>(bytes / 1024, INT_MAX)));
+}
+
+void IconCache::clear()
+{
+    m_pixmaps.clear();
+
+    QMutexLocker locker(&m_iconMutex);
+    m_icons.clear();
+}
+
+QIcon IconCache::icon(const QString &name)
+{
+    QMutexLocker locker(&m_iconMutex);
+
+    auto it = m_icons.constFind(name);
+    if (it != m_icons.constEnd()) {
+        return it.value();
+    }
+
+    // Tema araması pahalıdır; her ad için yalnızca bir kez yapılır.
+    // .desktop dosyalarındaki Icon anahtarı tam yol da olabilir.
+    QIcon icon = name.startsWith('/') ? QIcon(name) : QIcon::fromTheme(name);
+    m_icons.insert(name, icon);
+    return icon;
+}
+
+QString IconCache::mimeKey(const QFileInfo &fileInfo) const
+{
+    if (fileInfo.isDir()) {
+        return DirectoryKey;
+    }
+
+    // Yalnızca uzantıya bakılır; dosya içeriği okunmaz
+    QMimeDatabase mimeDatabase;
+    return mimeDatabase.mimeTypeForFile(fileInfo, QMimeDatabase::MatchExtension).name();
+}
+
+QIcon IconCache::resolveFileIcon(const QString &key, const QFileInfo &fileInfo)
+{
+    QMutexLocker locker(&m_iconMutex);
+
+    auto it = m_icons.constFind(key);
+    if (it != m_icons.constEnd()) {
+        return it.value();
+    }
+
+    QIcon icon;
+    if (key == DirectoryKey) {
+        icon = QIcon::fromTheme("folder");
+    } else {
+        QMimeDatabase mimeDatabase;
+        const QMimeType mimeType = mimeDatabase.mimeTypeForName(key);
+        if (fileInfo.suffix().toLower() == "desktop") {
+            icon = QIcon::fromTheme("application-x-executable");
+        } else if (mimeType.isValid()) {
+            // Özel simge yoksa genel türe, o da yoksa düz metin simgesine düş
+            icon = QIcon::fromTheme(mimeType.iconName(),
+                                    QIcon::fromTheme(mimeType.genericIconName(),
+                                                     QIcon::fromTheme("text-x-generic")));
+        } else {
+            icon = QIcon::fromTheme("text-x-generic");
+        }
+    }
+
+    m_icons.insert(key, icon);
+    return icon;
+}
+
+QIcon IconCache::fileIcon(const QFileInfo &fileInfo)
+{
+    return resolveFileIcon(mimeKey(fileInfo), fileInfo);
+}
+
+QPixmap IconCache::rasterize(const QString &name, const QIcon &icon, int size, qreal dpr,
+                             QIcon::Mode mode, QIcon::State state)
+{
+    const Key key { name, size, qRound(dpr * 100), int(mode), int(state) };
+
+    if (QPixmap *cached = m_pixmaps.object(key)) {
+        ++m_hits;
+        return *cached;
+    }
+    ++m_misses;
+
+    QPixmap pixmap = icon.pixmap(QSize(size, size) * dpr, mode, state);
+    pixmap.setDevicePixelRatio(dpr);
+
+    const qint64 bytes = qint64(pixmap.width()) * pixmap.height() * qMax(1, pixmap.depth() / 8);
+    m_pixmaps.insert(key, new QPixmap(pixmap), int(qMax<qint64>(1, bytes / 1024)));
+    return pixmap;
+}
+
+QPixmap IconCache::pixmap(const QString &name, int size, qreal dpr, QIcon::Mode mode, QIcon::State state)
+{
+    return rasterize(name, icon(name), size, dpr, mode, state);
+}
+
+QPixmap IconCache::filePixmap(const QFileInfo &fileInfo, int size, qreal dpr, QIcon::Mode mode, QIcon::State state)
+{
+    // Aynı türdeki binlerce dosya tek bir rasterleştirilmiş kaydı paylaşır
+    const QString key = mimeKey(fileInfo);
+    return rasterize(key, resolveFileIcon(key, fileInfo), size, dpr, mode, state);
+}
+
+QIcon CachedFileIconProvider::icon(IconType type) const
+{
+    switch (type) {
+    case Folder:
+        return IconCache::instance()->icon("folder");
+    case Drive:
+        return IconCache::instance()->icon("drive-harddisk");
+    case Computer:
+        return IconCache::instance()->icon("computer");
+    case Desktop:
+        return IconCache::instance()->icon("user-desktop");
+    case Trashcan:
+        return IconCache::instance()->icon("user-trash");
+    case Network:
+        return IconCache::instance()->icon("network-workgroup");
+    default:
+        return IconCache::instance()->icon("text-x-generic");
+    }
+}
+
+QIcon CachedFileIconProvider::icon(const QFileInfo &info) const
+{
+    // QFileSystemModel bunu kendi arka plan iş parçacığından çağırır
+    return IconCache::instance()->fileIcon(info);
+}
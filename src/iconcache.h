@@ -0,0 +1,87 @@
+#ifndef ICONCACHE_H
+#define ICONCACHE_H
+
+#include <QObject>
+#include <QCache>
+#include <QFileIconProvider>
+#include <QHash>
+#include <QIcon>
+#include <QMutex>
+#include <QPixmap>
+
+class QFileInfo;
+
+// Süreç genelinde paylaşılan simge önbelleği. Tema simgeleri ad veya MIME
+// türüne göre bir kez çözülür, piksel haritaları (anahtar, boyut, DPR, durum)
+// başına bir kez rasterleştirilir ve bellek bütçesini aşınca en eski
+// kullanılan kayıt atılır. Masaüstü, dosya yöneticisi, başlatıcı ve görev
+// çubuğu simgelerini buradan alır.
+class IconCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    static IconCache *instance();
+    ~IconCache();
+
+    // Tema simgesi; aynı ad için hep aynı QIcon örneği döner (iş parçacığı güvenli)
+    QIcon icon(const QString &name);
+    // Dosyanın MIME türüne göre simgesi (iş parçacığı güvenli)
+    QIcon fileIcon(const QFileInfo &fileInfo);
+
+    // Rasterleştirilmiş piksel haritaları; yalnızca GUI iş parçacığından çağrılmalı
+    QPixmap pixmap(const QString &name, int size, qreal dpr,
+                   QIcon::Mode mode = QIcon::Normal, QIcon::State state = QIcon::Off);
+    QPixmap filePixmap(const QFileInfo &fileInfo, int size, qreal dpr,
+                       QIcon::Mode mode = QIcon::Normal, QIcon::State state = QIcon::Off);
+
+    // Piksel haritaları için bellek bütçesi (bayt)
+    void setMemoryBudget(qint64 bytes);
+    qint64 memoryBudget() const { return m_budget; }
+    qint64 memoryUsage() const { return qint64(m_pixmaps.totalCost()) * 1024; }
+
+    quint64 hits() const { return m_hits; }
+    quint64 misses() const { return m_misses; }
+
+    void clear();
+
+private:
+    explicit IconCache(QObject *parent = nullptr);
+
+    struct Key {
+        QString name;
+        int size;
+        int dprScaled; // DPR * 100, kayan nokta karşılaştırmasından kaçınmak için
+        int mode;
+        int state;
+
+        bool operator==(const Key &other) const
+        {
+            return size == other.size && dprScaled == other.dprScaled && mode == other.mode
+                   && state == other.state && name == other.name;
+        }
+    };
+    friend uint qHash(const Key &key, uint seed);
+
+    QString mimeKey(const QFileInfo &fileInfo) const;
+    QIcon resolveFileIcon(const QString &key, const QFileInfo &fileInfo);
+    QPixmap rasterize(const QString &name, const QIcon &icon, int size, qreal dpr,
+                      QIcon::Mode mode, QIcon::State state);
+
+    QMutex m_iconMutex;
+    QHash<QString, QIcon> m_icons;
+    QCache<Key, QPixmap> m_pixmaps;
+    qint64 m_budget;
+    quint64 m_hits;
+    quint64 m_misses;
+};
+
+// QFileSystemModel gibi QFileIconProvider bekleyen sınıflar için önbellek köprüsü
+class CachedFileIconProvider : public QFileIconProvider
+{
+public:
+    QIcon icon(IconType type) const override;
+    QIcon icon(const QFileInfo &info) const override;
+};
+
+#endif // ICONCACHE_H
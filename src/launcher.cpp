@@ -1,17 +1,24 @@
 #include "launcher.h"
+#include "iconcache.h"
+#include "appcatalog.h"
+#include "applauncher.h"
+#include "appprefetcher.h"
+#include "usagestore.h"
 #include <QHBoxLayout>
-#include <QProcess>
 #include <QToolTip>
 #include <QMenu>
 #include <QAction>
 #include <QFileInfo>
 #include <QStandardPaths>
 #include <QDir>
+#include <algorithm>
 
-AppButton::AppButton(const QString &appName, const QString &command, const QIcon &icon, QWidget *parent)
+AppButton::AppButton(const QString &appName, const QString &command, const QIcon &icon,
+                     const QString &desktopId, QWidget *parent)
     : QPushButton(parent)
     , m_appName(appName)
     , m_command(command)
+    , m_desktopId(desktopId)
 {
     setIcon(icon);
     setIconSize(QSize(32, 32));
@@ -26,10 +33,10 @@ AppButton::AppButton(const QString &appName, const QString &command, const QIcon
     setContextMenuPolicy(Qt::CustomContextMenu);
     connect(this, &AppButton::customContextMenuRequested, [this](const QPoint &pos) {
         QMenu menu;
-        menu.addAction(QIcon::fromTheme("dialog-information"), "Bilgi: " + m_appName)->setEnabled(false);
+        menu.addAction(IconCache::instance()->icon("dialog-information"), "Bilgi: " + m_appName)->setEnabled(false);
         menu.addSeparator();
         
-        QAction *removeAction = menu.addAction(QIcon::fromTheme("list-remove"), "Favorilerden Kaldır");
+        QAction *removeAction = menu.addAction(IconCache::instance()->icon("list-remove"), "Favorilerden Kaldır");
         connect(removeAction, &QAction::triggered, [this]() {
             emit customContextMenuRequested(QPoint(-1, -1)); // Özel sinyal
         });
@@ -40,8 +47,13 @@ AppButton::AppButton(const QString &appName, const QString &command, const QIcon
 
 void AppButton::launchApp()
 {
-    // Yöntem güncellendi: QStringList kullan
-    QProcess::startDetached(m_command, QStringList());
+    // Katalogdaki girdi başlatma bildirimini ve çalışma dizinini de taşır
+    const AppEntry entry = m_desktopId.isEmpty() ? AppEntry() : AppCatalog::instance()->entry(m_desktopId);
+    if (entry.isValid()) {
+        AppLauncher::instance()->launch(entry);
+    } else {
+        AppLauncher::instance()->launchCommand(m_command, m_appName);
+    }
 }
 
 /////////////////////////////////////////////
@@ -49,6 +61,9 @@ void AppButton::launchApp()
 Launcher::Launcher(QWidget *parent)
     : QWidget(parent)
     , m_settings("XenoraOS", "launcher")
+    , m_prefetcher(new AppPrefetcher(this))
+    , m_orderDirty(false)
+    , m_loading(false)
 {
     QHBoxLayout *layout = new QHBoxLayout(this);
     layout->setContentsMargins(2, 2, 2, 2);
@@ -58,6 +73,14 @@ Launcher::Launcher(QWidget *parent)
     
     // Varsayılan favori uygulamaları yükle
     loadFavoriteApps();
+    
+    // Tıklanan düğme imlecin altından kaymasın diye sıralama ayrılınca yapılır
+    connect(UsageStore::instance(), &UsageStore::usageChanged, this, [this]() {
+        m_orderDirty = true;
+        if (!underMouse() && sortByUsage()) {
+            saveFavoriteApps();
+        }
+    });
 }
 
 Launcher::~Launcher()
@@ -65,7 +88,8 @@ Launcher::~Launcher()
     saveFavoriteApps();
 }
 
-void Launcher::addApplication(const QString &appName, const QString &command, const QIcon &icon)
+void Launcher::addApplication(const QString &appName, const QString &command, const QIcon &icon,
+                              const QString &desktopId)
 {
     // Uygulama zaten varsa ekleme
     for (AppButton *btn : m_appButtons) {
@@ -74,7 +98,7 @@ void Launcher::addApplication(const QString &appName, const QString &command, co
         }
     }
     
-    AppButton *appButton = new AppButton(appName, command, icon, this);
+    AppButton *appButton = new AppButton(appName, command, icon, desktopId, this);
     layout()->addWidget(appButton);
     m_appButtons.append(appButton);
     
@@ -85,7 +109,7 @@ void Launcher::addApplication(const QString &appName, const QString &command, co
         }
     });
     
-    saveFavoriteApps();
+    favoritesChanged();
 }
 
 void Launcher::removeApplication(const QString &appName)
@@ -103,37 +127,148 @@ void Launcher::removeApplication(const QString &appName)
     saveFavoriteApps();
 }
 
+bool Launcher::addDesktopApplication(const QString &desktopId)
+{
+    const AppEntry entry = AppCatalog::instance()->entry(desktopId);
+    if (!entry.isValid()) {
+        return false;
+    }
+    
+    addApplication(entry.name, AppCatalog::plainCommand(entry.exec),
+                   IconCache::instance()->icon(entry.icon), entry.id);
+    return true;
+}
+
+void Launcher::leaveEvent(QEvent *event)
+{
+    if (m_orderDirty && sortByUsage()) {
+        saveFavoriteApps();
+    }
+    QWidget::leaveEvent(event);
+}
+
+bool Launcher::sortByUsage()
+{
+    m_orderDirty = false;
+    
+    // Puanlar UsageStore'da hazırdır; yalnızca birkaç favori sıralanır
+    UsageStore *usage = UsageStore::instance();
+    QList<AppButton*> sorted = m_appButtons;
+    std::stable_sort(sorted.begin(), sorted.end(), [usage](AppButton *a, AppButton *b) {
+        return usage->score(a->usageKey()) > usage->score(b->usageKey());
+    });
+    if (sorted == m_appButtons) {
+        return false;
+    }
+    
+    QHBoxLayout *box = static_cast<QHBoxLayout*>(layout());
+    for (int i = 0; i < sorted.size(); ++i) {
+        box->removeWidget(sorted.at(i));
+        box->insertWidget(i, sorted.at(i));
+    }
+    m_appButtons = sorted;
+    return true;
+}
+
+void Launcher::favoritesChanged()
+{
+    if (m_loading) {
+        return;
+    }
+    
+    sortByUsage();
+    prefetchFavorites();
+    saveFavoriteApps();
+}
+
+void Launcher::prefetchFavorites()
+{
+    // Yalnızca yeni komutlar kuyruğa girer; ısıtma kabuk boşta kalınca başlar
+    QStringList commands;
+    for (AppButton *btn : m_appButtons) {
+        commands.append(btn->command());
+    }
+    m_prefetcher->prefetch(commands);
+}
+
 void Launcher::loadFavoriteApps()
 {
-    // Favori uygulamaları ayarlardan yükle
+    struct Favorite {
+        QString name;
+        QString command;
+        QString iconName;
+        QString desktopId;
+    };
+    
+    // Favori uygulamaları ayarlardan oku; ekleme kaydettiği için okuma bitince yapılır
+    QList<Favorite> favorites;
     int size = m_settings.beginReadArray("favoriteApps");
+    for (int i = 0; i < size; ++i) {
+        m_settings.setArrayIndex(i);
+        favorites.append({ m_settings.value("name").toString(),
+                           m_settings.value("command").toString(),
+                           m_settings.value("icon").toString(),
+                           m_settings.value("desktopId").toString() });
+    }
+    m_settings.endArray();
     
     // Eğer daha önce kaydedilmiş uygulama yoksa, varsayılanları ekle
-    if (size == 0) {
+    if (favorites.isEmpty()) {
+        AppCatalog *catalog = AppCatalog::instance();
+        if (catalog->isReady()) {
+            addDefaultFavorites();
+        } else {
+            // İlk açılışta katalog arka planda taranıyor
+            m_catalogReady = connect(catalog, &AppCatalog::catalogChanged, this, [this]() {
+                disconnect(m_catalogReady);
+                if (m_appButtons.isEmpty()) {
+                    addDefaultFavorites();
+                }
+            });
+        }
+        return;
+    }
+    
+    m_loading = true;
+    for (const Favorite &favorite : favorites) {
+        // Katalogdaki uygulamalar güncel ad ve komutla eklenir
+        if (!favorite.desktopId.isEmpty() && addDesktopApplication(favorite.desktopId)) {
+            continue;
+        }
+        addApplication(favorite.name, favorite.command,
+                       IconCache::instance()->icon(favorite.iconName), favorite.desktopId);
+    }
+    m_loading = false;
+    favoritesChanged();
+}
+
+void Launcher::addDefaultFavorites()
+{
+    // Her rol için bilinen uygulamalardan kurulu olan ilki
+    const QList<QStringList> candidates = {
         // Dosya Yöneticisi
-        addApplication("Dosya Yöneticisi", "nautilus", QIcon::fromTheme("system-file-manager"));
-        
+        { "org.gnome.Nautilus.desktop", "nautilus.desktop", "org.kde.dolphin.desktop",
+          "thunar.desktop", "pcmanfm.desktop", "nemo.desktop" },
         // Terminal
-        addApplication("Terminal", "gnome-terminal", QIcon::fromTheme("utilities-terminal"));
-        
+        { "org.gnome.Terminal.desktop", "org.gnome.Console.desktop", "org.kde.konsole.desktop",
+          "xfce4-terminal.desktop", "xterm.desktop" },
         // Web Tarayıcı
-        addApplication("Web Tarayıcı", "firefox", QIcon::fromTheme("web-browser"));
-        
+        { "firefox.desktop", "firefox-esr.desktop", "org.mozilla.firefox.desktop",
+          "chromium.desktop", "google-chrome.desktop" },
         // Metin Düzenleyici
-        addApplication("Metin Düzenleyici", "gedit", QIcon::fromTheme("accessories-text-editor"));
-    } else {
-        for (int i = 0; i < size; ++i) {
-            m_settings.setArrayIndex(i);
-            QString appName = m_settings.value("name").toString();
-            QString command = m_settings.value("command").toString();
-            QString iconName = m_settings.value("icon").toString();
-            
-            QIcon icon = QIcon::fromTheme(iconName);
-            addApplication(appName, command, icon);
+        { "org.gnome.TextEditor.desktop", "org.gnome.gedit.desktop", "org.kde.kate.desktop",
+          "mousepad.desktop", "org.xfce.mousepad.desktop" }
+    };
+    
+    m_loading = true;
+    for (const QStringList &ids : candidates) {
+        const AppEntry entry = AppCatalog::instance()->firstInstalled(ids);
+        if (entry.isValid()) {
+            addDesktopApplication(entry.id);
         }
     }
-    
-    m_settings.endArray();
+    m_loading = false;
+    favoritesChanged();
 }
 
 void Launcher::saveFavoriteApps()
@@ -146,6 +281,7 @@ void Launcher::saveFavoriteApps()
         m_settings.setValue("name", btn->appName());
         m_settings.setValue("command", btn->command());
         m_settings.setValue("icon", btn->icon().name());
+        m_settings.setValue("desktopId", btn->desktopId());
     }
     
     m_settings.endArray();
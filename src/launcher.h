@@ -6,15 +6,22 @@
 #include <QPushButton>
 #include <QSettings>
 
+class AppPrefetcher;
+
 class AppButton : public QPushButton
 {
     Q_OBJECT
     
 public:
-    AppButton(const QString &appName, const QString &command, const QIcon &icon, QWidget *parent = nullptr);
+    AppButton(const QString &appName, const QString &command, const QIcon &icon,
+              const QString &desktopId = QString(), QWidget *parent = nullptr);
     
     QString appName() const { return m_appName; }
     QString command() const { return m_command; }
+    // Uygulama kataloğundaki .desktop kimliği; elle eklenenlerde boş
+    QString desktopId() const { return m_desktopId; }
+    // UsageStore anahtarı: .desktop kimliği, yoksa komut
+    QString usageKey() const { return m_desktopId.isEmpty() ? m_command : m_desktopId; }
     
 private slots:
     void launchApp();
@@ -22,6 +29,7 @@ private slots:
 private:
     QString m_appName;
     QString m_command;
+    QString m_desktopId;
 };
 
 class Launcher : public QWidget
@@ -33,15 +41,34 @@ public:
     ~Launcher();
     
 public slots:
-    void addApplication(const QString &appName, const QString &command, const QIcon &icon);
+    void addApplication(const QString &appName, const QString &command, const QIcon &icon,
+                        const QString &desktopId = QString());
+    // Katalogdaki bir uygulamayı .desktop kimliğiyle ekler
+    bool addDesktopApplication(const QString &desktopId);
     void removeApplication(const QString &appName);
     
+protected:
+    void leaveEvent(QEvent *event) override;
+    
 private:
     void loadFavoriteApps();
     void saveFavoriteApps();
+    // İlk açılışta kurulu uygulamalardan varsayılan favoriler seçilir
+    void addDefaultFavorites();
+    // Düğmeleri sıklık × yakınlık puanına göre dizer; eşitlerde kayıtlı sıra korunur.
+    // Sıra değiştiyse true döner (kaydetmek çağırana kalır)
+    bool sortByUsage();
+    // Favorilerin programları ve kütüphaneleri boşta önbelleğe alınır
+    void prefetchFavorites();
+    // Ekleme sonrası sıralama, ısıtma ve kayıt; toplu yüklemede sonda bir kez
+    void favoritesChanged();
     
     QList<AppButton*> m_appButtons;
     QSettings m_settings;
+    AppPrefetcher *m_prefetcher;
+    bool m_orderDirty;  // Fare üzerindeyken gelen sıralama, ayrılınca uygulanır
+    bool m_loading;     // Favoriler toplu ekleniyor; her eklemede kaydedilmez
+    QMetaObject::Connection m_catalogReady;  // İlk taramanın bitişi bekleniyor
 };
 
 #endif // LAUNCHER_H
@@ -23,7 +23,9 @@ int main(int argc, char *argv[])
     
     // Ana pencereyi oluştur ve başlat
     MainWindow mainWindow;
-    mainWindow.showFullScreen();
+    // Tam ekran durumu pencereyi tek monitöre kısıtlar; masaüstü penceresi
+    // kendi geometrisiyle tüm ekranları kaplar
+    mainWindow.show();
     
     return app.exec();
 }
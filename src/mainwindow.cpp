@@ -10,7 +10,7 @@
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QProcess>
-#include <QGraphicsBlurEffect>
+#include "blurservice.h"
 #include <QPropertyAnimation>
 #include <QGraphicsOpacityEffect>
 #include <QParallelAnimationGroup>
@@ -24,10 +24,16 @@ MainWindow::MainWindow(QWidget *parent)
     setAttribute(Qt::WA_X11NetWmWindowTypeDesktop);
     setAttribute(Qt::WA_TranslucentBackground);
     
-    // Ekran boyutunu al
-    QRect screenGeometry = QGuiApplication::primaryScreen()->geometry();
+    // Tüm ekranları kapsayan sanal masaüstü alanını al
+    QRect screenGeometry = QGuiApplication::primaryScreen()->virtualGeometry();
     setGeometry(screenGeometry);
     
+    // Ekran eklenip çıkarıldığında sanal masaüstüne göre yeniden boyutlan
+    connect(qApp, &QGuiApplication::screenAdded, this, &MainWindow::updateScreenGeometry);
+    connect(qApp, &QGuiApplication::screenRemoved, this, &MainWindow::updateScreenGeometry);
+    connect(qApp, &QGuiApplication::primaryScreenChanged, this, &MainWindow::updateScreenGeometry);
+    connectScreens();
+    
     // Tema verilerini yükle
     loadThemeData();
     
@@ -56,18 +62,80 @@ void MainWindow::createDesktop()
     m_desktopManager->setContextMenuPolicy(Qt::CustomContextMenu);
     connect(m_desktopManager, &DesktopManager::customContextMenuRequested,
             this, &MainWindow::handleDesktopMenu);
+    
+    // Simgeler elle taşınıp otomatik dizme kapandığında ayar da güncellenir
+    connect(m_desktopManager, &DesktopManager::iconSortModeChanged, [this](IconSortMode mode) {
+        m_settings.setValue("iconSortMode", iconSortModeToString(mode));
+    });
 }
 
 void MainWindow::createPanel()
 {
+    // Panel kendini birincil ekranın kenarına yerleştirir
     m_panel = new Panel(this);
-    m_panel->setGeometry(0, height() - 40, width(), 40);
+}
+
+void MainWindow::updateScreenGeometry()
+{
+    connectScreens();
+    setGeometry(QGuiApplication::primaryScreen()->virtualGeometry());
+    m_panel->updatePanelGeometry();
+}
+
+void MainWindow::connectScreens()
+{
+    // Sanal masaüstü herhangi bir ekranın boyutu ya da konumu değişince de değişir;
+    // sonradan takılan ekranlar da dinlenir
+    for (QScreen *screen : QGuiApplication::screens()) {
+        connect(screen, &QScreen::virtualGeometryChanged, this, &MainWindow::updateScreenGeometry,
+                Qt::UniqueConnection);
+    }
 }
 
 void MainWindow::handleDesktopMenu(const QPoint &pos)
 {
     QMenu menu;
     QAction *wallpaperAction = menu.addAction("Duvar Kağıdını Değiştir");
+    
+    // Duvar kağıdı yerleşim modu
+    QMenu *modeMenu = menu.addMenu("Duvar Kağıdı Modu");
+    const QList<QPair<QString, WallpaperMode>> modes = {
+        { "Doldur", WallpaperMode::Fill },
+        { "Sığdır", WallpaperMode::Fit },
+        { "Ortala", WallpaperMode::Center },
+        { "Ekranlara Yay", WallpaperMode::Span },
+        { "Ger", WallpaperMode::Stretch }
+    };
+    for (const auto &mode : modes) {
+        QAction *modeAction = modeMenu->addAction(mode.first);
+        modeAction->setCheckable(true);
+        modeAction->setChecked(m_desktopManager->wallpaperMode() == mode.second);
+        const WallpaperMode value = mode.second;
+        connect(modeAction, &QAction::triggered, [this, value]() {
+            m_desktopManager->setWallpaperMode(value);
+            m_settings.setValue("wallpaperMode", wallpaperModeToString(value));
+        });
+    }
+    
+    // Simge yerleşimi: serbest ya da bir ölçüte göre otomatik dizme
+    QMenu *sortMenu = menu.addMenu("Simgeleri Düzenle");
+    const QList<QPair<QString, IconSortMode>> sortModes = {
+        { "Serbest Yerleşim", IconSortMode::Manual },
+        { "Ada Göre", IconSortMode::Name },
+        { "Türe Göre", IconSortMode::Type },
+        { "Tarihe Göre", IconSortMode::Date }
+    };
+    for (const auto &sortMode : sortModes) {
+        QAction *sortAction = sortMenu->addAction(sortMode.first);
+        sortAction->setCheckable(true);
+        sortAction->setChecked(m_desktopManager->iconSortMode() == sortMode.second);
+        const IconSortMode value = sortMode.second;
+        connect(sortAction, &QAction::triggered, [this, value]() {
+            m_desktopManager->setIconSortMode(value);
+            m_settings.setValue("iconSortMode", iconSortModeToString(value));
+        });
+    }
+    
     QAction *settingsAction = menu.addAction("Ayarlar");
     menu.addSeparator();
     QAction *logoutAction = menu.addAction("Oturumu Kapat");
@@ -108,6 +176,8 @@ void MainWindow::logout()
 void MainWindow::loadSettings()
 {
     QString wallpaper = m_settings.value("wallpaper", ":/resources/default-wallpaper.jpg").toString();
+    m_desktopManager->setWallpaperMode(wallpaperModeFromString(m_settings.value("wallpaperMode", "fill").toString()));
+    m_desktopManager->setIconSortMode(iconSortModeFromString(m_settings.value("iconSortMode", "manual").toString()));
     
     // Duvar kağıdı kontrolü ekle
     QFileInfo fileInfo(wallpaper);
@@ -175,18 +245,12 @@ void MainWindow::loadThemeByName(const QString &themeName)
 
 void MainWindow::applyVisualEffects()
 {
-    // Masaüstüne bulanıklık efekti ekle
-    QGraphicsBlurEffect *blurEffect = new QGraphicsBlurEffect(this);
-    blurEffect->setBlurRadius(m_themeData.blurRadius);
-    blurEffect->setBlurHints(QGraphicsBlurEffect::QualityHint);
-    m_desktopManager->setGraphicsEffect(blurEffect);
+    // Masaüstü bulanıklığı: her boyamada değil, yalnızca duvar kağıdı veya
+    // tema değiştiğinde hesaplanır
+    BlurService::instance()->setRadius(m_themeData.blurRadius);
     
-    // Panel için gölge ve parlaklık efektleri
-    QGraphicsDropShadowEffect *shadowEffect = new QGraphicsDropShadowEffect(this);
-    shadowEffect->setBlurRadius(15);
-    shadowEffect->setColor(m_themeData.glowColor);
-    shadowEffect->setOffset(0, 0);
-    m_panel->setGraphicsEffect(shadowEffect);
+    // Panel parıltısı: gölge dilimleri yalnızca renk değiştiğinde yeniden üretilir
+    m_panel->setShadow(m_themeData.glowColor, 15);
     
     // Başlangıç animasyonu ekle
     QGraphicsOpacityEffect *opacityEffect = new QGraphicsOpacityEffect(this);
@@ -198,6 +262,11 @@ void MainWindow::applyVisualEffects()
     animation->setStartValue(0.0);
     animation->setEndValue(1.0);
     animation->setEasingCurve(QEasingCurve::OutCubic);
+    
+    // Animasyon bitince efekti kaldır; aksi halde her boyama ekran dışı tampona yapılır
+    connect(animation, &QPropertyAnimation::finished, this, [this]() {
+        centralWidget()->setGraphicsEffect(nullptr);
+    }, Qt::QueuedConnection);
     animation->start(QPropertyAnimation::DeleteWhenStopped);
 }
 
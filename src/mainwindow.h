@@ -36,10 +36,12 @@ private slots:
     void openSettings();
     void logout();
     void showThemeSelector();
+    void updateScreenGeometry();
 
 private:
     void createDesktop();
     void createPanel();
+    void connectScreens();
     void loadSettings();
     void saveSettings();
     void loadThemeData();
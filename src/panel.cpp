@@ -1,19 +1,29 @@
 #include "panel.h"
 #include <QPainter>
 #include <QHBoxLayout>
-#include <QVBoxLayout>
 #include <QAction>
 #include <QApplication>
 #include <QProcess> // QProcess sınıfını içe aktarın
 #include <QScreen>
 #include <QPropertyAnimation>
 #include <QMouseEvent>
-#include <QGraphicsDropShadowEffect>
+#include <QKeyEvent>
+#include <QPaintEvent>
+#include <QPainterPath>
+#include "blurservice.h"
+#include "iconcache.h"
+#include "appcatalog.h"
+#include "applauncher.h"
+#include "usagestore.h"
+#include "edgetrigger.h"
+#include "panelshadow.h"
 
 Panel::Panel(QWidget *parent)
     : QWidget(parent)
     , m_position(Qt::BottomEdge)
     , m_autoHide(false)
+    , m_hidden(false)
+    , m_frequentDirty(true)
     , m_panelSize(48)
     , m_hiddenSize(5)
 {
@@ -21,21 +31,34 @@ Panel::Panel(QWidget *parent)
     setAttribute(Qt::WA_TranslucentBackground);
     setMouseTracking(true);
     
-    // Gölge efekti ekle
-    QGraphicsDropShadowEffect* shadowEffect = new QGraphicsDropShadowEffect(this);
-    shadowEffect->setBlurRadius(20);
-    shadowEffect->setColor(QColor(0, 0, 0, 160));
-    shadowEffect->setOffset(0, 0);
-    setGraphicsEffect(shadowEffect);
+    // Gölge ayrı bir kardeş widget'ta önceden üretilmiş dilimlerle çizilir;
+    // panelin içi değiştiğinde gölge yeniden boyanmaz
+    m_shadow = parentWidget() ? new PanelShadow(this, 10) : nullptr;
     
-    // Panel otomatik gizleme işlemi için zamanlayıcı
+    // Otomatik gizleme olay güdümlüdür: fare ayrılınca tek seferlik gecikme,
+    // gizliyken ekran kenarındaki tetikleyici; imleç konumu yoklanmaz
     m_hideTimer = new QTimer(this);
+    m_hideTimer->setSingleShot(true);
     m_hideTimer->setInterval(500);
-    connect(m_hideTimer, &QTimer::timeout, this, &Panel::checkMousePosition);
+    connect(m_hideTimer, &QTimer::timeout, this, &Panel::hidePanel);
+    
+    m_animation = new QPropertyAnimation(this, "geometry", this);
+    m_animation->setDuration(250);
+    m_animation->setEasingCurve(QEasingCurve::OutCubic);
+    
+    m_edgeTrigger = new EdgeTrigger(this);
+    connect(m_edgeTrigger, &EdgeTrigger::triggered, this, &Panel::revealPanel);
     
     setupUI();
     setupStartMenu();
     updatePanelGeometry();
+    
+    // Yarı saydam arka plan, önceden bulanıklaştırılmış duvar kağıdını örnekler
+    connect(BlurService::instance(), &BlurService::backdropChanged, this, [this](const QRect &desktopRect) {
+        if (desktopRect.intersects(QRect(mapTo(window(), QPoint(0, 0)), size()))) {
+            update();
+        }
+    });
 }
 
 Panel::~Panel()
@@ -79,6 +102,7 @@ void Panel::setupStartMenu()
 {
     m_startMenu = new QMenu(this);
     m_startMenu->setAttribute(Qt::WA_TranslucentBackground);
+    BlurService::instance()->installBackdrop(m_startMenu, 10);
     m_startMenu->setStyleSheet(
         "QMenu { background-color: rgba(20, 30, 60, 0.95); border-radius: 10px; border: 1px solid rgba(120, 80, 255, 0.5); }"
         "QMenu::item { padding: 8px 25px 8px 35px; color: #e0e5ff; }"
@@ -86,21 +110,35 @@ void Panel::setupStartMenu()
         "QMenu::separator { height: 1px; background-color: rgba(120, 80, 255, 0.5); margin: 5px 10px; }"
     );
     
-    // Uygulama kategorileri
-    QMenu *appsMenu = new QMenu("Uygulamalar", m_startMenu);
-    appsMenu->setIcon(QIcon::fromTheme("applications-system"));
-    appsMenu->addAction(QIcon::fromTheme("system-file-manager"), "Dosya Yöneticisi");
-    appsMenu->addAction(QIcon::fromTheme("utilities-terminal"), "Terminal");
-    appsMenu->addAction(QIcon::fromTheme("web-browser"), "Web Tarayıcı");
-    appsMenu->addAction(QIcon::fromTheme("accessories-text-editor"), "Metin Düzenleyici");
+    // Uygulama kategorileri: kurulu .desktop dosyalarından
+    m_appsMenu = new QMenu("Uygulamalar", m_startMenu);
+    BlurService::instance()->installBackdrop(m_appsMenu, 10);
+    m_appsMenu->setIcon(IconCache::instance()->icon("applications-system"));
+    populateAppsMenu();
+    connect(AppCatalog::instance(), &AppCatalog::catalogChanged, this, &Panel::populateAppsMenu);
     
     // Ana menü öğeleri
-    QAction *userAction = m_startMenu->addAction(QIcon::fromTheme("user-info"), "Kullanıcı: " + qgetenv("USER"));
+    QAction *userAction = m_startMenu->addAction(IconCache::instance()->icon("user-info"), "Kullanıcı: " + qgetenv("USER"));
     userAction->setEnabled(false);
     
-    m_startMenu->addMenu(appsMenu);
-    m_startMenu->addAction(QIcon::fromTheme("preferences-system"), "Ayarlar");
-    m_startMenu->addAction(QIcon::fromTheme("system-search"), "Ara");
+    m_startMenu->addMenu(m_appsMenu);
+    
+    // Sık kullanılanlar kullanıcı satırıyla Uygulamalar arasına eklenir
+    auto markFrequentDirty = [this]() { m_frequentDirty = true; };
+    connect(UsageStore::instance(), &UsageStore::usageChanged, this, markFrequentDirty);
+    connect(AppCatalog::instance(), &AppCatalog::catalogChanged, this, markFrequentDirty);
+    connect(m_startMenu, &QMenu::aboutToShow, this, [this]() {
+        if (m_frequentDirty) {
+            updateFrequentApps();
+        }
+    });
+    m_startMenu->addAction(IconCache::instance()->icon("preferences-system"), "Ayarlar");
+    QAction *searchAction = m_startMenu->addAction(IconCache::instance()->icon("system-search"), "Ara");
+    connect(searchAction, &QAction::triggered, this, [this]() { showSearch(); });
+    
+    // Menü açıkken yazmaya başlamak aramayı o harfle açar
+    m_searchPopup = new AppSearchPopup(this);
+    m_startMenu->installEventFilter(this);
     
     m_startMenu->addSeparator();
     
@@ -109,11 +147,18 @@ void Panel::setupStartMenu()
     autoHideAction->setChecked(m_autoHide);
     connect(autoHideAction, &QAction::toggled, this, &Panel::toggleAutoHide);
     
+    // Menü açıkken panel gizlenmez; kapandığında fare dışarıdaysa gizlenir
+    connect(m_startMenu, &QMenu::aboutToHide, this, [this]() {
+        if (m_autoHide) {
+            m_hideTimer->start();
+        }
+    });
+    
     m_startMenu->addSeparator();
     
-    QAction *lockAction = m_startMenu->addAction(QIcon::fromTheme("system-lock-screen"), "Ekranı Kilitle");
-    QAction *logoutAction = m_startMenu->addAction(QIcon::fromTheme("system-log-out"), "Oturumu Kapat");
-    QAction *powerAction = m_startMenu->addAction(QIcon::fromTheme("system-shutdown"), "Kapat");
+    QAction *lockAction = m_startMenu->addAction(IconCache::instance()->icon("system-lock-screen"), "Ekranı Kilitle");
+    QAction *logoutAction = m_startMenu->addAction(IconCache::instance()->icon("system-log-out"), "Oturumu Kapat");
+    QAction *powerAction = m_startMenu->addAction(IconCache::instance()->icon("system-shutdown"), "Kapat");
     
     // Çıkış ve kapatma işlemleri
     connect(powerAction, &QAction::triggered, []() {
@@ -125,11 +170,115 @@ void Panel::setupStartMenu()
     });
 }
 
-void Panel::paintEvent(QPaintEvent *event)
+void Panel::populateAppsMenu()
 {
-    Q_UNUSED(event);
+    // Önceki kategori menüleri (ve eylemleri) bırakılır
+    for (QAction *action : m_appsMenu->actions()) {
+        if (action->menu()) {
+            action->menu()->deleteLater();
+        }
+    }
+    m_appsMenu->clear();
     
-    QPainter painter(this);
+    AppCatalog *catalog = AppCatalog::instance();
+    if (!catalog->isReady()) {
+        m_appsMenu->addAction("Uygulamalar yükleniyor...")->setEnabled(false);
+        return;
+    }
+    
+    // Yalnızca kategori numaraları sayılır; uygulama adları burada çözülmez
+    int counts[AppCatalog::CategoryCount + 1] = {};
+    const int count = catalog->count();
+    for (int i = 0; i < count; ++i) {
+        const int category = catalog->primaryCategory(i);
+        ++counts[category < 0 ? AppCatalog::CategoryCount : category];
+    }
+    
+    for (int category = 0; category <= AppCatalog::CategoryCount; ++category) {
+        if (counts[category] == 0) {
+            continue;
+        }
+        QMenu *menu = new QMenu(AppCatalog::categoryName(category), m_appsMenu);
+        menu->setIcon(IconCache::instance()->icon(AppCatalog::categoryIcon(category)));
+        BlurService::instance()->installBackdrop(menu, 10);
+        m_appsMenu->addMenu(menu);
+        
+        connect(menu, &QMenu::aboutToShow, this, [this, menu, category]() {
+            if (menu->isEmpty()) {
+                fillCategoryMenu(menu, category);
+            }
+        });
+    }
+}
+
+void Panel::fillCategoryMenu(QMenu *menu, int category)
+{
+    // Katalog ada göre sıralıdır; menü de aynı sırayla dolar
+    AppCatalog *catalog = AppCatalog::instance();
+    const int count = catalog->count();
+    for (int i = 0; i < count; ++i) {
+        const int primary = catalog->primaryCategory(i);
+        if ((primary < 0 ? int(AppCatalog::CategoryCount) : primary) != category) {
+            continue;
+        }
+        
+        QAction *action = menu->addAction(IconCache::instance()->icon(catalog->iconName(i)), catalog->name(i));
+        
+        // Katalog değişince menüler yeniden kurulduğundan sıra numarası geçerli kalır
+        connect(action, &QAction::triggered, this, [i]() {
+            AppLauncher::instance()->launch(AppCatalog::instance()->entry(i));
+        });
+    }
+}
+
+void Panel::updateFrequentApps()
+{
+    m_frequentDirty = false;
+    for (QAction *action : m_frequentActions) {
+        m_startMenu->removeAction(action);
+        action->deleteLater();
+    }
+    m_frequentActions.clear();
+    
+    // Sıralama UsageStore'da hazırdır; yalnızca ilk birkaç anahtar katalogda aranır.
+    // Katalog dışı komutlar ve gizli girdiler atlanır
+    const int maxCount = 6;
+    AppCatalog *catalog = AppCatalog::instance();
+    QAction *before = m_appsMenu->menuAction();
+    for (const QString &key : UsageStore::instance()->topKeys(maxCount * 2)) {
+        const AppEntry entry = catalog->entry(key);
+        if (!entry.isValid() || entry.noDisplay) {
+            continue;
+        }
+        
+        QAction *action = new QAction(IconCache::instance()->icon(entry.icon), entry.name, m_startMenu);
+        const QString id = entry.id;
+        connect(action, &QAction::triggered, this, [id]() {
+            AppLauncher::instance()->launch(AppCatalog::instance()->entry(id));
+        });
+        m_startMenu->insertAction(before, action);
+        m_frequentActions.append(action);
+        if (m_frequentActions.size() == maxCount) {
+            break;
+        }
+    }
+    
+    if (!m_frequentActions.isEmpty()) {
+        QAction *separator = new QAction(m_startMenu);
+        separator->setSeparator(true);
+        m_startMenu->insertAction(before, separator);
+        m_frequentActions.append(separator);
+    }
+}
+
+void Panel::renderBackground()
+{
+    const qreal dpr = devicePixelRatioF();
+    m_background = QPixmap(size() * dpr);
+    m_background.setDevicePixelRatio(dpr);
+    m_background.fill(Qt::transparent);
+    
+    QPainter painter(&m_background);
     
     // Yarı şeffaf efekt için
     painter.setRenderHint(QPainter::Antialiasing);
@@ -152,7 +301,12 @@ void Panel::paintEvent(QPaintEvent *event)
     painter.setBrush(gradient);
     
     // Kenarları yuvarlak panel
-    painter.drawRoundedRect(rect(), 10, 10);
+    QPainterPath panelPath;
+    panelPath.addRoundedRect(rect(), 10, 10);
+    painter.drawPath(panelPath);
+    
+    // Bulanık duvar kağıdı aynı alana kırpılır; bölge kırpması yol kırpmasından ucuzdur
+    m_backgroundClip = QRegion(panelPath.toFillPolygon().toPolygon());
     
     // Neon çizgi efekti
     painter.setPen(QPen(QColor(120, 80, 255, 180), 2));
@@ -168,6 +322,26 @@ void Panel::paintEvent(QPaintEvent *event)
     }
 }
 
+void Panel::paintEvent(QPaintEvent *event)
+{
+    if (m_background.isNull() || m_background.devicePixelRatio() != devicePixelRatioF()) {
+        renderBackground();
+    }
+    
+    // Yalnızca güncellenen alan boyanır (ör. saat ya da bir görev düğmesi)
+    const QRect dirty = event->rect();
+    QPainter painter(this);
+    
+    // Bulanık duvar kağıdı: hazır sonuçtan düz kopyalama
+    painter.setClipRegion(m_backgroundClip.intersected(dirty));
+    BlurService::instance()->paint(&painter, dirty, QRect(mapTo(window(), dirty.topLeft()), dirty.size()));
+    painter.setClipping(false);
+    
+    const qreal dpr = m_background.devicePixelRatio();
+    painter.drawPixmap(dirty.topLeft(), m_background,
+                       QRectF(dirty.topLeft() * dpr, dirty.size() * dpr));
+}
+
 void Panel::showStartMenu()
 {
     QPoint pos;
@@ -185,49 +359,123 @@ void Panel::showStartMenu()
     m_startMenu->popup(pos);
 }
 
+void Panel::showSearch(const QString &text)
+{
+    const QSize size = m_searchPopup->sizeHint();
+    QPoint pos;
+    
+    if (m_position == Qt::BottomEdge) {
+        pos = mapToGlobal(QPoint(m_startButton->x(), -size.height()));
+    } else if (m_position == Qt::TopEdge) {
+        pos = mapToGlobal(QPoint(m_startButton->x(), height()));
+    } else if (m_position == Qt::LeftEdge) {
+        pos = mapToGlobal(QPoint(width(), m_startButton->y()));
+    } else {
+        pos = mapToGlobal(QPoint(-size.width(), m_startButton->y()));
+    }
+    
+    m_searchPopup->popup(pos, text);
+}
+
+bool Panel::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched == m_startMenu && event->type() == QEvent::KeyPress) {
+        const QString text = static_cast<QKeyEvent *>(event)->text();
+        if (!text.isEmpty() && text.at(0).isLetterOrNumber()) {
+            m_startMenu->close();
+            showSearch(text);
+            return true;
+        }
+    }
+    return QWidget::eventFilter(watched, event);
+}
+
 void Panel::setPosition(Qt::Edge position)
 {
     if (m_position != position) {
         m_position = position;
+        m_background = QPixmap();
         updatePanelGeometry();
         update();
     }
 }
 
-void Panel::updatePanelGeometry()
+QRect Panel::panelGeometry(bool hidden) const
 {
     QScreen *screen = QGuiApplication::primaryScreen();
-    QRect screenGeometry = screen->geometry();
     
-    if (m_position == Qt::BottomEdge) {
-        setGeometry(0, screenGeometry.height() - m_panelSize, screenGeometry.width(), m_panelSize);
-    } else if (m_position == Qt::TopEdge) {
-        setGeometry(0, 0, screenGeometry.width(), m_panelSize);
+    // Üst pencere tüm sanal masaüstünü kapladığı için birincil ekranın
+    // konumu ona göre çevrilir
+    QRect screenGeometry = screen->geometry().translated(-screen->virtualGeometry().topLeft());
+    const int x = screenGeometry.x();
+    const int y = screenGeometry.y();
+    
+    // Gizliyken panelin yalnızca ince bir kenarı ekranda kalır
+    const int visible = hidden ? m_hiddenSize : m_panelSize;
+    
+    if (m_position == Qt::TopEdge) {
+        return QRect(x, y + visible - m_panelSize, screenGeometry.width(), m_panelSize);
     } else if (m_position == Qt::LeftEdge) {
-        setGeometry(0, 0, m_panelSize, screenGeometry.height());
-        
-        // Sol kenarda dikey düzen kullan
-        QVBoxLayout *layout = new QVBoxLayout(this);
-        layout->setContentsMargins(0, 5, 0, 5);
-        layout->setSpacing(5);
-        layout->addWidget(m_startButton);
-        layout->addWidget(m_launcher);
-        layout->addWidget(m_taskbar, 1);
-        layout->addWidget(m_systemTray);
-        setLayout(layout);
+        return QRect(x + visible - m_panelSize, y, m_panelSize, screenGeometry.height());
     } else if (m_position == Qt::RightEdge) {
-        setGeometry(screenGeometry.width() - m_panelSize, 0, m_panelSize, screenGeometry.height());
-        
-        // Sağ kenarda dikey düzen kullan
-        QVBoxLayout *layout = new QVBoxLayout(this);
+        return QRect(x + screenGeometry.width() - visible, y, m_panelSize, screenGeometry.height());
+    }
+    return QRect(x, y + screenGeometry.height() - visible, screenGeometry.width(), m_panelSize);
+}
+
+void Panel::updatePanelGeometry()
+{
+    m_animation->stop();
+    setGeometry(panelGeometry(m_hidden));
+    updateEdgeTrigger();
+    
+    // Mevcut düzenin yalnızca yönü değişir; her çağrıda yeni düzen kurulmaz
+    QBoxLayout *layout = static_cast<QBoxLayout *>(this->layout());
+    if (m_position == Qt::LeftEdge || m_position == Qt::RightEdge) {
+        // Sol ve sağ kenarda dikey düzen kullan
+        layout->setDirection(QBoxLayout::TopToBottom);
         layout->setContentsMargins(0, 5, 0, 5);
-        layout->setSpacing(5);
-        layout->addWidget(m_startButton);
-        layout->addWidget(m_launcher);
-        layout->addWidget(m_taskbar, 1);
-        layout->addWidget(m_systemTray);
-        setLayout(layout);
+    } else {
+        layout->setDirection(QBoxLayout::LeftToRight);
+        layout->setContentsMargins(5, 0, 5, 0);
+    }
+}
+
+void Panel::updateEdgeTrigger()
+{
+    // Tetikleyici kök pencerede, fiziksel piksellerle konumlanır
+    QScreen *screen = QGuiApplication::primaryScreen();
+    const qreal dpr = screen->devicePixelRatio();
+    const QRect screenRect(screen->geometry().topLeft() * dpr, screen->geometry().size() * dpr);
+    const int thickness = qMax(1, qRound(m_hiddenSize * dpr));
+    
+    QRect strip;
+    if (m_position == Qt::TopEdge) {
+        strip = QRect(screenRect.left(), screenRect.top(), screenRect.width(), thickness);
+    } else if (m_position == Qt::LeftEdge) {
+        strip = QRect(screenRect.left(), screenRect.top(), thickness, screenRect.height());
+    } else if (m_position == Qt::RightEdge) {
+        strip = QRect(screenRect.right() - thickness + 1, screenRect.top(), thickness, screenRect.height());
+    } else {
+        strip = QRect(screenRect.left(), screenRect.bottom() - thickness + 1, screenRect.width(), thickness);
+    }
+    m_edgeTrigger->setGeometry(strip);
+}
+
+void Panel::slideTo(bool hidden)
+{
+    if (hidden == m_hidden) {
+        return;
     }
+    m_hidden = hidden;
+    
+    // Yarıda kalan geçiş bulunduğu yerden geri döner
+    m_animation->stop();
+    m_animation->setStartValue(geometry());
+    m_animation->setEndValue(panelGeometry(hidden));
+    m_animation->start();
+    
+    m_edgeTrigger->setArmed(hidden);
 }
 
 void Panel::setAutoHide(bool enabled)
@@ -237,26 +485,9 @@ void Panel::setAutoHide(bool enabled)
     if (m_autoHide) {
         m_hideTimer->start();
     } else {
-        m_hideTimer->stop();
-        
         // Paneli tam görünür yap
-        QPropertyAnimation *animation = new QPropertyAnimation(this, "geometry");
-        animation->setDuration(250);
-        animation->setEasingCurve(QEasingCurve::OutCubic);
-        
-        QRect endGeometry = geometry();
-        if (m_position == Qt::BottomEdge) {
-            endGeometry.setY(parentWidget()->height() - m_panelSize);
-        } else if (m_position == Qt::TopEdge) {
-            endGeometry.setY(0);
-        } else if (m_position == Qt::LeftEdge) {
-            endGeometry.setX(0);
-        } else if (m_position == Qt::RightEdge) {
-            endGeometry.setX(parentWidget()->width() - m_panelSize);
-        }
-        
-        animation->setEndValue(endGeometry);
-        animation->start(QPropertyAnimation::DeleteWhenStopped);
+        m_hideTimer->stop();
+        slideTo(false);
     }
 }
 
@@ -265,72 +496,63 @@ void Panel::toggleAutoHide()
     setAutoHide(!m_autoHide);
 }
 
-void Panel::checkMousePosition()
+void Panel::hidePanel()
 {
-    if (!m_autoHide) return;
-    
-    QPoint globalPos = QCursor::pos();
-    QRect panelRect = QRect(mapToGlobal(rect().topLeft()), mapToGlobal(rect().bottomRight()));
-    
-    // Fare panel üzerinde değilse ve panel görünüyorsa gizle
-    if (!panelRect.contains(globalPos) && !m_startMenu->isVisible()) {
-        QPropertyAnimation *animation = new QPropertyAnimation(this, "geometry");
-        animation->setDuration(250);
-        animation->setEasingCurve(QEasingCurve::OutCubic);
-        
-        QRect endGeometry = geometry();
-        if (m_position == Qt::BottomEdge) {
-            endGeometry.setY(parentWidget()->height() - m_hiddenSize);
-        } else if (m_position == Qt::TopEdge) {
-            endGeometry.setY(-m_panelSize + m_hiddenSize);
-        } else if (m_position == Qt::LeftEdge) {
-            endGeometry.setX(-m_panelSize + m_hiddenSize);
-        } else if (m_position == Qt::RightEdge) {
-            endGeometry.setX(parentWidget()->width() - m_hiddenSize);
-        }
-        
-        animation->setEndValue(endGeometry);
-        animation->start(QPropertyAnimation::DeleteWhenStopped);
+    // Fare panel üzerindeyse ya da menü açıksa gizleme
+    if (!m_autoHide || underMouse() || m_startMenu->isVisible() || m_searchPopup->isVisible()) {
+        return;
     }
+    slideTo(true);
 }
 
-void Panel::enterEvent(QEvent *event)
+void Panel::revealPanel()
 {
-    if (m_autoHide) {
-        QPropertyAnimation *animation = new QPropertyAnimation(this, "geometry");
-        animation->setDuration(250);
-        animation->setEasingCurve(QEasingCurve::OutCubic);
-        
-        QRect endGeometry = geometry();
-        if (m_position == Qt::BottomEdge) {
-            endGeometry.setY(parentWidget()->height() - m_panelSize);
-        } else if (m_position == Qt::TopEdge) {
-            endGeometry.setY(0);
-        } else if (m_position == Qt::LeftEdge) {
-            endGeometry.setX(0);
-        } else if (m_position == Qt::RightEdge) {
-            endGeometry.setX(parentWidget()->width() - m_panelSize);
-        }
-        
-        animation->setEndValue(endGeometry);
-        animation->start(QPropertyAnimation::DeleteWhenStopped);
+    if (!m_autoHide) {
+        return;
     }
+    m_hideTimer->stop();
+    slideTo(false);
+}
+
+void Panel::enterEvent(QEvent *event)
+{
+    // Gizliyken ekranda kalan ince kenar da paneli açar
+    revealPanel();
     
     QWidget::enterEvent(event);
 }
 
 void Panel::leaveEvent(QEvent *event)
 {
-    if (m_autoHide) {
-        // Fare panel dışına çıktığında otomatik gizleme zamanlayıcısını başlat
+    if (m_autoHide && !m_hidden) {
+        // Fare panel dışına çıktığında tek seferlik gizleme gecikmesini başlat
         m_hideTimer->start();
     }
     
     QWidget::leaveEvent(event);
 }
 
+void Panel::setShadow(const QColor &color, int radius)
+{
+    if (m_shadow) {
+        m_shadow->setShadow(color, radius);
+    }
+}
+
 void Panel::resizeEvent(QResizeEvent *event)
 {
     Q_UNUSED(event);
+    m_background = QPixmap();
+    if (m_shadow) {
+        m_shadow->followTarget();
+    }
     update();
 }
+
+void Panel::moveEvent(QMoveEvent *event)
+{
+    Q_UNUSED(event);
+    if (m_shadow) {
+        m_shadow->followTarget();
+    }
+}
@@ -5,9 +5,16 @@
 #include <QPushButton>
 #include <QMenu>
 #include <QTimer>
+#include <QPixmap>
+#include <QRegion>
 #include "taskbar.h"
 #include "systemtray.h"
 #include "launcher.h"
+#include "appsearchpopup.h"
+
+class QPropertyAnimation;
+class EdgeTrigger;
+class PanelShadow;
 
 class Panel : public QWidget
 {
@@ -20,32 +27,64 @@ public:
     // Panel konumunu ayarlama (alt, üst, sol, sağ)
     void setPosition(Qt::Edge position);
     void setAutoHide(bool enabled);
+    // Panelin çevresindeki gölge (tema parıltı rengi)
+    void setShadow(const QColor &color, int radius);
+
+public slots:
+    // Birincil ekranın geometrisine göre panel konumunu yeniler
+    void updatePanelGeometry();
 
 protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
     void paintEvent(QPaintEvent *event) override;
     void resizeEvent(QResizeEvent *event) override;
+    void moveEvent(QMoveEvent *event) override;
     void enterEvent(QEvent *event) override;
     void leaveEvent(QEvent *event) override;
 
 private slots:
     void showStartMenu();
+    void showSearch(const QString &text = QString());
     void toggleAutoHide();
-    void checkMousePosition();
+    void hidePanel();
+    void revealPanel();
 
 private:
     void setupUI();
     void setupStartMenu();
-    void updatePanelGeometry();
+    // Uygulamalar menüsünü katalogdan kurar; kategori menüleri açılınca doldurulur
+    void populateAppsMenu();
+    void fillCategoryMenu(QMenu *menu, int category);
+    // En sık/yakın kullanılan uygulamalar menünün başında; kullanım değiştiyse açılışta yenilenir
+    void updateFrequentApps();
+
+    // Birincil ekranın kenarında, üst pencere koordinatlarında panel alanı
+    QRect panelGeometry(bool hidden) const;
+    // Gizli ya da görünür konuma tek animasyonla kayar; durum aynıysa bir şey yapmaz
+    void slideTo(bool hidden);
+    void updateEdgeTrigger();
+    // Degrade, kenar ve neon çizgiyi boyut/konum değişene dek önbellekte tutar
+    void renderBackground();
 
     QPushButton *m_startButton;
     Taskbar *m_taskbar;
     SystemTray *m_systemTray;
     Launcher *m_launcher;
     QMenu *m_startMenu;
+    QMenu *m_appsMenu;
+    AppSearchPopup *m_searchPopup;
+    QList<QAction*> m_frequentActions;
+    bool m_frequentDirty;
     
     Qt::Edge m_position;
     bool m_autoHide;
-    QTimer *m_hideTimer;
+    bool m_hidden;
+    QTimer *m_hideTimer;              // Fare ayrıldıktan sonra tek seferlik gecikme
+    QPropertyAnimation *m_animation;  // Tüm gizle/göster geçişlerinde yeniden kullanılır
+    EdgeTrigger *m_edgeTrigger;       // Panel gizliyken ekran kenarını bekler
+    PanelShadow *m_shadow;
+    QPixmap m_background;             // Duvar kağıdı dışındaki panel görünümü
+    QRegion m_backgroundClip;         // Yuvarlak köşeli alan; bulanık arka plan için
     int m_panelSize;
     int m_hiddenSize;
 };
@@ -0,0 +1,104 @@
+#include "panelshadow.h"
+#include "blurservice.h"
+#include <QPainter>
+#include <QPaintEvent>
+
+PanelShadow::PanelShadow(QWidget *target, int cornerRadius)
+    : QWidget(target->parentWidget())
+    , m_target(target)
+    , m_color(0, 0, 0, 160)
+    , m_radius(20)
+    , m_cornerRadius(cornerRadius)
+    , m_slicesRatio(0)
+{
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    stackUnder(target);
+    followTarget();
+}
+
+void PanelShadow::setShadow(const QColor &color, int radius)
+{
+    if (color == m_color && radius == m_radius) {
+        return;
+    }
+
+    m_color = color;
+    m_radius = qMax(0, radius);
+    m_slices = QPixmap();
+    followTarget();
+    update();
+}
+
+void PanelShadow::followTarget()
+{
+    setGeometry(m_target->geometry().adjusted(-m_radius, -m_radius, m_radius, m_radius));
+}
+
+void PanelShadow::renderSlices()
+{
+    // Köşe yarıçapı artı bulanıklık payı kadar kenarlı, ortası tek piksel kare
+    const qreal dpr = devicePixelRatioF();
+    const int margin = m_radius + m_cornerRadius;
+    const int side = 2 * margin + 1;
+
+    QImage image(QSize(side, side) * dpr, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(dpr);
+    image.fill(Qt::transparent);
+    {
+        QPainter painter(&image);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(m_color);
+        painter.drawRoundedRect(QRectF(m_radius, m_radius, 2 * m_cornerRadius + 1, 2 * m_cornerRadius + 1),
+                                m_cornerRadius, m_cornerRadius);
+    }
+
+    // Üç geçişli kutu bulanıklığı, yarıçapın üçte biriyle yaklaşık Gauss yayılımı verir
+    BlurService::blur(image, qMax(1, qRound(m_radius * dpr / 3)));
+
+    m_slices = QPixmap::fromImage(image);
+    m_slicesRatio = dpr;
+}
+
+void PanelShadow::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    if (m_radius <= 0 || m_color.alpha() == 0) {
+        return;
+    }
+    if (m_slices.isNull() || m_slicesRatio != devicePixelRatioF()) {
+        renderSlices();
+    }
+
+    // Kaynak dilimler fiziksel piksellerde
+    const int margin = m_radius + m_cornerRadius;
+    const qreal sourceMargin = qRound(margin * m_slicesRatio);
+    const qreal sourceCenter = m_slices.width() - 2 * sourceMargin;
+    const qreal sourceFar = sourceMargin + sourceCenter;
+
+    // Hedef çok darsa kenar dilimleri sıkıştırılır
+    const qreal mx = qMin(margin, width() / 2);
+    const qreal my = qMin(margin, height() / 2);
+    const qreal cx = width() - 2 * mx;
+    const qreal cy = height() - 2 * my;
+
+    QPainter painter(this);
+    auto slice = [&](qreal x, qreal y, qreal w, qreal h, qreal sx, qreal sy, qreal sw, qreal sh) {
+        if (w > 0 && h > 0) {
+            painter.drawPixmap(QRectF(x, y, w, h), m_slices, QRectF(sx, sy, sw, sh));
+        }
+    };
+
+    // Köşeler
+    slice(0, 0, mx, my, 0, 0, sourceMargin, sourceMargin);
+    slice(mx + cx, 0, mx, my, sourceFar, 0, sourceMargin, sourceMargin);
+    slice(0, my + cy, mx, my, 0, sourceFar, sourceMargin, sourceMargin);
+    slice(mx + cx, my + cy, mx, my, sourceFar, sourceFar, sourceMargin, sourceMargin);
+
+    // Kenarlar: orta sütun/satır gerilir
+    slice(mx, 0, cx, my, sourceMargin, 0, sourceCenter, sourceMargin);
+    slice(mx, my + cy, cx, my, sourceMargin, sourceFar, sourceCenter, sourceMargin);
+    slice(0, my, mx, cy, 0, sourceMargin, sourceMargin, sourceCenter);
+    slice(mx + cx, my, mx, cy, sourceFar, sourceMargin, sourceMargin, sourceCenter);
+}
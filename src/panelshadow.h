@@ -0,0 +1,39 @@
+#ifndef PANELSHADOW_H
+#define PANELSHADOW_H
+
+#include <QWidget>
+#include <QColor>
+#include <QPixmap>
+
+// Panelin altında duran kardeş widget; gölgeyi önceden bulanıklaştırılmış
+// küçük bir 9 dilimli görüntüden çizer. Görüntü yalnızca renk, yarıçap ya
+// da ölçek değiştiğinde üretilir; boyamalar sekiz düz kopyalamadan ibarettir
+// (orta dilim panelin altında kaldığından çizilmez).
+class PanelShadow : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit PanelShadow(QWidget *target, int cornerRadius);
+
+    void setShadow(const QColor &color, int radius);
+    int radius() const { return m_radius; }
+
+    // Hedef widget'ın geometrisini gölge payıyla izler
+    void followTarget();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    void renderSlices();
+
+    QWidget *m_target;
+    QColor m_color;
+    int m_radius;
+    int m_cornerRadius;
+    QPixmap m_slices;
+    qreal m_slicesRatio;
+};
+
+#endif // PANELSHADOW_H
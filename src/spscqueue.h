@@ -0,0 +1,61 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+// Tek üretici, tek tüketici için kilitsiz halka tampon. push() yalnızca
+// üretici iş parçacığından, pop() yalnızca tüketiciden çağrılmalıdır.
+// Baş ve kuyruk ayrı önbellek satırlarındadır; iki taraf birbirinin
+// yazdığı satırı yalnızca okur.
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    SpscQueue() : m_head(0), m_tail(0) {}
+
+    // Kuyruk doluysa false döner; öğe eklenmez ve taşınmaz
+    template <typename U>
+    bool push(U &&item)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+
+        m_items[tail & (Capacity - 1)] = std::forward<U>(item);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T &item)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        item = std::move(m_items[head & (Capacity - 1)]);
+        m_items[head & (Capacity - 1)] = T();
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool isEmpty() const
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+private:
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    alignas(64) std::atomic<size_t> m_head;  // Tüketici yazar
+    alignas(64) std::atomic<size_t> m_tail;  // Üretici yazar
+    alignas(64) T m_items[Capacity];
+};
+
+#endif // SPSCQUEUE_H
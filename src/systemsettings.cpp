@@ -1,4 +1,5 @@
 #include "systemsettings.h"
+#include "iconcache.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QHeaderView>
@@ -17,7 +18,7 @@ SystemSettings::SystemSettings(QWidget *parent)
     , m_needsRestart(false)
 {
     setWindowTitle("XenoraOS Sistem Ayarları");
-    setWindowIcon(QIcon::fromTheme("preferences-system"));
+    setWindowIcon(IconCache::instance()->icon("preferences-system"));
     
     // Ana pencere boyutu
     int width = 900;
@@ -94,19 +95,19 @@ void SystemSettings::setupCategoryList()
     // Kategori öğeleri
     QTreeWidgetItem *appearanceItem = new QTreeWidgetItem(m_categoryList);
     appearanceItem->setText(0, "Görünüm");
-    appearanceItem->setIcon(0, QIcon::fromTheme("preferences-desktop-theme"));
+    appearanceItem->setIcon(0, IconCache::instance()->icon("preferences-desktop-theme"));
     
     QTreeWidgetItem *desktopItem = new QTreeWidgetItem(m_categoryList);
     desktopItem->setText(0, "Masaüstü");
-    desktopItem->setIcon(0, QIcon::fromTheme("preferences-desktop-wallpaper"));
+    desktopItem->setIcon(0, IconCache::instance()->icon("preferences-desktop-wallpaper"));
     
     QTreeWidgetItem *panelItem = new QTreeWidgetItem(m_categoryList);
     panelItem->setText(0, "Panel");
-    panelItem->setIcon(0, QIcon::fromTheme("user-desktop"));
+    panelItem->setIcon(0, IconCache::instance()->icon("user-desktop"));
     
     QTreeWidgetItem *systemItem = new QTreeWidgetItem(m_categoryList);
     systemItem->setText(0, "Sistem");
-    systemItem->setIcon(0, QIcon::fromTheme("preferences-system"));
+    systemItem->setIcon(0, IconCache::instance()->icon("preferences-system"));
     
     // İlk öğeyi seç
     m_categoryList->setCurrentItem(appearanceItem);
@@ -1,4 +1,5 @@
 #include "systemtray.h"
+#include "iconcache.h"
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QPushButton>
@@ -25,21 +26,21 @@ void SystemTray::setupTray()
     
     // Ses ayarları butonu
     m_volumeButton = new QPushButton(this);
-    m_volumeButton->setIcon(QIcon::fromTheme("audio-volume-medium"));
+    m_volumeButton->setIcon(IconCache::instance()->icon("audio-volume-medium"));
     m_volumeButton->setFlat(true);
     m_volumeButton->setToolTip("Ses Ayarları");
     connect(m_volumeButton, &QPushButton::clicked, this, &SystemTray::showVolumeControl);
     
     // Ağ ayarları butonu
     m_networkButton = new QPushButton(this);
-    m_networkButton->setIcon(QIcon::fromTheme("network-wireless"));
+    m_networkButton->setIcon(IconCache::instance()->icon("network-wireless"));
     m_networkButton->setFlat(true);
     m_networkButton->setToolTip("Ağ Ayarları");
     connect(m_networkButton, &QPushButton::clicked, this, &SystemTray::showNetworkSettings);
     
     // Batarya durumu (dizüstü bilgisayarlar için)
     m_batteryButton = new QPushButton(this);
-    m_batteryButton->setIcon(QIcon::fromTheme("battery-good-charging"));
+    m_batteryButton->setIcon(IconCache::instance()->icon("battery-good-charging"));
     m_batteryButton->setFlat(true);
     m_batteryButton->setToolTip("Batarya Durumu");
     connect(m_batteryButton, &QPushButton::clicked, this, &SystemTray::showBatteryInfo);
@@ -1,41 +1,97 @@
 #include "taskbar.h"
-#include <QHBoxLayout>
+#include "applauncher.h"
+#include "iconcache.h"
+#include "taskpreview.h"
+#include "windowgroupmodel.h"
+#include "windowlistmodel.h"
+#include "windowthumbnailer.h"
+#include "windowtracker.h"
+#include <QEvent>
+#include <QMenu>
 #include <QPushButton>
-#include <QTimer>
-#include <QX11Info>
+#include <QStyle>
 #include <xcb/xcb.h>
 
-// TaskButton sınıfı (basitleştirilmiş)
+namespace {
+
+const int MinButtonWidth = 100;
+const int MaxButtonWidth = 200;
+const int ButtonSpacing = 3;
+const int OverflowWidth = 36;
+
+// Havuzda bekletilen en fazla düğme; fazlası silinir
+const int MaxPoolSize = 32;
+
+} // namespace
+
+// Bir pencereyi gösteren, havuzdan yeniden kullanılan düğme
 class TaskButton : public QPushButton
 {
 public:
-    TaskButton(xcb_window_t window, const QString &title, const QIcon &icon, QWidget *parent = nullptr)
-        : QPushButton(parent), m_window(window)
+    explicit TaskButton(QWidget *parent = nullptr)
+        : QPushButton(parent), m_window(XCB_WINDOW_NONE), m_iconHash(0)
     {
-        setText(title);
-        setIcon(icon);
         setCheckable(true);
         setFlat(true);
     }
-    
+
     xcb_window_t window() const { return m_window; }
+    void setWindow(xcb_window_t window) { m_window = window; }
+
+    // Simge yalnızca içerik değiştiğinde yeniden atanır
+    void setWindowIcon(const QIcon &icon, quint64 hash)
+    {
+        if (hash == m_iconHash && !this->icon().isNull()) {
+            return;
+        }
+        m_iconHash = hash;
+        setIcon(icon);
+    }
 
 private:
     xcb_window_t m_window;
+    quint64 m_iconHash;
 };
 
 Taskbar::Taskbar(QWidget *parent)
     : QWidget(parent)
+    , m_tracker(new WindowTracker(this))
+    , m_windowModel(new WindowListModel(m_tracker, this))
+    , m_model(new WindowGroupModel(m_windowModel, this))
+    , m_overflowButton(nullptr)
+    , m_overflowMenu(nullptr)
+    , m_groupMenu(nullptr)
+    , m_buttonWidth(0)
+    , m_thumbnailer(new WindowThumbnailer(this))
+    , m_preview(nullptr)
+    , m_hoverWindow(XCB_WINDOW_NONE)
 {
     setupTaskbar();
-    
-    // Düzenli aralıklarla görev listesini güncelle
-    QTimer *timer = new QTimer(this);
-    connect(timer, &QTimer::timeout, this, &Taskbar::updateTasks);
-    timer->start(1000);
-    
-    // İlk çağrı
-    updateTasks();
+
+    // Önizleme, düğme üzerinde kısa bir süre beklenince açılır
+    if (m_thumbnailer->isValid()) {
+        m_preview = new TaskPreview(m_thumbnailer, this);
+        m_previewTimer.setSingleShot(true);
+        m_previewTimer.setInterval(400);
+        connect(&m_previewTimer, &QTimer::timeout, this, &Taskbar::showPreview);
+    }
+
+    // Pencere başına önbellekler kapanan pencerelerle birlikte temizlenir
+    connect(m_windowModel, &QAbstractItemModel::rowsAboutToBeRemoved, this, &Taskbar::windowsAboutToBeRemoved);
+
+    // Grup modeli yalnızca değişen satırları bildirir; yalnızca onlara dokunulur
+    connect(m_model, &QAbstractItemModel::rowsInserted, this, &Taskbar::rowsInserted);
+    connect(m_model, &QAbstractItemModel::rowsRemoved, this, &Taskbar::rowsRemoved);
+    connect(m_model, &QAbstractItemModel::dataChanged, this, &Taskbar::dataChanged);
+
+    // Başlatılan uygulamanın ilk penceresi yer tutucusunu kaldırır
+    AppLauncher *launcher = AppLauncher::instance();
+    connect(launcher, &AppLauncher::launchStarted, this, &Taskbar::launchStarted);
+    connect(launcher, &AppLauncher::launchFinished, this, &Taskbar::launchFinished);
+    connect(m_tracker, &WindowTracker::windowAdded, this, [this, launcher](xcb_window_t window) {
+        const WindowInfo info = m_tracker->info(window);
+        launcher->windowMapped(info.pid, info.wmClass, info.wmInstance);
+    });
 }
 
 Taskbar::~Taskbar()
@@ -44,75 +100,332 @@ Taskbar::~Taskbar()
 
 void Taskbar::setupTaskbar()
 {
-    QHBoxLayout *layout = new QHBoxLayout(this);
-    layout->setContentsMargins(0, 0, 0, 0);
-    layout->setSpacing(3);
-    
-    setLayout(layout);
-}
-
-void Taskbar::updateTasks()
-{
-    // Mevcut pencereleri al
-    QVector<xcb_window_t> windows = getWindowList();
-    
-    // Artık mevcut olmayan görevleri kaldır
-    QMutableMapIterator<xcb_window_t, TaskButton*> it(m_taskButtons);
-    while (it.hasNext()) {
-        it.next();
-        if (!windows.contains(it.key())) {
-            delete it.value();
-            it.remove();
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
+
+    m_overflowMenu = new QMenu(this);
+    m_groupMenu = new QMenu(this);
+    m_overflowButton = new QPushButton(this);
+    m_overflowButton->setFlat(true);
+    m_overflowButton->setToolTip("Diğer pencereler");
+    m_overflowButton->hide();
+    connect(m_overflowButton, &QPushButton::clicked, this, &Taskbar::showOverflowMenu);
+}
+
+QSize Taskbar::sizeHint() const
+{
+    // Satır sayısına bağlı değildir; pencere açıldıkça panel yerleşimi yenilenmez
+    return QSize(MaxButtonWidth, m_overflowButton->sizeHint().height());
+}
+
+QSize Taskbar::minimumSizeHint() const
+{
+    return QSize(OverflowWidth, m_overflowButton->minimumSizeHint().height());
+}
+
+void Taskbar::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+
+    // Yükseklik tüm düğmeleri etkiler
+    m_buttonWidth = 0;
+    syncButtons();
+}
+
+int Taskbar::capacity() const
+{
+    // Yer tutucular her zaman gösterilir; gruplara kalan yer azalır
+    const int rows = m_model->rowCount();
+    const int launches = m_launchButtons.size();
+    if ((rows + launches) * (MinButtonWidth + ButtonSpacing) - ButtonSpacing <= width()) {
+        return rows;
+    }
+    return qMax(0, (width() - OverflowWidth) / (MinButtonWidth + ButtonSpacing) - launches);
+}
+
+int Taskbar::buttonWidth(int count) const
+{
+    const int slots = count + m_launchButtons.size();
+    if (slots == 0) {
+        return MaxButtonWidth;
+    }
+
+    const bool overflow = count < m_model->rowCount();
+    const int available = width() - (overflow ? OverflowWidth + ButtonSpacing : 0);
+    return qBound(MinButtonWidth, (available - (slots - 1) * ButtonSpacing) / slots, MaxButtonWidth);
+}
+
+TaskButton *Taskbar::acquireButton()
+{
+    if (!m_pool.isEmpty()) {
+        return m_pool.takeLast();
+    }
+
+    TaskButton *button = new TaskButton(this);
+    connect(button, &QPushButton::clicked, this, [this, button]() {
+        buttonClicked(button);
+    });
+    button->installEventFilter(this);
+    return button;
+}
+
+void Taskbar::releaseButton(TaskButton *button)
+{
+    button->hide();
+    button->setWindow(XCB_WINDOW_NONE);
+
+    if (m_pool.size() < MaxPoolSize) {
+        m_pool.append(button);
+    } else {
+        button->deleteLater();
+    }
+}
+
+void Taskbar::bindButton(TaskButton *button, int row)
+{
+    // Grubun temsilci penceresi: simge ve önizleme ondan alınır
+    const xcb_window_t window = m_model->window(row);
+    const WindowInfo info = m_tracker->info(window);
+    const QModelIndex index = m_model->index(row);
+
+    button->setWindow(window);
+    button->setText(index.data(Qt::DisplayRole).toString());
+    button->setToolTip(index.data(Qt::ToolTipRole).toString());
+    button->setChecked(index.data(WindowListModel::ActiveRole).toBool());
+
+    const int iconSize = qRound(button->iconSize().width() * button->devicePixelRatioF());
+    button->setWindowIcon(getWindowIcon(info, iconSize), info.iconHash);
+}
+
+void Taskbar::syncButtons()
+{
+    const int visible = qMin(m_model->rowCount(), capacity());
+    while (m_buttons.size() > visible) {
+        releaseButton(m_buttons.takeLast());
+    }
+
+    const int from = m_buttons.size();
+    while (m_buttons.size() < visible) {
+        TaskButton *button = acquireButton();
+        bindButton(button, m_buttons.size());
+        m_buttons.append(button);
+    }
+
+    layoutButtons(from);
+}
+
+void Taskbar::layoutButtons(int from)
+{
+    const int slotWidth = buttonWidth(m_buttons.size());
+    if (slotWidth != m_buttonWidth) {
+        m_buttonWidth = slotWidth;
+        from = 0;
+    }
+
+    for (int i = from; i < m_buttons.size(); ++i) {
+        m_buttons.at(i)->setGeometry(i * (m_buttonWidth + ButtonSpacing), 0, m_buttonWidth, height());
+        m_buttons.at(i)->show();
+    }
+
+    // Yer tutucular grupların ardından gelir; az sayıdadır, hep yeniden konur
+    int slot = m_buttons.size();
+    for (QPushButton *button : qAsConst(m_launchButtons)) {
+        button->setGeometry(slot++ * (m_buttonWidth + ButtonSpacing), 0, m_buttonWidth, height());
+        button->show();
+    }
+
+    const int hidden = m_model->rowCount() - m_buttons.size();
+    if (hidden > 0) {
+        m_overflowButton->setText(QString("+%1").arg(hidden));
+        m_overflowButton->setGeometry(width() - OverflowWidth, 0, OverflowWidth, height());
+        m_overflowButton->show();
+    } else {
+        m_overflowButton->hide();
+    }
+}
+
+void Taskbar::windowsAboutToBeRemoved(const QModelIndex &parent, int first, int last)
+{
+    Q_UNUSED(parent);
+
+    for (int row = first; row <= last; ++row) {
+        const xcb_window_t window = m_windowModel->window(row);
+        m_iconCache.remove(window);
+        m_thumbnailer->forget(window);
+        if (window == m_hoverWindow) {
+            m_previewTimer.stop();
+            m_hoverWindow = XCB_WINDOW_NONE;
+            m_preview->hidePreview();
         }
     }
-    
-    // Yeni pencereleri ekle
-    for (xcb_window_t window : windows) {
-        if (!m_taskButtons.contains(window)) {
-            QString title = getWindowTitle(window);
-            QIcon icon = getWindowIcon(window);
-            
-            TaskButton *button = new TaskButton(window, title, icon, this);
-            connect(button, &QPushButton::clicked, [this, window]() {
-                activateWindow(window);
-            });
-            
-            layout()->addWidget(button);
-            m_taskButtons[window] = button;
+}
+
+void Taskbar::rowsInserted(const QModelIndex &parent, int first, int last)
+{
+    Q_UNUSED(parent);
+
+    // Görünür aralığın ortasına eklenen satırlar yerinde bağlanır; fazlası syncButtons'ta düşer
+    if (first < m_buttons.size()) {
+        for (int row = first; row <= last; ++row) {
+            TaskButton *button = acquireButton();
+            bindButton(button, row);
+            m_buttons.insert(row, button);
         }
+        layoutButtons(first);
     }
+    syncButtons();
 }
 
-QVector<xcb_window_t> Taskbar::getWindowList()
+void Taskbar::rowsRemoved(const QModelIndex &parent, int first, int last)
 {
-    // NOT: Gerçek uygulamada EWMH/NetWM kullanılarak
-    // pencere listesi alınacaktır. Bu sadece iskelet kodudur.
-    QVector<xcb_window_t> windows;
-    
-    // X11 pencere listesini almak için gerçek kod burada olacak
-    
-    return windows;
+    Q_UNUSED(parent);
+
+    if (first < m_buttons.size()) {
+        const int end = qMin(last, m_buttons.size() - 1);
+        for (int row = end; row >= first; --row) {
+            releaseButton(m_buttons.takeAt(row));
+        }
+        layoutButtons(first);
+    }
+    // Taşmadaki satırlar boşalan yere geçer
+    syncButtons();
 }
 
-QString Taskbar::getWindowTitle(xcb_window_t window)
+void Taskbar::dataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight)
 {
-    // NOT: Gerçek uygulamada X11 özelliklerinden başlık alınacaktır.
-    // Bu sadece iskelet kodudur.
-    return QString("Pencere %1").arg(window);
+    const int last = qMin(bottomRight.row(), m_buttons.size() - 1);
+    for (int row = topLeft.row(); row <= last; ++row) {
+        bindButton(m_buttons.at(row), row);
+    }
 }
 
-QIcon Taskbar::getWindowIcon(xcb_window_t window)
+void Taskbar::launchStarted(int id, const QString &name, const QString &iconName)
 {
-    // NOT: Gerçek uygulamada X11 özelliklerinden simge alınacaktır.
-    // Bu sadece iskelet kodudur.
-    Q_UNUSED(window);
-    return QIcon::fromTheme("application-x-executable");
+    QPushButton *button = new QPushButton(this);
+    button->setFlat(true);
+    button->setEnabled(false);
+    button->setText(name);
+    button->setToolTip(QString("%1 başlatılıyor...").arg(name));
+    button->setIcon(IconCache::instance()->icon(iconName.isEmpty() ? QString("application-x-executable") : iconName));
+    m_launchButtons.insert(id, button);
+
+    // Grup düğmelerinin sığan sayısı ve genişliği değişebilir
+    syncButtons();
+}
+
+void Taskbar::launchFinished(int id)
+{
+    QPushButton *button = m_launchButtons.take(id);
+    if (!button) {
+        return;
+    }
+    button->hide();
+    button->deleteLater();
+    syncButtons();
+}
+
+QIcon Taskbar::getWindowIcon(const WindowInfo &info, int size)
+{
+    // Pencerenin kendi simgesi (_NET_WM_ICON); yoksa genel simge
+    const QIcon icon = m_iconCache.icon(info, size);
+    if (!icon.isNull()) {
+        return icon;
+    }
+    return IconCache::instance()->icon("application-x-executable");
 }
 
 void Taskbar::activateWindow(xcb_window_t window)
 {
-    // NOT: Burada XCB kullanılarak pencere aktif hale getirilecektir.
-    // Bu sadece iskelet kodudur.
-    
-    // X11 penceresini aktif hale getirmek için gerçek kod burada olacak
+    m_tracker->activate(window);
+
+    // Düğme tıklamayla işaretini değiştirir; gerçek durum _NET_ACTIVE_WINDOW ile gelir
+    const int row = m_model->rowOf(window);
+    if (row >= 0 && row < m_buttons.size()) {
+        m_buttons.at(row)->setChecked(m_model->index(row).data(WindowListModel::ActiveRole).toBool());
+    }
+}
+
+void Taskbar::buttonClicked(TaskButton *button)
+{
+    const int row = m_model->rowOf(button->window());
+    const QVector<xcb_window_t> windows = m_model->windows(row);
+    if (windows.size() <= 1) {
+        activateWindow(button->window());
+        return;
+    }
+
+    // Grup düğmesi pencerelerin listesini açar; seçim yapılana dek işaret değişmez
+    button->setChecked(m_model->index(row).data(WindowListModel::ActiveRole).toBool());
+    m_groupMenu->clear();
+    fillWindowMenu(m_groupMenu, windows);
+    m_groupMenu->popup(button->mapToGlobal(QPoint(0, 0)));
+}
+
+void Taskbar::fillWindowMenu(QMenu *menu, const QVector<xcb_window_t> &windows)
+{
+    // Simgeler pencere önbelleğinden gelir; menü boyutu düğme boyutundan ayrı tutulur
+    const int iconSize = qRound(menu->style()->pixelMetric(QStyle::PM_SmallIconSize) * devicePixelRatioF());
+    for (xcb_window_t window : windows) {
+        const WindowInfo info = m_tracker->info(window);
+        QAction *action = menu->addAction(getWindowIcon(info, iconSize), info.title);
+        action->setCheckable(true);
+        action->setChecked(window == m_tracker->activeWindow());
+        connect(action, &QAction::triggered, this, [this, window]() {
+            activateWindow(window);
+        });
+    }
+}
+
+void Taskbar::showOverflowMenu()
+{
+    // Menü yalnızca açılırken doldurulur; taşmadaki pencereler için widget tutulmaz
+    m_overflowMenu->clear();
+    for (int row = m_buttons.size(); row < m_model->rowCount(); ++row) {
+        if (row > m_buttons.size()) {
+            m_overflowMenu->addSeparator();
+        }
+        fillWindowMenu(m_overflowMenu, m_model->windows(row));
+    }
+
+    m_overflowMenu->popup(m_overflowButton->mapToGlobal(QPoint(0, 0)));
+}
+
+bool Taskbar::eventFilter(QObject *watched, QEvent *event)
+{
+    if (!m_preview || (event->type() != QEvent::Enter && event->type() != QEvent::Leave)) {
+        return QWidget::eventFilter(watched, event);
+    }
+
+    TaskButton *button = static_cast<TaskButton *>(watched);
+    if (event->type() == QEvent::Enter) {
+        m_hoverWindow = button->window();
+        // Önizleme zaten açıksa düğmeler arasında gezinirken beklemeden geçilir
+        if (m_preview->isVisible()) {
+            showPreview();
+        } else {
+            m_previewTimer.start();
+        }
+    } else if (button->window() == m_hoverWindow) {
+        // Kısa gecikmeyle kapanır; komşu düğmeye geçilirse önizleme açık kalır
+        m_previewTimer.stop();
+        m_hoverWindow = XCB_WINDOW_NONE;
+        QTimer::singleShot(150, this, [this]() {
+            if (m_hoverWindow == XCB_WINDOW_NONE) {
+                m_preview->hidePreview();
+            }
+        });
+    }
+
+    return QWidget::eventFilter(watched, event);
+}
+
+void Taskbar::showPreview()
+{
+    const int row = m_model->rowOf(m_hoverWindow);
+    if (row < 0 || row >= m_buttons.size()) {
+        return;
+    }
+
+    TaskButton *button = m_buttons.at(row);
+    const QRect anchor(button->mapToGlobal(QPoint(0, 0)), button->size());
+    m_preview->showFor(m_hoverWindow, m_tracker->info(m_hoverWindow).title, anchor);
 }
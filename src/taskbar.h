@@ -3,11 +3,28 @@
 
 #include <QWidget>
 #include <QMap>
+#include <QTimer>
 #include <QVector>
-#include <xcb/xcb.h>
+#include "windowiconcache.h"
 
+class QMenu;
+class QModelIndex;
+class QPushButton;
 class TaskButton;
+class TaskPreview;
+class WindowGroupModel;
+class WindowListModel;
+class WindowThumbnailer;
+class WindowTracker;
 
+// Açık pencerelerin düğmeleri; aynı uygulamanın pencereleri tek düğmede
+// toplanır ve tıklanınca liste olarak açılır. WindowGroupModel'in
+// görünümüdür: düğmeler bir havuzdan alınıp satırlara bağlanır, satır
+// gidince havuza döner; pencere açılıp kapandıkça widget oluşturulup
+// silinmez. Yerleşim elle yapılır; düğme genişliği değişmedikçe yalnızca
+// eklenen/silinen satırdan sonraki düğmeler kaydırılır. Sığmayan gruplar
+// taşma menüsündedir. Başlatılan uygulamalar ilk pencereleri açılana dek
+// grupların ardında pasif bir yer tutucu düğmeyle gösterilir.
 class Taskbar : public QWidget
 {
     Q_OBJECT
@@ -16,17 +33,60 @@ public:
     explicit Taskbar(QWidget *parent = nullptr);
     ~Taskbar();
 
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+
+protected:
+    void resizeEvent(QResizeEvent *event) override;
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
 private slots:
-    void updateTasks();
+    void windowsAboutToBeRemoved(const QModelIndex &parent, int first, int last);
+    void rowsInserted(const QModelIndex &parent, int first, int last);
+    void rowsRemoved(const QModelIndex &parent, int first, int last);
+    void dataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight);
     void activateWindow(xcb_window_t window);
+    void buttonClicked(TaskButton *button);
+    void showPreview();
+    void showOverflowMenu();
+    void launchStarted(int id, const QString &name, const QString &iconName);
+    void launchFinished(int id);
 
 private:
     void setupTaskbar();
-    QVector<xcb_window_t> getWindowList();
-    QString getWindowTitle(xcb_window_t window);
-    QIcon getWindowIcon(xcb_window_t window);
+    QIcon getWindowIcon(const WindowInfo &info, int size);
+    // Verilen pencereleri menüye ekler (taşma ve grup listeleri)
+    void fillWindowMenu(QMenu *menu, const QVector<xcb_window_t> &windows);
+
+    TaskButton *acquireButton();
+    void releaseButton(TaskButton *button);
+    void bindButton(TaskButton *button, int row);
+
+    // Görünür düğme sayısını satır sayısına ve genişliğe uydurur
+    void syncButtons();
+    // from'dan itibaren düğmeleri konumlandırır; genişlik değiştiyse hepsini
+    void layoutButtons(int from);
+    int capacity() const;
+    int buttonWidth(int count) const;
+
+    WindowTracker *m_tracker;
+    WindowListModel *m_windowModel;
+    WindowGroupModel *m_model;
+    WindowIconCache m_iconCache;
+
+    QVector<TaskButton*> m_buttons;  // i. düğme i. satırı gösterir
+    QVector<TaskButton*> m_pool;     // Kullanılmayan, gizli düğmeler
+    QMap<int, QPushButton*> m_launchButtons;  // Başlatma kimliğine göre, başlatma sırasıyla
+    QPushButton *m_overflowButton;
+    QMenu *m_overflowMenu;
+    QMenu *m_groupMenu;
+    int m_buttonWidth;
 
-    QMap<xcb_window_t, TaskButton*> m_taskButtons;
+    // Üzerine gelinen düğmenin canlı önizlemesi
+    WindowThumbnailer *m_thumbnailer;
+    TaskPreview *m_preview;
+    QTimer m_previewTimer;
+    xcb_window_t m_hoverWindow;
 };
 
 #endif // TASKBAR_H
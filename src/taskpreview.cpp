@@ -0,0 +1,92 @@
+#include "taskpreview.h"
+#include "windowthumbnailer.h"
+#include <QGuiApplication>
+#include <QPainter>
+#include <QScreen>
+
+namespace {
+
+// Önizleme alanı (mantıksal piksel) ve başlık şeridi
+const QSize ThumbnailSize(220, 140);
+const int TitleHeight = 22;
+const int Margin = 8;
+
+} // namespace
+
+TaskPreview::TaskPreview(WindowThumbnailer *thumbnailer, QWidget *parent)
+    : QWidget(parent, Qt::ToolTip | Qt::FramelessWindowHint)
+    , m_thumbnailer(thumbnailer)
+    , m_window(XCB_WINDOW_NONE)
+{
+    setAttribute(Qt::WA_TranslucentBackground);
+    setFixedSize(ThumbnailSize.width() + 2 * Margin, ThumbnailSize.height() + TitleHeight + 2 * Margin);
+
+    connect(m_thumbnailer, &WindowThumbnailer::thumbnailUpdated, this, &TaskPreview::setThumbnail);
+}
+
+void TaskPreview::showFor(xcb_window_t window, const QString &title, const QRect &anchor)
+{
+    m_window = window;
+    m_title = title;
+    m_thumbnail = m_thumbnailer->thumbnail(window);
+
+    // Kareler fiziksel piksel boyutunda üretilir; ölçekleme çizimde yapılmaz
+    m_thumbnailer->start(window, ThumbnailSize * devicePixelRatioF());
+
+    // Panel altta ise düğmenin üstünde, üstte ise altında; ekrandan taşmaz
+    QRect geometry(QPoint(anchor.center().x() - width() / 2, anchor.top() - height() - 4), size());
+    QScreen *screen = QGuiApplication::screenAt(anchor.center());
+    if (screen) {
+        const QRect available = screen->geometry();
+        if (geometry.top() < available.top()) {
+            geometry.moveTop(anchor.bottom() + 4);
+        }
+        geometry.moveLeft(qBound(available.left(), geometry.left(), available.right() - width() + 1));
+    }
+
+    move(geometry.topLeft());
+    show();
+    update();
+}
+
+void TaskPreview::hidePreview()
+{
+    // Son kare önbellekte kalır; bir sonraki gösterimde hemen çizilir
+    m_thumbnailer->stop();
+    m_window = XCB_WINDOW_NONE;
+    hide();
+}
+
+void TaskPreview::setThumbnail(xcb_window_t window, const QImage &thumbnail)
+{
+    if (window != m_window) {
+        return;
+    }
+
+    m_thumbnail = thumbnail;
+    update(rect().adjusted(Margin, Margin, -Margin, -Margin - TitleHeight));
+}
+
+void TaskPreview::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(QColor(0, 200, 255, 120));
+    painter.setBrush(QColor(20, 20, 30, 230));
+    painter.drawRoundedRect(rect().adjusted(0, 0, -1, -1), 6, 6);
+
+    const QRect area(QPoint(Margin, Margin), ThumbnailSize);
+    if (!m_thumbnail.isNull()) {
+        const QSize size = (m_thumbnail.size() / devicePixelRatioF()).boundedTo(ThumbnailSize);
+        QRect target(QPoint(0, 0), size);
+        target.moveCenter(area.center());
+        painter.drawImage(target, m_thumbnail);
+    }
+
+    painter.setPen(Qt::white);
+    const QRect titleRect(Margin, area.bottom() + 1, ThumbnailSize.width(), TitleHeight);
+    painter.drawText(titleRect, Qt::AlignCenter,
+                     fontMetrics().elidedText(m_title, Qt::ElideRight, titleRect.width()));
+}
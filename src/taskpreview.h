@@ -0,0 +1,37 @@
+#ifndef TASKPREVIEW_H
+#define TASKPREVIEW_H
+
+#include <QWidget>
+#include <QImage>
+#include <xcb/xcb.h>
+
+class WindowThumbnailer;
+
+// Görev düğmesinin üzerinde beliren pencere önizlemesi. Küçük resimleri
+// WindowThumbnailer üretir; açılır pencere yalnızca son kareyi çizer.
+class TaskPreview : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit TaskPreview(WindowThumbnailer *thumbnailer, QWidget *parent = nullptr);
+
+    // anchor: düğmenin genel koordinatlardaki dikdörtgeni
+    void showFor(xcb_window_t window, const QString &title, const QRect &anchor);
+    void hidePreview();
+    xcb_window_t window() const { return m_window; }
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private slots:
+    void setThumbnail(xcb_window_t window, const QImage &thumbnail);
+
+private:
+    WindowThumbnailer *m_thumbnailer;
+    xcb_window_t m_window;
+    QString m_title;
+    QImage m_thumbnail;
+};
+
+#endif // TASKPREVIEW_H
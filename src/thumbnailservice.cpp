@@ -0,0 +1,277 @@
+#include "thumbnailservice.h"
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QImageWriter>
+#include <QMetaObject>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QSet>
+#include <QStandardPaths>
+#include <QThread>
+#include <QThreadPool>
+#include <QUrl>
+#include <QDebug>
+
+namespace {
+
+// Spesifikasyondaki iki boyut sınıfı
+const int NormalSize = 128;
+const int LargeSize = 256;
+
+// Bellekteki küçük resimler için üst sınır (kilobayt)
+const int MemoryBudgetKb = 24 * 1024;
+
+QString thumbnailRoot()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + "/thumbnails";
+}
+
+} // namespace
+
+// Tek bir dosyanın küçük resmini depodan okur ya da kaynaktan ölçekli
+// çözümleyip depoya yazar; sonucu GUI iş parçacığına aktarır
+class ThumbnailJob : public QRunnable
+{
+public:
+    ThumbnailJob(ThumbnailService *service, const QString &path, const QString &key, int serial,
+                 int size, const QSharedPointer<QAtomicInt> &cancelled)
+        : m_service(service), m_path(path), m_key(key), m_serial(serial)
+        , m_size(size), m_cancelled(cancelled)
+    {
+    }
+
+    void run() override
+    {
+        // Görünümden çıkan öğe için hiç iş yapılmaz
+        if (m_cancelled->loadAcquire()) {
+            return;
+        }
+
+        const QFileInfo fileInfo(m_path);
+        const qint64 mtime = fileInfo.lastModified().toSecsSinceEpoch();
+        const QString thumbnailPath = ThumbnailService::thumbnailPath(m_path, m_size);
+
+        QImage image = readStored(thumbnailPath, mtime);
+        if (image.isNull() && !m_cancelled->loadAcquire()) {
+            image = decodeScaled();
+            if (!image.isNull()) {
+                store(thumbnailPath, fileInfo, mtime, image);
+            }
+        }
+
+        deliver(image);
+    }
+
+private:
+    QImage readStored(const QString &thumbnailPath, qint64 mtime) const
+    {
+        QImageReader reader(thumbnailPath, "png");
+        if (!reader.canRead()) {
+            return QImage();
+        }
+
+        // Kaynak değiştiyse depodaki küçük resim geçersizdir
+        if (reader.text("Thumb::MTime").toLongLong() != mtime
+            || reader.text("Thumb::URI") != QUrl::fromLocalFile(m_path).toString(QUrl::FullyEncoded)) {
+            return QImage();
+        }
+
+        return reader.read();
+    }
+
+    QImage decodeScaled() const
+    {
+        QImageReader reader(m_path);
+        reader.setAutoTransform(true);
+
+        // JPEG çözücüsü ölçekli okumayı doğrudan destekler; tam çözünürlüklü ara görüntü oluşmaz
+        const QSize original = reader.size();
+        if (original.isValid() && (original.width() > m_size || original.height() > m_size)) {
+            reader.setScaledSize(original.scaled(m_size, m_size, Qt::KeepAspectRatio).expandedTo(QSize(1, 1)));
+        }
+
+        QImage image = reader.read();
+        if (image.isNull()) {
+            return image;
+        }
+
+        // Ölçekli okuma desteklenmeyen biçimler için son adım
+        if (image.width() > m_size || image.height() > m_size) {
+            image = image.scaled(m_size, m_size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        }
+        return image.convertToFormat(image.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied
+                                                             : QImage::Format_RGB32);
+    }
+
+    void store(const QString &thumbnailPath, const QFileInfo &fileInfo, qint64 mtime, const QImage &image) const
+    {
+        // Depo dizinleri yalnızca kullanıcıya açık olmalı (0700)
+        const QString directory = QFileInfo(thumbnailPath).absolutePath();
+        if (!QDir().mkpath(directory)) {
+            return;
+        }
+        QFile::setPermissions(thumbnailRoot(), QFile::ReadOwner | QFile::WriteOwner | QFile::ExeOwner);
+        QFile::setPermissions(directory, QFile::ReadOwner | QFile::WriteOwner | QFile::ExeOwner);
+
+        // Yarım yazılmış dosya başka uygulamalara görünmesin diye atomik yazılır
+        QSaveFile file(thumbnailPath);
+        if (!file.open(QIODevice::WriteOnly)) {
+            return;
+        }
+
+        QImageWriter writer(&file, "png");
+        writer.setText("Thumb::URI", QUrl::fromLocalFile(m_path).toString(QUrl::FullyEncoded));
+        writer.setText("Thumb::MTime", QString::number(mtime));
+        writer.setText("Thumb::Size", QString::number(fileInfo.size()));
+        writer.setText("Software", "XenoraOS");
+        if (!writer.write(image)) {
+            file.cancelWriting();
+            return;
+        }
+
+        if (file.commit()) {
+            QFile::setPermissions(thumbnailPath, QFile::ReadOwner | QFile::WriteOwner);
+        }
+    }
+
+    void deliver(const QImage &image)
+    {
+        ThumbnailService *service = m_service;
+        const QString path = m_path;
+        const QString key = m_key;
+        const int serial = m_serial;
+        QMetaObject::invokeMethod(service, [service, path, key, serial, image]() {
+            service->finish(path, key, serial, image);
+        }, Qt::QueuedConnection);
+    }
+
+    ThumbnailService *m_service;
+    QString m_path;
+    QString m_key;
+    int m_serial;
+    int m_size;
+    QSharedPointer<QAtomicInt> m_cancelled;
+};
+
+ThumbnailService *ThumbnailService::instance()
+{
+    static ThumbnailService *service = new ThumbnailService(QCoreApplication::instance());
+    return service;
+}
+
+ThumbnailService::ThumbnailService(QObject *parent)
+    : QObject(parent)
+    , m_pool(new QThreadPool(this))
+    , m_nextSerial(1)
+{
+    // Disk ve çözücü yükü sınırlı tutulur; arayüz iş parçacığı hiç beklemez
+    m_pool->setMaxThreadCount(qBound(1, QThread::idealThreadCount() / 2, 3));
+    m_images.setMaxCost(MemoryBudgetKb);
+}
+
+ThumbnailService::~ThumbnailService()
+{
+    for (const Pending &pending : qAsConst(m_pending)) {
+        pending.cancelled->storeRelease(1);
+    }
+    m_pool->clear();
+    m_pool->waitForDone();
+}
+
+bool ThumbnailService::canThumbnail(const QFileInfo &fileInfo)
+{
+    static const QSet<QString> suffixes = {
+        "jpg", "jpeg", "png", "gif", "bmp", "webp", "tif", "tiff"
+    };
+
+    if (fileInfo.isDir() || !suffixes.contains(fileInfo.suffix().toLower())) {
+        return false;
+    }
+
+    // Depodaki küçük resimlerin kendileri için küçük resim üretilmez
+    return !fileInfo.absoluteFilePath().startsWith(thumbnailRoot());
+}
+
+int ThumbnailService::bucketSize(int size)
+{
+    return size <= NormalSize ? NormalSize : LargeSize;
+}
+
+QString ThumbnailService::thumbnailPath(const QString &path, int size)
+{
+    const QByteArray uri = QUrl::fromLocalFile(QFileInfo(path).absoluteFilePath()).toEncoded();
+    const QByteArray hash = QCryptographicHash::hash(uri, QCryptographicHash::Md5).toHex();
+    return thumbnailRoot() + (bucketSize(size) == NormalSize ? "/normal/" : "/large/")
+           + QString::fromLatin1(hash) + ".png";
+}
+
+QString ThumbnailService::memoryKey(const QFileInfo &fileInfo, int size)
+{
+    return fileInfo.absoluteFilePath() + '|' + QString::number(bucketSize(size)) + '|'
+           + QString::number(fileInfo.lastModified().toSecsSinceEpoch());
+}
+
+QImage ThumbnailService::cached(const QFileInfo &fileInfo, int size) const
+{
+    const QImage *image = m_images.object(memoryKey(fileInfo, size));
+    return image ? *image : QImage();
+}
+
+void ThumbnailService::request(const QFileInfo &fileInfo, int size, int priority)
+{
+    const QString path = fileInfo.absoluteFilePath();
+    const int bucket = bucketSize(size);
+
+    auto it = m_pending.find(path);
+    if (it != m_pending.end()) {
+        if (it->priority >= priority && it->size >= bucket) {
+            return;
+        }
+        // Daha yüksek öncelikle yeniden sıraya girer; eski iş boşa döner
+        it->cancelled->storeRelease(1);
+        m_pending.erase(it);
+    }
+
+    Pending pending;
+    pending.serial = m_nextSerial++;
+    pending.priority = priority;
+    pending.size = bucket;
+    pending.cancelled = QSharedPointer<QAtomicInt>::create(0);
+    m_pending.insert(path, pending);
+
+    m_pool->start(new ThumbnailJob(this, path, memoryKey(fileInfo, bucket), pending.serial,
+                                   bucket, pending.cancelled), priority);
+}
+
+void ThumbnailService::cancel(const QString &path)
+{
+    auto it = m_pending.find(path);
+    if (it == m_pending.end()) {
+        return;
+    }
+
+    it->cancelled->storeRelease(1);
+    m_pending.erase(it);
+}
+
+void ThumbnailService::finish(const QString &path, const QString &key, int serial, const QImage &image)
+{
+    auto it = m_pending.find(path);
+    if (it == m_pending.end() || it->serial != serial) {
+        // İptal edilmiş ya da yerine yenisi gelmiş istek
+        return;
+    }
+    m_pending.erase(it);
+
+    if (image.isNull()) {
+        emit thumbnailFailed(path);
+        return;
+    }
+
+    m_images.insert(key, new QImage(image), qMax<int>(1, int(image.sizeInBytes() / 1024)));
+    emit thumbnailReady(path, image);
+}
@@ -0,0 +1,73 @@
+#ifndef THUMBNAILSERVICE_H
+#define THUMBNAILSERVICE_H
+
+#include <QObject>
+#include <QAtomicInt>
+#include <QCache>
+#include <QHash>
+#include <QImage>
+#include <QSharedPointer>
+
+class QFileInfo;
+class QThreadPool;
+
+// Görüntü dosyaları için arka planda küçük resim üretir. Sonuçlar
+// freedesktop ortak küçük resim deposunda (~/.cache/thumbnails/{normal,large})
+// saklanır; tekrar ziyarette kaynak hiç çözümlenmez. Görünür öğeler daha
+// yüksek öncelikle işlenir, görünümden çıkan istekler iptal edilebilir.
+class ThumbnailService : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Priority {
+        Background = 0,
+        Visible = 10
+    };
+
+    static ThumbnailService *instance();
+    ~ThumbnailService();
+
+    // Dosya türü küçük resim üretmeye uygun mu (yalnızca uzantıya bakar)
+    static bool canThumbnail(const QFileInfo &fileInfo);
+
+    // Bellekte hazır küçük resim varsa hemen döner, yoksa boş görüntü.
+    // Anahtar dosyanın değiştirilme zamanını içerir; eski sürüm dönmez.
+    QImage cached(const QFileInfo &fileInfo, int size) const;
+
+    // Küçük resmi ister; hazır olunca thumbnailReady yayılır. Aynı dosya için
+    // bekleyen istek varsa yalnızca önceliği yükseltilir.
+    void request(const QFileInfo &fileInfo, int size, int priority = Visible);
+    void cancel(const QString &path);
+    bool isPending(const QString &path) const { return m_pending.contains(path); }
+
+    // Spesifikasyondaki depo yolu: <önbellek>/thumbnails/<normal|large>/<md5(URI)>.png
+    static QString thumbnailPath(const QString &path, int size);
+
+signals:
+    void thumbnailReady(const QString &path, const QImage &image);
+    void thumbnailFailed(const QString &path);
+
+private:
+    explicit ThumbnailService(QObject *parent = nullptr);
+
+    struct Pending {
+        int serial;
+        int priority;
+        int size;
+        QSharedPointer<QAtomicInt> cancelled;
+    };
+
+    static int bucketSize(int size);
+    static QString memoryKey(const QFileInfo &fileInfo, int size);
+    void finish(const QString &path, const QString &key, int serial, const QImage &image);
+
+    friend class ThumbnailJob;
+
+    QThreadPool *m_pool;
+    QHash<QString, Pending> m_pending;
+    QCache<QString, QImage> m_images;
+    int m_nextSerial;
+};
+
+#endif // THUMBNAILSERVICE_H
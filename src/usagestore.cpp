@@ -0,0 +1,328 @@
+#include "usagestore.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThreadPool>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+const quint32 UsageMagic = 0x58555347; // "XUSG"
+const quint32 UsageVersion = 1;
+
+// Puanların ortak başlangıcı (2024-01-01 UTC) ve bir başlatmanın ağırlığının
+// yarıya indiği süre (saniye)
+const qint64 ScoreEpoch = 1704067200;
+const double HalfLife = 7 * 24 * 3600.0;
+
+// Bu kadar başlatma kaydı birikince günlük sıkıştırılır
+const int MaxLaunchRecords = 512;
+
+// Sıkıştırmada şimdiki bir başlatmanın 2^-20'sinden hafif girdiler atılır
+// (yaklaşık 20 yarı ömür, ~5 ay kullanılmamış)
+const double StaleScore = 20.0;
+
+const double NoScore = -std::numeric_limits<double>::infinity();
+
+struct UsageHeader {
+    quint32 magic;
+    quint32 version;
+    quint32 reserved[2];
+};
+
+static_assert(sizeof(UsageHeader) == 16, "UsageHeader 16 bayt olmalı");
+
+// Kayıtlar hizalamasız, art arda yazılır; ilk bayt türdür
+enum RecordType : quint8 {
+    KeyRecord = 1,     // quint16 uzunluk + UTF-8 anahtar; sıradaki numarayı alır
+    LaunchRecord = 2,  // quint32 anahtar numarası + quint32 zaman (Unix saniyesi)
+    ScoreRecord = 3    // quint32 anahtar numarası + double log2 puanı (sıkıştırmadan)
+};
+
+const int LaunchRecordSize = 9;
+const int ScoreRecordSize = 13;
+
+double weightOf(qint64 time)
+{
+    return double(time - ScoreEpoch) / HalfLife;
+}
+
+// log2(2^a + 2^b), taşmadan
+double logAdd(double a, double b)
+{
+    if (a == NoScore) {
+        return b;
+    }
+    const double high = std::max(a, b);
+    const double low = std::min(a, b);
+    return high + std::log2(1.0 + std::exp2(low - high));
+}
+
+template<typename T>
+void put(QByteArray *data, T value)
+{
+    data->append(reinterpret_cast<const char *>(&value), int(sizeof(value)));
+}
+
+template<typename T>
+T get(const char *data)
+{
+    T value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+QByteArray header()
+{
+    UsageHeader header = { UsageMagic, UsageVersion, { 0, 0 } };
+    return QByteArray(reinterpret_cast<const char *>(&header), int(sizeof(header)));
+}
+
+void appendKey(QByteArray *data, const QByteArray &key)
+{
+    put<quint8>(data, KeyRecord);
+    put<quint16>(data, quint16(key.size()));
+    data->append(key);
+}
+
+} // namespace
+
+UsageStore *UsageStore::instance()
+{
+    static UsageStore *store = new UsageStore(QCoreApplication::instance());
+    return store;
+}
+
+UsageStore::UsageStore(QObject *parent)
+    : QObject(parent)
+    , m_path(QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + "/xenoraos/usage.log")
+    , m_launchRecords(0)
+    , m_writer(new QThreadPool(this))
+{
+    // Tek yazıcı: eklemeler ve sıkıştırmalar istendiği sırayla diske gider
+    m_writer->setMaxThreadCount(1);
+
+    QDir().mkpath(QFileInfo(m_path).absolutePath());
+    load();
+}
+
+UsageStore::~UsageStore()
+{
+    m_writer->waitForDone();
+}
+
+void UsageStore::load()
+{
+    QFile file(m_path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    // Günlük küçüktür; tek okumayla alınır
+    const QByteArray data = file.readAll();
+    if (data.isEmpty()) {
+        return;
+    }
+    const char *base = data.constData();
+    const int size = data.size();
+
+    bool valid = size >= int(sizeof(UsageHeader))
+                 && get<quint32>(base) == UsageMagic
+                 && get<quint32>(base + 4) == UsageVersion;
+
+    int offset = int(sizeof(UsageHeader));
+    while (valid && offset < size) {
+        const quint8 type = quint8(base[offset]);
+        if (type == KeyRecord && offset + 3 <= size) {
+            const int length = get<quint16>(base + offset + 1);
+            if (offset + 3 + length > size) {
+                valid = false;
+                break;
+            }
+            addKey(QString::fromUtf8(base + offset + 3, length));
+            offset += 3 + length;
+        } else if (type == LaunchRecord && offset + LaunchRecordSize <= size) {
+            const quint32 index = get<quint32>(base + offset + 1);
+            if (index >= quint32(m_usages.size())) {
+                valid = false;
+                break;
+            }
+            addLaunch(int(index), qint64(get<quint32>(base + offset + 5)));
+            ++m_launchRecords;
+            offset += LaunchRecordSize;
+        } else if (type == ScoreRecord && offset + ScoreRecordSize <= size) {
+            const quint32 index = get<quint32>(base + offset + 1);
+            if (index >= quint32(m_usages.size())) {
+                valid = false;
+                break;
+            }
+            m_usages[int(index)].score = logAdd(m_usages.at(int(index)).score, get<double>(base + offset + 5));
+            promote(int(index));
+            offset += ScoreRecordSize;
+        } else {
+            // Yarım kalmış son ekleme ya da bozuk kayıt
+            valid = false;
+        }
+    }
+
+    // Okunabilen kısım yeniden yazılır; sonraki eklemeler kayıt sınırına düşer
+    if (!valid || m_launchRecords >= MaxLaunchRecords) {
+        if (!valid) {
+            qWarning() << "Kullanım günlüğü bozuk, okunabilen kısım korunuyor:" << m_path;
+        }
+        compact();
+    }
+}
+
+int UsageStore::addKey(const QString &key)
+{
+    const int index = m_usages.size();
+    m_usages.append({ key, NoScore });
+    m_index.insert(key, index);
+    m_position.append(m_order.size());
+    m_order.append(index);
+    return index;
+}
+
+void UsageStore::addLaunch(int index, qint64 time)
+{
+    m_usages[index].score = logAdd(m_usages.at(index).score, weightOf(time));
+    promote(index);
+}
+
+void UsageStore::promote(int index)
+{
+    // Puan yalnızca artar: girdi, kendinden düşük puanlı ilk girdinin yerine
+    // kayar, aradakiler bir geri çekilir. Eşit puanlılarda eski sıra korunur.
+    const double value = m_usages.at(index).score;
+    const int position = m_position.at(index);
+    const auto begin = m_order.begin();
+    const int target = int(std::upper_bound(begin, begin + position, value, [this](double score, int other) {
+        return score > m_usages.at(other).score;
+    }) - begin);
+
+    if (target == position) {
+        return;
+    }
+    std::rotate(begin + target, begin + position, begin + position + 1);
+    for (int i = target; i <= position; ++i) {
+        m_position[m_order.at(i)] = i;
+    }
+}
+
+void UsageStore::recordLaunch(const QString &key)
+{
+    const QByteArray utf8 = key.toUtf8();
+    if (utf8.isEmpty() || utf8.size() > 0xffff) {
+        return;
+    }
+
+    QByteArray records;
+    int index = m_index.value(key, -1);
+    if (index < 0) {
+        index = addKey(key);
+        appendKey(&records, utf8);
+    }
+
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    addLaunch(index, now);
+    put<quint8>(&records, LaunchRecord);
+    put<quint32>(&records, quint32(index));
+    put<quint32>(&records, quint32(now));
+
+    if (++m_launchRecords >= MaxLaunchRecords) {
+        compact();
+    } else {
+        append(records);
+    }
+
+    emit usageChanged(key);
+}
+
+double UsageStore::score(const QString &key) const
+{
+    const int index = m_index.value(key, -1);
+    return index < 0 ? NoScore : m_usages.at(index).score;
+}
+
+QStringList UsageStore::topKeys(int count) const
+{
+    QStringList keys;
+    for (int i = 0; i < m_order.size() && keys.size() < count; ++i) {
+        const Usage &usage = m_usages.at(m_order.at(i));
+        if (usage.score == NoScore) {
+            break;
+        }
+        keys.append(usage.key);
+    }
+    return keys;
+}
+
+void UsageStore::append(const QByteArray &records)
+{
+    const QString path = m_path;
+    m_writer->start([path, records]() {
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+            qWarning() << "Kullanım günlüğüne yazılamadı:" << path;
+            return;
+        }
+        if (file.size() == 0) {
+            file.write(header());
+        }
+        file.write(records);
+    });
+}
+
+void UsageStore::compact()
+{
+    // Eskimiş girdiler atılır; kalanlar puan sırasıyla yeniden numaralanır
+    const double threshold = weightOf(QDateTime::currentSecsSinceEpoch()) - StaleScore;
+    QVector<Usage> usages;
+    usages.reserve(m_usages.size());
+    for (int index : qAsConst(m_order)) {
+        if (m_usages.at(index).score < threshold) {
+            break;
+        }
+        usages.append(m_usages.at(index));
+    }
+
+    m_usages = usages;
+    m_index.clear();
+    m_order.resize(m_usages.size());
+    m_position.resize(m_usages.size());
+    for (int i = 0; i < m_usages.size(); ++i) {
+        m_index.insert(m_usages.at(i).key, i);
+        m_order[i] = i;
+        m_position[i] = i;
+    }
+    m_launchRecords = 0;
+
+    // Anlık görüntü GUI iş parçacığında alınır; anahtar başına bir anahtar ve bir puan kaydı
+    QByteArray data = header();
+    for (int i = 0; i < m_usages.size(); ++i) {
+        appendKey(&data, m_usages.at(i).key.toUtf8());
+        put<quint8>(&data, ScoreRecord);
+        put<quint32>(&data, quint32(i));
+        put<double>(&data, m_usages.at(i).score);
+    }
+
+    const QString path = m_path;
+    m_writer->start([path, data]() {
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly)) {
+            qWarning() << "Kullanım günlüğü sıkıştırılamadı:" << path;
+            return;
+        }
+        file.write(data);
+        file.commit();
+    });
+}
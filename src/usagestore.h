@@ -0,0 +1,63 @@
+#ifndef USAGESTORE_H
+#define USAGESTORE_H
+
+#include <QObject>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class QThreadPool;
+
+// Uygulama başlatmalarının sıklık × yakınlık (frecency) puanları. Her
+// başlatma 2^((t - T0) / yarı ömür) ağırlığıyla toplanır; toplamın log2'si
+// saklandığından güncelleme O(1)'dir ve eski başlatmalar kendiliğinden
+// değer kaybeder (ortak T0 sayesinde puanlar zaman geçtikçe yeniden
+// hesaplanmadan karşılaştırılabilir). Puanlar bellekte, büyükten küçüğe
+// sıralı bir dizide tutulur; bir başlatma yalnızca o girdiyi öne kaydırır.
+// Disk tarafı yalnızca sona eklenen küçük bir ikili günlüktür; başlatma
+// kayıtları birikince günlük anahtar başına tek puan kaydına sıkıştırılır.
+class UsageStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    static UsageStore *instance();
+    ~UsageStore();
+
+    // Anahtar: .desktop kimliği, katalog dışı komutlarda Exec satırı
+    void recordLaunch(const QString &key);
+
+    // log2 puanı; hiç başlatılmamışsa eksi sonsuz
+    double score(const QString &key) const;
+    // En yüksek puanlı anahtarlar, en iyisi önce
+    QStringList topKeys(int count) const;
+
+signals:
+    void usageChanged(const QString &key);
+
+private:
+    explicit UsageStore(QObject *parent = nullptr);
+
+    struct Usage {
+        QString key;
+        double score;
+    };
+
+    void load();
+    int addKey(const QString &key);
+    void addLaunch(int index, qint64 time);
+    void promote(int index);
+    void append(const QByteArray &records);
+    void compact();
+
+    QString m_path;
+    QVector<Usage> m_usages;       // Günlükteki anahtar sırasıyla
+    QHash<QString, int> m_index;   // Anahtar -> m_usages sırası
+    QVector<int> m_order;          // Puana göre sıralı m_usages sıraları
+    QVector<int> m_position;       // m_usages sırası -> m_order içindeki yeri
+    int m_launchRecords;           // Son sıkıştırmadan beri eklenen başlatmalar
+    QThreadPool *m_writer;         // Eklemeler ve sıkıştırma sırayla
+};
+
+#endif // USAGESTORE_H
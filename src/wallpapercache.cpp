@@ -0,0 +1,158 @@
+#include "wallpapercache.h"
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QMutexLocker>
+#include <QDebug>
+
+namespace {
+
+const quint32 CacheMagic = 0x58575043; // "XWPC"
+const quint32 CacheVersion = 1;
+
+// Piksel verisi başlıktan sonra hizalı başlar
+struct CacheHeader {
+    quint32 magic;
+    quint32 version;
+    qint32 width;
+    qint32 height;
+    qint32 bytesPerLine;
+    quint32 format;
+    quint32 reserved[2];
+};
+
+static_assert(sizeof(CacheHeader) == 32, "CacheHeader 32 bayt olmalı");
+
+// Yükleyici görüntüleri bu iki 32 bitlik biçime çevirip saklar
+bool isCacheFormat(quint32 format)
+{
+    return format == QImage::Format_RGB32 || format == QImage::Format_ARGB32_Premultiplied;
+}
+
+void unmapCacheFile(void *info)
+{
+    // QFile kapanırken eşleme de kaldırılır
+    delete static_cast<QFile *>(info);
+}
+
+} // namespace
+
+WallpaperCache::WallpaperCache(qint64 maxBytes)
+    : m_maxBytes(maxBytes)
+{
+    m_directory = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)
+                  + "/xenoraos/wallpapers";
+    QDir().mkpath(m_directory);
+}
+
+QByteArray WallpaperCache::key(const QString &path, const QSize &targetSize, qreal dpr, const QString &mode)
+{
+    QFileInfo fileInfo(path);
+
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << fileInfo.absoluteFilePath()
+           << fileInfo.lastModified().toMSecsSinceEpoch()
+           << fileInfo.size()
+           << targetSize
+           << dpr
+           << mode;
+
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex();
+}
+
+QString WallpaperCache::filePath(const QByteArray &key) const
+{
+    return m_directory + "/" + QString::fromLatin1(key) + ".raw";
+}
+
+QImage WallpaperCache::lookup(const QByteArray &key) const
+{
+    QFile *file = new QFile(filePath(key));
+    if (!file->open(QIODevice::ReadOnly) || file->size() < qint64(sizeof(CacheHeader))) {
+        delete file;
+        return QImage();
+    }
+
+    uchar *map = file->map(0, file->size());
+    if (!map) {
+        delete file;
+        return QImage();
+    }
+
+    // Bozuk ya da yabancı dosya: yalnızca store()'un yazdığı biçimler ve
+    // satır başına en az width * 4 bayt kabul edilir, gerisi ıskalamadır
+    const CacheHeader *header = reinterpret_cast<const CacheHeader *>(map);
+    const qint64 expected = qint64(sizeof(CacheHeader)) + qint64(header->bytesPerLine) * header->height;
+    if (header->magic != CacheMagic || header->version != CacheVersion
+        || header->width <= 0 || header->height <= 0
+        || !isCacheFormat(header->format)
+        || qint64(header->bytesPerLine) < qint64(header->width) * 4
+        || file->size() < expected) {
+        delete file;
+        return QImage();
+    }
+
+    // LRU sırası için son kullanım zamanını güncelle
+    file->setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+
+    // Salt okunur eşleme: görüntüye yazılırsa QImage önce kopyalar
+    const uchar *pixels = map + sizeof(CacheHeader);
+    return QImage(pixels, header->width, header->height, header->bytesPerLine,
+                  static_cast<QImage::Format>(header->format), unmapCacheFile, file);
+}
+
+bool WallpaperCache::store(const QByteArray &key, const QImage &image)
+{
+    if (image.isNull() || !isCacheFormat(image.format())) {
+        return false;
+    }
+
+    CacheHeader header;
+    header.magic = CacheMagic;
+    header.version = CacheVersion;
+    header.width = image.width();
+    header.height = image.height();
+    header.bytesPerLine = image.bytesPerLine();
+    header.format = image.format();
+    header.reserved[0] = header.reserved[1] = 0;
+
+    QSaveFile file(filePath(key));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Duvar kağıdı önbelleği yazılamadı:" << file.fileName();
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(image.constBits()), image.sizeInBytes());
+
+    if (!file.commit()) {
+        qWarning() << "Duvar kağıdı önbelleği kaydedilemedi:" << file.fileName();
+        return false;
+    }
+
+    evict();
+    return true;
+}
+
+void WallpaperCache::evict()
+{
+    QMutexLocker locker(&m_evictMutex);
+
+    QDir dir(m_directory);
+    QFileInfoList entries = dir.entryInfoList(QStringList() << "*.raw", QDir::Files, QDir::Time);
+
+    // En yeni kullanılan başta; sınır aşıldıktan sonrakiler silinir
+    qint64 total = 0;
+    for (const QFileInfo &entry : entries) {
+        total += entry.size();
+        if (total > m_maxBytes) {
+            QFile::remove(entry.absoluteFilePath());
+        }
+    }
+}
@@ -0,0 +1,35 @@
+#ifndef WALLPAPERCACHE_H
+#define WALLPAPERCACHE_H
+
+#include <QImage>
+#include <QSize>
+#include <QString>
+#include <QByteArray>
+#include <QMutex>
+
+// Ölçeklenmiş, ekrana hazır duvar kağıtlarının disk önbelleği.
+// Kayıtlar ham piksel olarak tutulur ve açılışta doğrudan mmap edilir.
+class WallpaperCache
+{
+public:
+    explicit WallpaperCache(qint64 maxBytes = 128ll * 1024 * 1024);
+
+    static QByteArray key(const QString &path, const QSize &targetSize, qreal dpr, const QString &mode);
+
+    // Kayıt yoksa null QImage döner; dönen görüntü salt okunur bir eşlemedir
+    QImage lookup(const QByteArray &key) const;
+    bool store(const QByteArray &key, const QImage &image);
+
+    QString directory() const { return m_directory; }
+    qint64 maxBytes() const { return m_maxBytes; }
+
+private:
+    QString filePath(const QByteArray &key) const;
+    void evict();
+
+    QString m_directory;
+    qint64 m_maxBytes;
+    QMutex m_evictMutex;
+};
+
+#endif // WALLPAPERCACHE_H
@@ -0,0 +1,342 @@
+#include "wallpaperloader.h"
+#include <QImageReader>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QMetaObject>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QPainter>
+#include <QDebug>
+
+namespace {
+
+// Duvar kağıdı yokken ve Fit/Center modlarında boş kalan alanın rengi
+const QColor BackgroundColor(40, 40, 40);
+
+// Hedefleri karşılamak için kaynağın en az ne kadar ölçekle çözümlenmesi gerektiği
+qreal requiredScale(const QSize &original, WallpaperMode mode, const QSize &spanSize,
+                    const QVector<WallpaperTarget> &targets)
+{
+    if (original.isEmpty()) {
+        return 1.0;
+    }
+
+    const qreal sw = original.width();
+    const qreal sh = original.height();
+    qreal scale = 0.0;
+
+    switch (mode) {
+    case WallpaperMode::Center:
+        return 1.0;
+    case WallpaperMode::Span: {
+        // Yayılmış görüntü aygıt pikseliyle örneklenir; en yüksek DPR belirleyicidir
+        qreal dpr = 1.0;
+        for (const WallpaperTarget &target : targets) {
+            dpr = qMax(dpr, target.dpr);
+        }
+        scale = qMax(spanSize.width() * dpr / sw, spanSize.height() * dpr / sh);
+        break;
+    }
+    default:
+        for (const WallpaperTarget &target : targets) {
+            const qreal fx = target.size.width() / sw;
+            const qreal fy = target.size.height() / sh;
+            scale = qMax(scale, mode == WallpaperMode::Fit ? qMin(fx, fy) : qMax(fx, fy));
+        }
+        break;
+    }
+
+    return qMin(scale, 1.0);
+}
+
+// Center modunda kaynaktan okunan bölge: en büyük hedefin göreceği ortadaki alan
+QSize centerVisibleSize(const QSize &original, const QVector<WallpaperTarget> &targets)
+{
+    QSize visible;
+    for (const WallpaperTarget &target : targets) {
+        visible = visible.expandedTo(target.size);
+    }
+    return visible.boundedTo(original);
+}
+
+QImage toDisplayFormat(const QImage &image)
+{
+    // Boyama sırasında dönüştürme yapılmaması için ekran dostu biçime çevir
+    if (image.format() == QImage::Format_RGB32 || image.format() == QImage::Format_ARGB32_Premultiplied) {
+        return image;
+    }
+    return image.convertToFormat(image.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied
+                                                         : QImage::Format_RGB32);
+}
+
+QImage centeredOnBackground(const QImage &image, const QSize &size)
+{
+    QImage canvas(size, QImage::Format_RGB32);
+    canvas.fill(BackgroundColor);
+
+    QPainter painter(&canvas);
+    painter.drawImage((size.width() - image.width()) / 2, (size.height() - image.height()) / 2, image);
+    painter.end();
+
+    return canvas;
+}
+
+} // namespace
+
+WallpaperMode wallpaperModeFromString(const QString &name)
+{
+    if (name == "fit") return WallpaperMode::Fit;
+    if (name == "center") return WallpaperMode::Center;
+    if (name == "span") return WallpaperMode::Span;
+    if (name == "stretch") return WallpaperMode::Stretch;
+    return WallpaperMode::Fill;
+}
+
+QString wallpaperModeToString(WallpaperMode mode)
+{
+    switch (mode) {
+    case WallpaperMode::Fit: return "fit";
+    case WallpaperMode::Center: return "center";
+    case WallpaperMode::Span: return "span";
+    case WallpaperMode::Stretch: return "stretch";
+    case WallpaperMode::Fill: break;
+    }
+    return "fill";
+}
+
+// Tek bir çözümleme işi; kaynağı bir kez açar, her hedef için ayrı kopya üretir
+// ve sonuçları kuyruklu çağrı ile GUI iş parçacığına aktarır
+class WallpaperDecodeJob : public QRunnable
+{
+public:
+    WallpaperDecodeJob(WallpaperLoader *loader, int generation, const QString &path, WallpaperMode mode,
+                       const QSize &spanSize, const QVector<WallpaperTarget> &targets)
+        : m_loader(loader), m_generation(generation), m_path(path), m_mode(mode)
+        , m_spanSize(spanSize), m_targets(targets)
+    {
+    }
+
+    void run() override
+    {
+        // Bu arada daha yeni bir istek geldiyse boşuna çözümleme yapma
+        if (isStale()) {
+            return;
+        }
+
+        const QImage source = sharedSource();
+        if (source.isNull()) {
+            deliverFailure();
+            return;
+        }
+
+        for (const WallpaperTarget &target : m_targets) {
+            if (isStale()) {
+                return;
+            }
+
+            QImage image = WallpaperLoader::render(source, m_mode, m_spanSize, target);
+
+            // Bir sonraki açılışta JPEG çözümlemesi tamamen atlanır
+            m_loader->m_cache.store(WallpaperLoader::cacheKey(m_path, m_mode, m_spanSize, target), image);
+            deliver(target.id, image);
+        }
+    }
+
+private:
+    bool isStale() const
+    {
+        return m_loader->m_generation.loadAcquire() != m_generation;
+    }
+
+    QImage sharedSource()
+    {
+        // Aynı dosya ve mod için önceki kaynak yeterince büyükse yeniden çözümleme yok
+        QFileInfo fileInfo(m_path);
+        const QString key = fileInfo.absoluteFilePath() + '|'
+                            + QString::number(fileInfo.lastModified().toMSecsSinceEpoch()) + '|'
+                            + wallpaperModeToString(m_mode);
+
+        QImageReader reader(m_path);
+        reader.setAutoTransform(true);
+        // Center modunda kaynak kırpılarak okunur; yalnızca görünen bölge gerekir
+        const QSize needed = m_mode == WallpaperMode::Center
+                             ? centerVisibleSize(reader.size(), m_targets)
+                             : reader.size() * requiredScale(reader.size(), m_mode, m_spanSize, m_targets);
+
+        if (m_loader->m_sourceKey == key && !m_loader->m_source.isNull()
+            && m_loader->m_source.width() >= needed.width()
+            && m_loader->m_source.height() >= needed.height()) {
+            return m_loader->m_source;
+        }
+
+        m_loader->m_source = QImage();
+        m_loader->m_source = WallpaperLoader::decode(m_path, m_mode, m_spanSize, m_targets);
+        m_loader->m_sourceKey = m_loader->m_source.isNull() ? QString() : key;
+        return m_loader->m_source;
+    }
+
+    void deliver(int targetId, const QImage &image)
+    {
+        WallpaperLoader *loader = m_loader;
+        const int generation = m_generation;
+        const QString path = m_path;
+        QMetaObject::invokeMethod(loader, [loader, generation, path, targetId, image]() {
+            if (loader->m_generation.loadAcquire() == generation) {
+                emit loader->wallpaperReady(path, targetId, image);
+            }
+        }, Qt::QueuedConnection);
+    }
+
+    void deliverFailure()
+    {
+        WallpaperLoader *loader = m_loader;
+        const int generation = m_generation;
+        const QString path = m_path;
+        QMetaObject::invokeMethod(loader, [loader, generation, path]() {
+            if (loader->m_generation.loadAcquire() == generation) {
+                emit loader->wallpaperFailed(path);
+            }
+        }, Qt::QueuedConnection);
+    }
+
+    WallpaperLoader *m_loader;
+    int m_generation;
+    QString m_path;
+    WallpaperMode m_mode;
+    QSize m_spanSize;
+    QVector<WallpaperTarget> m_targets;
+};
+
+WallpaperLoader::WallpaperLoader(QObject *parent)
+    : QObject(parent)
+    , m_pool(new QThreadPool(this))
+    , m_generation(0)
+{
+    // Aynı anda tek çözümleme: tepe bellek kullanımı tek görüntüyle sınırlı kalır
+    m_pool->setMaxThreadCount(1);
+}
+
+WallpaperLoader::~WallpaperLoader()
+{
+    cancel();
+    m_pool->waitForDone();
+}
+
+void WallpaperLoader::load(const QString &path, WallpaperMode mode, const QSize &spanSize,
+                           const QVector<WallpaperTarget> &targets)
+{
+    const int generation = m_generation.fetchAndAddOrdered(1) + 1;
+
+    m_pool->clear();
+    if (!targets.isEmpty()) {
+        m_pool->start(new WallpaperDecodeJob(this, generation, path, mode, spanSize, targets));
+    }
+}
+
+void WallpaperLoader::cancel()
+{
+    m_generation.fetchAndAddOrdered(1);
+    m_pool->clear();
+}
+
+QByteArray WallpaperLoader::cacheKey(const QString &path, WallpaperMode mode, const QSize &spanSize,
+                                     const WallpaperTarget &target)
+{
+    QString modeKey = wallpaperModeToString(mode);
+    if (mode == WallpaperMode::Span) {
+        // Yayılmış görüntüde her ekranın kesiti sanal masaüstü düzenine bağlıdır
+        modeKey += QString("@%1x%2+%3+%4/%5x%6")
+                   .arg(target.spanRect.width()).arg(target.spanRect.height())
+                   .arg(target.spanRect.x()).arg(target.spanRect.y())
+                   .arg(spanSize.width()).arg(spanSize.height());
+    }
+    return WallpaperCache::key(path, target.size, target.dpr, modeKey);
+}
+
+QImage WallpaperLoader::cached(const QString &path, WallpaperMode mode, const QSize &spanSize,
+                               const WallpaperTarget &target) const
+{
+    return m_cache.lookup(cacheKey(path, mode, spanSize, target));
+}
+
+QImage WallpaperLoader::decode(const QString &path, WallpaperMode mode, const QSize &spanSize,
+                               const QVector<WallpaperTarget> &targets)
+{
+    QImageReader reader(path);
+    reader.setAutoTransform(true);
+
+    const QSize sourceSize = reader.size();
+    const qreal scale = requiredScale(sourceSize, mode, spanSize, targets);
+
+    if (sourceSize.isValid() && mode == WallpaperMode::Center) {
+        // Ortalanmış görüntüde yalnızca en büyük ekranın göreceği bölge okunur
+        const QSize visible = centerVisibleSize(sourceSize, targets);
+        reader.setClipRect(QRect(QPoint((sourceSize.width() - visible.width()) / 2,
+                                        (sourceSize.height() - visible.height()) / 2), visible));
+    } else if (sourceSize.isValid() && scale < 1.0) {
+        const QSize scaledSize = (QSizeF(sourceSize) * scale).toSize().expandedTo(QSize(1, 1));
+        if (!reader.supportsOption(QImageIOHandler::ScaledSize)
+            && qint64(sourceSize.width()) * sourceSize.height() * 4 > MaxFullDecodeBytes) {
+            // Ölçekli okuma yoksa tam görüntü bellekte açılırdı; sınırı aşanı reddet
+            qWarning() << "Duvar kağıdı çok büyük, atlandı:" << path << sourceSize;
+            return QImage();
+        }
+        // JPEG gibi biçimler doğrudan hedef boyutta çözümlenir (DCT ölçekleme)
+        reader.setScaledSize(scaledSize);
+    } else if (sourceSize.isValid()
+               && qint64(sourceSize.width()) * sourceSize.height() * 4 > MaxFullDecodeBytes) {
+        qWarning() << "Duvar kağıdı çok büyük, atlandı:" << path << sourceSize;
+        return QImage();
+    }
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qWarning() << "Duvar kağıdı çözümlenemedi:" << path << reader.errorString();
+        return QImage();
+    }
+
+    return toDisplayFormat(image);
+}
+
+QImage WallpaperLoader::render(const QImage &source, WallpaperMode mode, const QSize &spanSize,
+                               const WallpaperTarget &target)
+{
+    const QSize size = target.size;
+    QImage image;
+
+    switch (mode) {
+    case WallpaperMode::Stretch:
+        image = source.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        break;
+    case WallpaperMode::Fit:
+        image = centeredOnBackground(source.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation), size);
+        break;
+    case WallpaperMode::Center:
+        image = centeredOnBackground(source, size);
+        break;
+    case WallpaperMode::Span: {
+        // Kaynak tüm masaüstünü kaplayacak biçimde ortalanır; bu ekranın kesiti
+        // kaynak pikseline çevrilip doğrudan aygıt boyutuna ölçeklenir. Tüm
+        // görüntü mantıksal boyuta indirilmediğinden HiDPI ekranlar keskin kalır.
+        const qreal ratio = qMin(source.width() / qreal(spanSize.width()),
+                                 source.height() / qreal(spanSize.height()));
+        const QPointF offset((source.width() - spanSize.width() * ratio) / 2,
+                             (source.height() - spanSize.height() * ratio) / 2);
+        const QRectF area(offset + QPointF(target.spanRect.topLeft()) * ratio,
+                          QSizeF(target.spanRect.size()) * ratio);
+        image = source.copy(area.toAlignedRect().intersected(source.rect()));
+        if (image.size() != size) {
+            image = image.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        }
+        break;
+    }
+    case WallpaperMode::Fill: {
+        const QImage expanded = source.scaled(size, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+        image = expanded.copy((expanded.width() - size.width()) / 2, (expanded.height() - size.height()) / 2,
+                              size.width(), size.height());
+        break;
+    }
+    }
+
+    return toDisplayFormat(image);
+}
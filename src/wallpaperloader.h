@@ -0,0 +1,81 @@
+#ifndef WALLPAPERLOADER_H
+#define WALLPAPERLOADER_H
+
+#include <QObject>
+#include <QImage>
+#include <QSize>
+#include <QRect>
+#include <QString>
+#include <QVector>
+#include <QAtomicInt>
+#include "wallpapercache.h"
+
+class QThreadPool;
+
+// Duvar kağıdının ekrana yerleştirilme biçimi
+enum class WallpaperMode {
+    Fill,    // Oranı koruyarak ekranı doldur, taşanı kırp
+    Fit,     // Oranı koruyarak ekrana sığdır, kenarlar boş kalır
+    Center,  // Ölçeklemeden ortala
+    Span,    // Tek görüntüyü tüm ekranlara yay
+    Stretch  // Oranı yok sayarak ger
+};
+
+WallpaperMode wallpaperModeFromString(const QString &name);
+QString wallpaperModeToString(WallpaperMode mode);
+
+// Tek bir ekran yüzeyi için çizim hedefi (boyutlar aygıt pikseli cinsinden)
+struct WallpaperTarget {
+    int id;
+    QSize size;
+    qreal dpr;
+    QRect spanRect; // Span modunda sanal masaüstündeki konum
+};
+
+// Duvar kağıdını GUI iş parçacığı dışında çözümler. Aynı kaynak tüm ekranlar
+// için bir kez çözümlenir, her ekrana kendi ölçeklenmiş kopyası üretilir.
+class WallpaperLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit WallpaperLoader(QObject *parent = nullptr);
+    ~WallpaperLoader();
+
+    // Yeni bir çözümleme isteği başlatır; bekleyen eski istekler geçersiz olur
+    void load(const QString &path, WallpaperMode mode, const QSize &spanSize,
+              const QVector<WallpaperTarget> &targets);
+    void cancel();
+
+    // Disk önbelleğinde hazır kayıt varsa çözümleme yapmadan döndürür
+    QImage cached(const QString &path, WallpaperMode mode, const QSize &spanSize,
+                  const WallpaperTarget &target) const;
+
+    // Kaynak görüntü bu sınırı aşarsa ve ölçekli okuma desteklenmiyorsa reddedilir
+    static constexpr qint64 MaxFullDecodeBytes = 256ll * 1024 * 1024;
+
+    static QImage decode(const QString &path, WallpaperMode mode, const QSize &spanSize,
+                         const QVector<WallpaperTarget> &targets);
+    static QImage render(const QImage &source, WallpaperMode mode, const QSize &spanSize,
+                         const WallpaperTarget &target);
+
+signals:
+    void wallpaperReady(const QString &path, int targetId, const QImage &image);
+    void wallpaperFailed(const QString &path);
+
+private:
+    friend class WallpaperDecodeJob;
+
+    static QByteArray cacheKey(const QString &path, WallpaperMode mode, const QSize &spanSize,
+                               const WallpaperTarget &target);
+
+    QThreadPool *m_pool;
+    QAtomicInt m_generation;
+    WallpaperCache m_cache;
+
+    // Yalnızca çözümleme iş parçacığından erişilir
+    QString m_sourceKey;
+    QImage m_source;
+};
+
+#endif // WALLPAPERLOADER_H
@@ -0,0 +1,197 @@
+#include "windowgroupmodel.h"
+#include "windowlistmodel.h"
+#include "windowtracker.h"
+#include <QFileInfo>
+#include <QStringList>
+
+WindowGroupModel::WindowGroupModel(WindowListModel *source, QObject *parent)
+    : QAbstractListModel(parent)
+    , m_source(source)
+{
+    connect(m_source, &QAbstractItemModel::rowsAboutToBeRemoved, this, &WindowGroupModel::sourceRowsAboutToBeRemoved);
+    connect(m_source, &QAbstractItemModel::rowsInserted, this, &WindowGroupModel::sourceRowsInserted);
+    connect(m_source, &QAbstractItemModel::dataChanged, this, &WindowGroupModel::sourceDataChanged);
+
+    for (int row = 0; row < m_source->rowCount(); ++row) {
+        const xcb_window_t window = m_source->window(row);
+        insertWindow(window, keyFor(window));
+    }
+}
+
+int WindowGroupModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_groups.size();
+}
+
+xcb_window_t WindowGroupModel::window(int row) const
+{
+    if (row < 0 || row >= m_groups.size()) {
+        return XCB_WINDOW_NONE;
+    }
+
+    const QVector<xcb_window_t> &windows = m_groups.at(row).windows;
+    const xcb_window_t active = m_source->tracker()->activeWindow();
+    return windows.contains(active) ? active : windows.last();
+}
+
+int WindowGroupModel::rowOf(xcb_window_t window) const
+{
+    auto it = m_keyOf.constFind(window);
+    return it == m_keyOf.constEnd() ? -1 : m_rowOfKey.value(it.value(), -1);
+}
+
+QVariant WindowGroupModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_groups.size()) {
+        return QVariant();
+    }
+
+    const WindowTracker *tracker = m_source->tracker();
+    const QVector<xcb_window_t> &windows = m_groups.at(index.row()).windows;
+    const xcb_window_t representative = window(index.row());
+
+    switch (role) {
+    case Qt::DisplayRole: {
+        const WindowInfo info = tracker->info(representative);
+        if (windows.size() == 1) {
+            return info.title;
+        }
+        const QString name = info.wmClass.isEmpty() ? info.title : info.wmClass;
+        return QString("%1 (%2)").arg(name).arg(windows.size());
+    }
+    case Qt::ToolTipRole: {
+        QStringList titles;
+        for (xcb_window_t window : windows) {
+            titles.append(tracker->info(window).title);
+        }
+        return titles.join('\n');
+    }
+    case WindowListModel::WindowRole:
+        return uint(representative);
+    case WindowListModel::IconHashRole:
+        return tracker->info(representative).iconHash;
+    case WindowListModel::ActiveRole:
+        return windows.contains(tracker->activeWindow());
+    case WindowListModel::AttentionRole:
+        for (xcb_window_t window : windows) {
+            if (tracker->info(window).demandsAttention) {
+                return true;
+            }
+        }
+        return false;
+    case CountRole:
+        return windows.size();
+    default:
+        return QVariant();
+    }
+}
+
+QString WindowGroupModel::keyFor(xcb_window_t window) const
+{
+    const WindowInfo info = m_source->tracker()->info(window);
+    if (!info.wmClass.isEmpty()) {
+        return QLatin1String("class:") + info.wmClass.toLower();
+    }
+
+    // WM_CLASS koymayan istemciler için sürecin çalıştırılabilir dosyası
+    if (info.pid != 0) {
+        const QString executable = QFileInfo(QString("/proc/%1/exe").arg(info.pid)).symLinkTarget();
+        if (!executable.isEmpty()) {
+            return QLatin1String("exe:") + executable;
+        }
+    }
+
+    // Tanınamayan pencereler kendi başına bir grup olur
+    return QLatin1String("window:") + QString::number(window);
+}
+
+void WindowGroupModel::insertWindow(xcb_window_t window, const QString &key)
+{
+    m_keyOf.insert(window, key);
+
+    const int row = m_rowOfKey.value(key, -1);
+    if (row >= 0) {
+        m_groups[row].windows.append(window);
+        emit dataChanged(index(row), index(row));
+        return;
+    }
+
+    // Yeni gruplar sona eklenir; mevcut satırların numarası değişmez
+    const int newRow = m_groups.size();
+    beginInsertRows(QModelIndex(), newRow, newRow);
+    m_groups.append(Group{ key, { window } });
+    m_rowOfKey.insert(key, newRow);
+    endInsertRows();
+}
+
+void WindowGroupModel::removeWindow(xcb_window_t window)
+{
+    const QString key = m_keyOf.take(window);
+    const int row = m_rowOfKey.value(key, -1);
+    if (row < 0) {
+        return;
+    }
+
+    QVector<xcb_window_t> &windows = m_groups[row].windows;
+    windows.removeOne(window);
+    if (!windows.isEmpty()) {
+        emit dataChanged(index(row), index(row));
+        return;
+    }
+
+    beginRemoveRows(QModelIndex(), row, row);
+    m_groups.remove(row);
+    m_rowOfKey.remove(key);
+    reindex(row);
+    endRemoveRows();
+}
+
+void WindowGroupModel::reindex(int from)
+{
+    for (int row = from; row < m_groups.size(); ++row) {
+        m_rowOfKey[m_groups.at(row).key] = row;
+    }
+}
+
+void WindowGroupModel::sourceRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last)
+{
+    Q_UNUSED(parent);
+
+    for (int row = first; row <= last; ++row) {
+        removeWindow(m_source->window(row));
+    }
+}
+
+void WindowGroupModel::sourceRowsInserted(const QModelIndex &parent, int first, int last)
+{
+    Q_UNUSED(parent);
+
+    for (int row = first; row <= last; ++row) {
+        const xcb_window_t window = m_source->window(row);
+        insertWindow(window, keyFor(window));
+    }
+}
+
+void WindowGroupModel::sourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight,
+                                         const QVector<int> &roles)
+{
+    // Yalnızca etkin pencere değiştiyse grup anahtarı yeniden hesaplanmaz
+    const bool activeOnly = roles.size() == 1 && roles.first() == WindowListModel::ActiveRole;
+
+    for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+        const xcb_window_t window = m_source->window(row);
+
+        // WM_CLASS pencere eşlendikten sonra da yazılabilir: grup değiştiyse taşınır
+        const QString key = activeOnly ? m_keyOf.value(window) : keyFor(window);
+        if (key != m_keyOf.value(window)) {
+            removeWindow(window);
+            insertWindow(window, key);
+            continue;
+        }
+
+        const int groupRow = m_rowOfKey.value(key, -1);
+        if (groupRow >= 0) {
+            emit dataChanged(index(groupRow), index(groupRow));
+        }
+    }
+}
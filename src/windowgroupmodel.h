@@ -0,0 +1,60 @@
+#ifndef WINDOWGROUPMODEL_H
+#define WINDOWGROUPMODEL_H
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QVector>
+#include <xcb/xcb.h>
+
+class WindowListModel;
+
+// Pencereleri uygulamaya göre gruplar: anahtar WM_CLASS sınıfıdır, yoksa
+// _NET_WM_PID sürecinin çalıştırılabilir dosyası. Her satır bir gruptur.
+// Üyelik karma tablolarda tutulur ve kaynak modelin satır olaylarıyla
+// artımlı güncellenir; hiçbir değişiklikte tüm pencereler yeniden taranmaz.
+class WindowGroupModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum Roles {
+        CountRole = Qt::UserRole + 100  // int, gruptaki pencere sayısı
+    };
+
+    explicit WindowGroupModel(WindowListModel *source, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    // WindowListModel rolleri grubun temsilci penceresi için yanıtlanır;
+    // ActiveRole ve AttentionRole herhangi bir üye için doğruysa doğrudur
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    // Temsilci pencere: etkin üye varsa o, yoksa en son açılan
+    xcb_window_t window(int row) const;
+    QVector<xcb_window_t> windows(int row) const { return m_groups.value(row).windows; }
+    QString groupKey(int row) const { return m_groups.value(row).key; }
+    // Pencerenin bulunduğu grubun satırı
+    int rowOf(xcb_window_t window) const;
+
+private slots:
+    void sourceRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last);
+    void sourceRowsInserted(const QModelIndex &parent, int first, int last);
+    void sourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles);
+
+private:
+    struct Group {
+        QString key;
+        QVector<xcb_window_t> windows;
+    };
+
+    QString keyFor(xcb_window_t window) const;
+    void insertWindow(xcb_window_t window, const QString &key);
+    void removeWindow(xcb_window_t window);
+    void reindex(int from);
+
+    WindowListModel *m_source;
+    QVector<Group> m_groups;
+    QHash<QString, int> m_rowOfKey;
+    QHash<xcb_window_t, QString> m_keyOf;
+};
+
+#endif // WINDOWGROUPMODEL_H
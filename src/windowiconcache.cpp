@@ -0,0 +1,156 @@
+#include "windowiconcache.h"
+#include "windowtracker.h"
+#include <QPixmap>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// Paylaşılan simgeler için bütçe (kilobayt)
+const int SharedBudgetKB = 4 * 1024;
+
+// Bozuk ya da kötü niyetli verilere karşı üst sınır
+const quint32 MaxIconDimension = 1024;
+
+} // namespace
+
+WindowIconCache::WindowIconCache()
+{
+    m_shared.setMaxCost(SharedBudgetKB);
+}
+
+quint64 WindowIconCache::contentHash(const QByteArray &data)
+{
+    if (data.isEmpty()) {
+        return 0;
+    }
+    return (quint64(data.size()) << 32) | qHashBits(data.constData(), size_t(data.size()));
+}
+
+QIcon WindowIconCache::icon(const WindowInfo &info, int size)
+{
+    if (info.iconHash == 0) {
+        m_windows.remove(info.id);
+        return QIcon();
+    }
+
+    // Tarayıcılar her sekme değişiminde aynı simgeyi yeniden yazar: özet aynıysa iş yok
+    Entry &entry = m_windows[info.id];
+    if (entry.hash != info.iconHash) {
+        entry.hash = info.iconHash;
+        entry.icons.clear();
+    } else {
+        auto it = entry.icons.constFind(size);
+        if (it != entry.icons.constEnd()) {
+            return *it;
+        }
+    }
+
+    const quint64 sharedKey = info.iconHash ^ (quint64(size) * Q_UINT64_C(0x9e3779b97f4a7c15));
+    QIcon icon;
+    if (QIcon *shared = m_shared.object(sharedKey)) {
+        icon = *shared;
+    } else {
+        const QImage image = decode(info.iconData, size);
+        if (!image.isNull()) {
+            icon = QIcon(QPixmap::fromImage(image));
+            m_shared.insert(sharedKey, new QIcon(icon), qMax(1, int(image.sizeInBytes() / 1024)));
+        }
+    }
+
+    entry.icons.insert(size, icon);
+    return icon;
+}
+
+QImage WindowIconCache::decode(const QByteArray &data, int size)
+{
+    // Biçim: genişlik, yükseklik, genişlik*yükseklik piksel; ardından sonraki boyut
+    const quint32 *values = reinterpret_cast<const quint32 *>(data.constData());
+    const qint64 count = data.size() / qint64(sizeof(quint32));
+
+    qint64 bestOffset = -1;
+    quint32 bestWidth = 0;
+    quint32 bestHeight = 0;
+    qint64 offset = 0;
+    while (offset + 2 <= count) {
+        const quint32 width = values[offset];
+        const quint32 height = values[offset + 1];
+        if (width == 0 || height == 0 || width > MaxIconDimension || height > MaxIconDimension
+            || qint64(width) * height > count - offset - 2) {
+            break;
+        }
+
+        const quint32 extent = qMax(width, height);
+        const quint32 bestExtent = qMax(bestWidth, bestHeight);
+        const bool fits = extent >= quint32(size);
+        const bool bestFits = bestExtent >= quint32(size);
+        // Yeterince büyük olanlardan en küçüğü; hiçbiri yetmiyorsa en büyüğü
+        if (bestOffset < 0 || (fits && (!bestFits || extent < bestExtent)) || (!fits && !bestFits && extent > bestExtent)) {
+            bestOffset = offset + 2;
+            bestWidth = width;
+            bestHeight = height;
+        }
+
+        offset += 2 + qint64(width) * height;
+    }
+
+    if (bestOffset < 0) {
+        return QImage();
+    }
+
+    // 32 bit biçimde satırlar arasında dolgu yoktur; tek çağrıda dönüştürülür
+    QImage image(int(bestWidth), int(bestHeight), QImage::Format_ARGB32_Premultiplied);
+    if (image.isNull()) {
+        return QImage();
+    }
+    premultiply(values + bestOffset, reinterpret_cast<quint32 *>(image.bits()), int(bestWidth * bestHeight));
+    return image;
+}
+
+void WindowIconCache::premultiply(const quint32 *src, quint32 *dst, int count)
+{
+    int i = 0;
+
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_set1_epi32(int(0xff000000));
+    const __m128i half = _mm_set1_epi16(0x80);
+
+    for (; i + 4 <= count; i += 4) {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        const __m128i alpha = _mm_and_si128(pixels, alphaMask);
+
+        // Simgelerin çoğu tamamen opak ya da tamamen saydam bloklardan oluşur
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, alphaMask)) == 0xffff) {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), pixels);
+            continue;
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, zero)) == 0xffff) {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), zero);
+            continue;
+        }
+
+        // Kanallar 16 bite açılır, her pikselin alfası kendi kanallarına yayılır
+        __m128i lo = _mm_unpacklo_epi8(pixels, zero);
+        __m128i hi = _mm_unpackhi_epi8(pixels, zero);
+        const __m128i alphaLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        const __m128i alphaHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+        // x * a / 255, qPremultiply ile aynı yuvarlama: (t + (t >> 8) + 128) >> 8
+        lo = _mm_mullo_epi16(lo, alphaLo);
+        hi = _mm_mullo_epi16(hi, alphaHi);
+        lo = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), half), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), half), 8);
+
+        // Alfa kanalı çarpılmadan korunur
+        const __m128i result = _mm_or_si128(_mm_andnot_si128(alphaMask, _mm_packus_epi16(lo, hi)), alpha);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), result);
+    }
+#endif
+
+    for (; i < count; ++i) {
+        dst[i] = qPremultiply(src[i]);
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef WINDOWICONCACHE_H
+#define WINDOWICONCACHE_H
+
+#include <QCache>
+#include <QHash>
+#include <QIcon>
+#include <QImage>
+#include <xcb/xcb.h>
+
+struct WindowInfo;
+
+// _NET_WM_ICON verisinden pencere simgeleri. Ham CARDINAL dizisindeki
+// boyutlar arasından istenene en uygunu seçilir ve tek geçişte
+// önçarpımlı ARGB'ye dönüştürülür (SSE2 varsa dörder piksel). Sonuçlar
+// pencere başına, her istenen boyut için ayrı tutulur (düğme ve menü
+// boyutları birbirini silmez): piksel verisi aynı kaldıkça yeniden çözme
+// ya da yeni piksel haritası yüklemesi yapılmaz. Aynı
+// simgeyi taşıyan pencereler (ör. onlarca terminal) tek kopyayı paylaşır.
+class WindowIconCache
+{
+public:
+    WindowIconCache();
+
+    // Pencerenin simgesi; size fiziksel piksel cinsindendir. Simge yoksa boş QIcon
+    QIcon icon(const WindowInfo &info, int size);
+    void remove(xcb_window_t window) { m_windows.remove(window); }
+
+    // İçerik özeti: uzunluk üst 32 bitte, verinin özeti alt 32 bitte
+    static quint64 contentHash(const QByteArray &data);
+    // size'a eşit ya da ondan büyük en küçük görüntü, yoksa en büyüğü
+    static QImage decode(const QByteArray &data, int size);
+    // Önçarpımsız ARGB32'den önçarpımlı ARGB32'ye
+    static void premultiply(const quint32 *src, quint32 *dst, int count);
+
+private:
+    struct Entry {
+        quint64 hash = 0;
+        QHash<int, QIcon> icons;   // Boyut -> simge; özet değişince boşaltılır
+    };
+
+    QHash<xcb_window_t, Entry> m_windows;
+    QCache<quint64, QIcon> m_shared;
+};
+
+#endif // WINDOWICONCACHE_H
@@ -0,0 +1,120 @@
+#include "windowlistmodel.h"
+#include "windowtracker.h"
+
+WindowListModel::WindowListModel(WindowTracker *tracker, QObject *parent)
+    : QAbstractListModel(parent)
+    , m_tracker(tracker)
+    , m_activeWindow(tracker->activeWindow())
+{
+    connect(m_tracker, &WindowTracker::windowAdded, this, &WindowListModel::addWindow);
+    connect(m_tracker, &WindowTracker::windowRemoved, this, &WindowListModel::removeWindow);
+    connect(m_tracker, &WindowTracker::windowChanged, this, &WindowListModel::updateWindow);
+    connect(m_tracker, &WindowTracker::activeWindowChanged, this, &WindowListModel::setActiveWindow);
+
+    // Zaten açık olan pencereler
+    for (xcb_window_t window : m_tracker->windows()) {
+        if (!m_tracker->info(window).skipTaskbar) {
+            m_rowOf.insert(window, m_rows.size());
+            m_rows.append(window);
+        }
+    }
+}
+
+int WindowListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_rows.size();
+}
+
+QVariant WindowListModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_rows.size()) {
+        return QVariant();
+    }
+
+    const xcb_window_t window = m_rows.at(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+    case Qt::ToolTipRole:
+        return m_tracker->info(window).title;
+    case WindowRole:
+        return uint(window);
+    case IconHashRole:
+        return m_tracker->info(window).iconHash;
+    case ActiveRole:
+        return window == m_activeWindow;
+    case AttentionRole:
+        return m_tracker->info(window).demandsAttention;
+    default:
+        return QVariant();
+    }
+}
+
+void WindowListModel::addWindow(xcb_window_t window)
+{
+    if (m_rowOf.contains(window) || m_tracker->info(window).skipTaskbar) {
+        return;
+    }
+
+    // Yeni pencereler sona eklenir; diğer satırların numarası değişmez
+    const int row = m_rows.size();
+    beginInsertRows(QModelIndex(), row, row);
+    m_rows.append(window);
+    m_rowOf.insert(window, row);
+    endInsertRows();
+}
+
+void WindowListModel::removeWindow(xcb_window_t window)
+{
+    const int row = rowOf(window);
+    if (row < 0) {
+        return;
+    }
+
+    beginRemoveRows(QModelIndex(), row, row);
+    m_rows.remove(row);
+    m_rowOf.remove(window);
+    reindex(row);
+    endRemoveRows();
+}
+
+void WindowListModel::updateWindow(xcb_window_t window)
+{
+    const int row = rowOf(window);
+    const bool skip = m_tracker->info(window).skipTaskbar;
+
+    // Görev çubuğu dışı bırakma durumu değiştiyse satır eklenir ya da çıkarılır
+    if (row < 0) {
+        if (!skip) {
+            addWindow(window);
+        }
+        return;
+    }
+    if (skip) {
+        removeWindow(window);
+        return;
+    }
+
+    const QModelIndex changed = index(row);
+    emit dataChanged(changed, changed);
+}
+
+void WindowListModel::setActiveWindow(xcb_window_t window)
+{
+    const xcb_window_t previous = m_activeWindow;
+    m_activeWindow = window;
+
+    const QVector<int> roles{ ActiveRole };
+    for (xcb_window_t changed : { previous, window }) {
+        const int row = rowOf(changed);
+        if (row >= 0) {
+            emit dataChanged(index(row), index(row), roles);
+        }
+    }
+}
+
+void WindowListModel::reindex(int from)
+{
+    for (int row = from; row < m_rows.size(); ++row) {
+        m_rowOf[m_rows.at(row)] = row;
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef WINDOWLISTMODEL_H
+#define WINDOWLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QVector>
+#include <xcb/xcb.h>
+
+class WindowTracker;
+
+// Görev çubuğunda gösterilecek pencerelerin listesi. WindowTracker
+// olaylarını satır ekleme/silme ve dataChanged bildirimlerine çevirir;
+// _NET_WM_STATE_SKIP_TASKBAR taşıyan pencereler listede yer almaz.
+// Sıra, pencerelerin listeye geliş sırasıdır: açılışta _NET_CLIENT_LIST
+// sırası (EWMH'de ilk eşlenme sırası) alınır, yeni pencereler sona eklenir.
+// Pencere yöneticisi listeyi sonradan yeniden sıralarsa satırlar yer
+// değiştirmez; düğmeler kullanıcının altından kaymaz.
+class WindowListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum Roles {
+        WindowRole = Qt::UserRole + 1,  // xcb_window_t (uint)
+        IconHashRole,                   // quint64
+        ActiveRole,                     // bool
+        AttentionRole                   // bool
+    };
+
+    explicit WindowListModel(WindowTracker *tracker, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    WindowTracker *tracker() const { return m_tracker; }
+    xcb_window_t window(int row) const { return m_rows.value(row, XCB_WINDOW_NONE); }
+    int rowOf(xcb_window_t window) const { return m_rowOf.value(window, -1); }
+
+private slots:
+    void addWindow(xcb_window_t window);
+    void removeWindow(xcb_window_t window);
+    void updateWindow(xcb_window_t window);
+    void setActiveWindow(xcb_window_t window);
+
+private:
+    void reindex(int from);
+
+    WindowTracker *m_tracker;
+    QVector<xcb_window_t> m_rows;
+    QHash<xcb_window_t, int> m_rowOf;
+    xcb_window_t m_activeWindow;
+};
+
+#endif // WINDOWLISTMODEL_H
@@ -0,0 +1,320 @@
+#include "windowthumbnailer.h"
+#include "xconnection.h"
+#include <QThreadPool>
+#include <xcb/composite.h>
+#include <xcb/damage.h>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+// Önizleme görünürken en fazla saniyede 10 kare
+const int FrameInterval = 100;
+
+// Küçük resim önbelleği bütçesi (kilobayt)
+const int ThumbnailBudgetKB = 8 * 1024;
+
+} // namespace
+
+WindowThumbnailer::WindowThumbnailer(QObject *parent)
+    : QObject(parent)
+    , m_connection(nullptr)
+    , m_window(XCB_WINDOW_NONE)
+    , m_damage(XCB_NONE)
+    , m_pixmap(XCB_PIXMAP_NONE)
+    , m_generation(0)
+    , m_namePixmap(false)
+    , m_grabbing(false)
+    , m_alive(XConnection::createAlive())
+    , m_scaler(new QThreadPool(this))
+{
+    m_scaler->setMaxThreadCount(1);
+
+    m_thumbnails.setMaxCost(ThumbnailBudgetKB);
+
+    m_frameTimer.setInterval(FrameInterval);
+    connect(&m_frameTimer, &QTimer::timeout, this, &WindowThumbnailer::updateFrame);
+
+    XConnection *x = XConnection::instance();
+    if (!x->isValid() || !x->hasComposite()) {
+        return;
+    }
+
+    // Damage olayları, nesneyi oluşturan bağlantıya gelir
+    m_connection = x->connection();
+    connect(x, &XConnection::damaged, this, &WindowThumbnailer::damaged);
+}
+
+WindowThumbnailer::~WindowThumbnailer()
+{
+    if (m_connection) {
+        stop();
+    }
+
+    // Kuyruktaki okumalar atlanır; sürmekte olan okuma ve ölçeklemenin sonucu atılır
+    m_alive->store(false);
+    m_scaler->waitForDone();
+}
+
+void WindowThumbnailer::start(xcb_window_t window, const QSize &size)
+{
+    if (!m_connection || size.isEmpty()) {
+        return;
+    }
+    if (window == m_window) {
+        m_thumbnailSize = size;
+        return;
+    }
+
+    stop();
+    m_window = window;
+    m_thumbnailSize = size;
+    ++m_generation;
+
+    // Yanıt beklemeyen istekler; otomatik yönlendirmede sunucu ekrana çizmeye devam eder
+    xcb_composite_redirect_window(m_connection, window, XCB_COMPOSITE_REDIRECT_AUTOMATIC);
+    m_damage = xcb_generate_id(m_connection);
+    xcb_damage_create(m_connection, m_damage, window, XCB_DAMAGE_REPORT_LEVEL_DELTA_RECTANGLES);
+    xcb_flush(m_connection);
+
+    // Son kare hemen gösterilir; canlı kare okuma bitince gelir
+    if (const QImage *cached = m_thumbnails.object(window)) {
+        emit thumbnailUpdated(window, *cached);
+    }
+
+    m_namePixmap = true;
+    updateFrame();
+    m_frameTimer.start();
+}
+
+void WindowThumbnailer::stop()
+{
+    if (m_window == XCB_WINDOW_NONE) {
+        return;
+    }
+
+    m_frameTimer.stop();
+    ++m_generation;
+
+    // Okuma sürüyorsa piksel haritası sonuçla birlikte bırakılır
+    if (m_pixmap != XCB_PIXMAP_NONE) {
+        xcb_free_pixmap(m_connection, m_pixmap);
+    }
+    xcb_damage_destroy(m_connection, m_damage);
+    xcb_composite_unredirect_window(m_connection, m_window, XCB_COMPOSITE_REDIRECT_AUTOMATIC);
+    xcb_flush(m_connection);
+
+    m_damage = XCB_NONE;
+    m_pixmap = XCB_PIXMAP_NONE;
+    m_window = XCB_WINDOW_NONE;
+    m_frame = QImage();
+    m_frameSize = QSize();
+    m_dirty = QRegion();
+    m_namePixmap = false;
+}
+
+QImage WindowThumbnailer::thumbnail(xcb_window_t window) const
+{
+    const QImage *image = m_thumbnails.object(window);
+    return image ? *image : QImage();
+}
+
+void WindowThumbnailer::damaged(uint32_t damage, const QRect &area, const QSize &geometry)
+{
+    if (damage != m_damage || m_window == XCB_WINDOW_NONE) {
+        return;
+    }
+
+    // Boyut değiştiyse ya da pencere yeniden eşlendiyse piksel haritası yeniden adlandırılır
+    if (!m_grabbing && (geometry != m_frameSize || m_pixmap == XCB_PIXMAP_NONE)) {
+        m_namePixmap = true;
+    }
+
+    // Kare zamanlayıcısı çalışırken yalnızca birikir; okuma kare başına bir kez
+    m_dirty += area;
+}
+
+void WindowThumbnailer::updateFrame()
+{
+    if (m_window == XCB_WINDOW_NONE || m_grabbing || (m_dirty.isEmpty() && !m_namePixmap)) {
+        return;
+    }
+
+    Grab grab;
+    grab.window = m_window;
+    grab.damage = m_damage;
+    grab.pixmap = m_pixmap;
+    grab.namePixmap = m_namePixmap;
+    grab.frame = std::move(m_frame);  // Kopyalanmaz; sonuçla geri gelir
+    grab.dirty = m_dirty;
+    grab.thumbnailSize = m_thumbnailSize;
+
+    // Piksel haritası okuma süresince iş parçacığına geçer
+    m_frame = QImage();
+    m_dirty = QRegion();
+    m_namePixmap = false;
+    m_pixmap = XCB_PIXMAP_NONE;
+    m_grabbing = true;
+
+    WindowThumbnailer *thumbnailer = this;
+    const XConnection::Alive alive = m_alive;
+    const quint64 generation = m_generation;
+    // Kare taşınarak aktarılır; tek sahibi olduğundan yazarken kopyalanmaz
+    XConnection::instance()->post([thumbnailer, alive, generation, grab = std::move(grab)](xcb_connection_t *connection) mutable {
+        if (!alive->load()) {
+            // Önizleyici yıkıldı; okuma için devredilen piksel haritası burada bırakılır
+            if (grab.pixmap != XCB_PIXMAP_NONE) {
+                xcb_free_pixmap(connection, grab.pixmap);
+                xcb_flush(connection);
+            }
+            return;
+        }
+        grabFrame(connection, grab);
+        XConnection::instance()->reply(alive, [thumbnailer, generation, grab = std::move(grab)]() {
+            thumbnailer->frameGrabbed(generation, grab);
+        });
+    });
+}
+
+void WindowThumbnailer::frameGrabbed(quint64 generation, const Grab &grab)
+{
+    // Bu arada başka pencereye geçildi ya da önizleme kapandı
+    if (generation != m_generation) {
+        m_grabbing = false;
+        if (grab.pixmap != XCB_PIXMAP_NONE) {
+            xcb_free_pixmap(m_connection, grab.pixmap);
+            xcb_flush(m_connection);
+        }
+        return;
+    }
+
+    m_pixmap = grab.pixmap;
+    m_frameSize = grab.frame.size();
+    if (!grab.ok) {
+        // Pencere eşlenmemiş: son kare geçerliliğini korur, sonraki hasarda yeniden denenir
+        m_frame = grab.frame;
+        m_grabbing = false;
+        return;
+    }
+
+    // Yumuşak ölçekleme olay iş parçacığını tutmasın diye kendi havuzunda yapılır.
+    // Okuma sonuç dönene dek sürer; kare bu arada yazılmadığından kopyalanmaz.
+    WindowThumbnailer *thumbnailer = this;
+    const XConnection::Alive alive = m_alive;
+    const QImage frame = grab.frame;
+    const QSize size = grab.thumbnailSize;
+    m_scaler->start([thumbnailer, alive, generation, frame, size]() {
+        const QImage thumbnail = frame.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        XConnection::instance()->reply(alive, [thumbnailer, generation, frame, thumbnail]() {
+            thumbnailer->frameScaled(generation, frame, thumbnail);
+        });
+    });
+}
+
+void WindowThumbnailer::frameScaled(quint64 generation, const QImage &frame, const QImage &thumbnail)
+{
+    m_grabbing = false;
+    if (generation != m_generation) {
+        return;
+    }
+
+    m_frame = frame;
+    QImage *cached = new QImage(thumbnail);
+    m_thumbnails.insert(m_window, cached, qMax(1, int(cached->sizeInBytes() / 1024)));
+    emit thumbnailUpdated(m_window, thumbnail);
+}
+
+void WindowThumbnailer::grabFrame(xcb_connection_t *connection, Grab &grab)
+{
+    // Hasar, okumadan önce onarılır; okuma sırasında gelen çizimler sonraki kareye kalır
+    xcb_damage_subtract(connection, grab.damage, XCB_NONE, XCB_NONE);
+
+    if ((grab.namePixmap || grab.pixmap == XCB_PIXMAP_NONE) && !nameWindowPixmap(connection, grab)) {
+        return;
+    }
+
+    const QRegion dirty = grab.dirty.intersected(QRect(QPoint(0, 0), grab.frame.size()));
+    for (const QRect &rect : dirty) {
+        if (!grabRect(connection, grab, rect)) {
+            // Pencere bu arada eşlemeden çıktı
+            xcb_free_pixmap(connection, grab.pixmap);
+            grab.pixmap = XCB_PIXMAP_NONE;
+            return;
+        }
+    }
+
+    grab.ok = true;
+}
+
+bool WindowThumbnailer::nameWindowPixmap(xcb_connection_t *connection, Grab &grab)
+{
+    if (grab.pixmap != XCB_PIXMAP_NONE) {
+        xcb_free_pixmap(connection, grab.pixmap);
+        grab.pixmap = XCB_PIXMAP_NONE;
+    }
+
+    xcb_pixmap_t pixmap = xcb_generate_id(connection);
+    xcb_void_cookie_t nameCookie = xcb_composite_name_window_pixmap_checked(connection, grab.window, pixmap);
+    xcb_get_geometry_cookie_t geometryCookie = xcb_get_geometry(connection, pixmap);
+
+    // Eşlenmemiş pencerelerde BadMatch döner
+    xcb_generic_error_t *error = xcb_request_check(connection, nameCookie);
+    xcb_generic_error_t *geometryError = nullptr;
+    xcb_get_geometry_reply_t *geometry = xcb_get_geometry_reply(connection, geometryCookie, &geometryError);
+    if (error || !geometry) {
+        free(error);
+        free(geometryError);
+        free(geometry);
+        if (!error) {
+            xcb_free_pixmap(connection, pixmap);
+        }
+        return false;
+    }
+
+    grab.pixmap = pixmap;
+    const QImage::Format format = geometry->depth == 32 ? QImage::Format_ARGB32_Premultiplied
+                                                        : QImage::Format_RGB32;
+    if (grab.frame.size() != QSize(geometry->width, geometry->height) || grab.frame.format() != format) {
+        grab.frame = QImage(geometry->width, geometry->height, format);
+        grab.frame.fill(Qt::transparent);
+    }
+    free(geometry);
+
+    // Yeni piksel haritası: aradaki değişiklikler bilinmediğinden tamamı okunur
+    grab.dirty = QRect(QPoint(0, 0), grab.frame.size());
+    return true;
+}
+
+bool WindowThumbnailer::grabRect(xcb_connection_t *connection, Grab &grab, const QRect &rect)
+{
+    // Büyük bölgeler istek sınırını aşmayacak satır şeritlerine bölünür
+    const uint32_t maxRequestBytes = xcb_get_maximum_request_length(connection) * 4;
+    const int rowBytes = rect.width() * 4;
+    const int bandHeight = qMax(1, int((maxRequestBytes - 64) / uint32_t(qMax(rowBytes, 1))));
+
+    for (int y = rect.top(); y <= rect.bottom(); y += bandHeight) {
+        const int height = qMin(bandHeight, rect.bottom() - y + 1);
+        xcb_generic_error_t *error = nullptr;
+        xcb_get_image_reply_t *reply = xcb_get_image_reply(
+            connection,
+            xcb_get_image(connection, XCB_IMAGE_FORMAT_Z_PIXMAP, grab.pixmap,
+                          int16_t(rect.x()), int16_t(y), uint16_t(rect.width()), uint16_t(height), ~0u),
+            &error);
+        if (!reply) {
+            free(error);
+            return false;
+        }
+
+        // Yalnızca 32 bit/piksel düzen desteklenir (24 ve 32 derinlikte olağan olan)
+        const uint8_t *data = xcb_get_image_data(reply);
+        if (xcb_get_image_data_length(reply) < rowBytes * height) {
+            free(reply);
+            return false;
+        }
+        for (int row = 0; row < height; ++row) {
+            memcpy(grab.frame.scanLine(y + row) + rect.x() * 4, data + row * rowBytes, size_t(rowBytes));
+        }
+        free(reply);
+    }
+    return true;
+}
@@ -0,0 +1,90 @@
+#ifndef WINDOWTHUMBNAILER_H
+#define WINDOWTHUMBNAILER_H
+
+#include <QObject>
+#include <QCache>
+#include <QImage>
+#include <QRegion>
+#include <QSize>
+#include <QTimer>
+#include <xcb/xcb.h>
+#include "xconnection.h"
+
+class QThreadPool;
+
+// Görev çubuğu üzerine gelindiğinde gösterilen canlı pencere önizlemeleri.
+// Pencere XComposite ile ekran dışına yönlendirilir (otomatik kip; görünen
+// çıktı değişmez), içeriği adlandırılmış piksel haritasından okunur. İlk
+// karede pencere bir kez bütün alınır; sonrasında yalnızca XDamage'ın
+// bildirdiği bölgeler yeniden okunur. Önizleme görünürken güncellemeler
+// sabit kare hızıyla sınırlanır. Eşlenmemiş ya da simge durumundaki
+// pencereler için son alınan kare kullanılır. Görüntü okumaları
+// XConnection'ın iş parçacığında, küçültme kendi iş parçacığı havuzunda yapılır;
+// aynı anda en fazla bir okuma sürer.
+class WindowThumbnailer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit WindowThumbnailer(QObject *parent = nullptr);
+    ~WindowThumbnailer();
+
+    // Sunucuda Composite (>= 0.2) ve Damage yoksa önizleme yapılmaz
+    bool isValid() const { return m_connection != nullptr; }
+
+    // Pencerenin canlı önizlemesini başlatır; aynı anda tek pencere izlenir
+    void start(xcb_window_t window, const QSize &size);
+    void stop();
+    xcb_window_t window() const { return m_window; }
+
+    // Son üretilen küçük resim (pencere kapalı ya da simge durumundaysa da)
+    QImage thumbnail(xcb_window_t window) const;
+    void forget(xcb_window_t window) { m_thumbnails.remove(window); }
+
+signals:
+    void thumbnailUpdated(xcb_window_t window, const QImage &thumbnail);
+
+private slots:
+    void updateFrame();
+    void damaged(uint32_t damage, const QRect &area, const QSize &geometry);
+
+private:
+    // Olay iş parçacığına giden ve oradan dönen kare okuma durumu
+    struct Grab {
+        xcb_window_t window = XCB_WINDOW_NONE;
+        uint32_t damage = 0;
+        xcb_pixmap_t pixmap = XCB_PIXMAP_NONE;
+        bool namePixmap = false;
+        QImage frame;       // Pencerenin tam boyutlu kopyası; okuma sürerken iş parçacığındadır
+        QRegion dirty;
+        QSize thumbnailSize;
+        bool ok = false;
+    };
+
+    static void grabFrame(xcb_connection_t *connection, Grab &grab);
+    static bool nameWindowPixmap(xcb_connection_t *connection, Grab &grab);
+    static bool grabRect(xcb_connection_t *connection, Grab &grab, const QRect &rect);
+    void frameGrabbed(quint64 generation, const Grab &grab);
+    void frameScaled(quint64 generation, const QImage &frame, const QImage &thumbnail);
+
+    xcb_connection_t *m_connection;
+
+    xcb_window_t m_window;
+    uint32_t m_damage;
+    xcb_pixmap_t m_pixmap;
+    QSize m_thumbnailSize;
+    quint64 m_generation;   // Pencere değişince eski okumaların sonucu atılır
+
+    QImage m_frame;
+    QSize m_frameSize;
+    QRegion m_dirty;        // Son kareden bu yana hasar gören bölge
+    bool m_namePixmap;      // Piksel haritası (yeniden) adlandırılmalı
+    bool m_grabbing;       // Okuma ya da ölçekleme sürüyor
+    XConnection::Alive m_alive;
+    QThreadPool *m_scaler; // Küçültme; yıkıcıda beklenir
+    QTimer m_frameTimer;
+
+    QCache<xcb_window_t, QImage> m_thumbnails;
+};
+
+#endif // WINDOWTHUMBNAILER_H
@@ -0,0 +1,478 @@
+#include "windowtracker.h"
+#include "windowiconcache.h"
+#include "xcbpropertybatch.h"
+#include "xconnection.h"
+#include <QX11Info>
+#include <cstring>
+
+namespace {
+
+const char *const AtomNames[] = {
+    "_NET_CLIENT_LIST",
+    "_NET_ACTIVE_WINDOW",
+    "_NET_WM_NAME",
+    "UTF8_STRING",
+    "_NET_WM_STATE",
+    "_NET_WM_STATE_SKIP_TASKBAR",
+    "_NET_WM_STATE_DEMANDS_ATTENTION",
+    "_NET_WM_STATE_HIDDEN",
+    "_NET_WM_PID",
+    "_NET_WM_ICON"
+};
+
+// Simge dizisi için üst sınır (32 bitlik öğe): 256x256 ve birkaç küçük boyut
+const uint32_t MaxIconLength = 256 * 256 * 2;
+
+// _NET_ACTIVE_WINDOW isteğinin kaynağı: 2 = görev çubuğu/sayfalayıcı
+const uint32_t SourceIndicationPager = 2;
+
+} // namespace
+
+WindowTracker::WindowTracker(QObject *parent)
+    : QObject(parent)
+    , m_connection(nullptr)
+    , m_root(XCB_WINDOW_NONE)
+    , m_activeWindow(XCB_WINDOW_NONE)
+    , m_flushScheduled(false)
+    , m_alive(XConnection::createAlive())
+{
+    std::memset(m_atoms, 0, sizeof(m_atoms));
+
+    XConnection *x = XConnection::instance();
+    if (!x->isValid()) {
+        return;
+    }
+
+    m_connection = x->connection();
+    m_root = x->rootWindow();
+
+    internAtoms();
+    x->selectEvents(m_root, XCB_EVENT_MASK_PROPERTY_CHANGE);
+
+    connect(x, &XConnection::propertyChanged, this, &WindowTracker::propertyChanged);
+    connect(x, &XConnection::eventsLost, this, &WindowTracker::refresh);
+
+    updateClientList();
+    updateActiveWindow();
+}
+
+WindowTracker::~WindowTracker()
+{
+    // Kuyruktaki okumalar atlanır, sürmekte olanın sonucu atılır
+    m_alive->store(false);
+}
+
+void WindowTracker::internAtoms()
+{
+    // Açılışta bir kez; tüm istekler önce gönderilir, yanıtlar sonra toplanır
+    xcb_intern_atom_cookie_t cookies[AtomCount];
+    for (int i = 0; i < AtomCount; ++i) {
+        cookies[i] = xcb_intern_atom(m_connection, false, strlen(AtomNames[i]), AtomNames[i]);
+    }
+
+    for (int i = 0; i < AtomCount; ++i) {
+        xcb_intern_atom_reply_t *reply = xcb_intern_atom_reply(m_connection, cookies[i], nullptr);
+        m_atoms[i] = reply ? reply->atom : XCB_ATOM_NONE;
+        free(reply);
+    }
+}
+
+QVector<xcb_window_t> WindowTracker::windows() const
+{
+    // Özellikleri henüz gelmemiş pencereler windowAdded ile bildirilene dek görünmez
+    QVector<xcb_window_t> windows;
+    windows.reserve(m_windows.size());
+    for (xcb_window_t window : m_order) {
+        if (m_windows.contains(window)) {
+            windows.append(window);
+        }
+    }
+    return windows;
+}
+
+void WindowTracker::refresh()
+{
+    // Olay kuyruğu taştı: her şey baştan okunur, farklar sinyal olarak yayılır
+    updateClientList();
+    updateActiveWindow();
+    fetch(windows(), AllFields);
+}
+
+void WindowTracker::updateClientList()
+{
+    WindowTracker *tracker = this;
+    const XConnection::Alive alive = m_alive;
+    const xcb_window_t root = m_root;
+    const xcb_atom_t clientList = m_atoms[NetClientList];
+
+    XConnection::instance()->post(alive, [tracker, alive, root, clientList](xcb_connection_t *connection) {
+        XcbPropertyBatch batch(connection);
+        const int slot = batch.add(root, clientList, XCB_ATOM_WINDOW);
+        batch.fetch();
+
+        const QByteArray data = batch.value(slot);
+        const xcb_window_t *ids = reinterpret_cast<const xcb_window_t *>(data.constData());
+        const QVector<xcb_window_t> windows(ids, ids + data.size() / int(sizeof(xcb_window_t)));
+
+        XConnection::instance()->reply(alive, [tracker, windows]() {
+            tracker->setClientList(windows);
+        });
+    });
+}
+
+void WindowTracker::setClientList(const QVector<xcb_window_t> &windows)
+{
+    QSet<xcb_window_t> present;
+    present.reserve(windows.size());
+    for (xcb_window_t window : windows) {
+        present.insert(window);
+    }
+
+    // Kaybolan pencereler: karma tablo üzerinden O(n) fark
+    XConnection *x = XConnection::instance();
+    for (xcb_window_t window : qAsConst(m_order)) {
+        if (present.contains(window)) {
+            continue;
+        }
+        m_pending.remove(window);
+        m_dirtyFields.remove(window);
+        x->forgetWindow(window);
+        if (m_windows.remove(window)) {
+            emit windowRemoved(window);
+        }
+    }
+
+    m_order = windows;
+    m_present = present;
+
+    QVector<xcb_window_t> added;
+    for (xcb_window_t window : windows) {
+        if (m_windows.contains(window) || m_pending.contains(window)) {
+            continue;
+        }
+
+        // Önce olaylara abone olunur, sonra okunur; aradaki değişiklik kaçmaz
+        x->selectEvents(window, XCB_EVENT_MASK_PROPERTY_CHANGE);
+        m_pending.insert(window);
+        added.append(window);
+    }
+
+    // Yeni pencerelerin tüm özellikleri tek seferde; windowAdded sonuçla birlikte gelir
+    if (!added.isEmpty()) {
+        fetch(added, AllFields);
+    }
+}
+
+void WindowTracker::updateActiveWindow()
+{
+    WindowTracker *tracker = this;
+    const XConnection::Alive alive = m_alive;
+    const xcb_window_t root = m_root;
+    const xcb_atom_t activeWindow = m_atoms[NetActiveWindow];
+
+    XConnection::instance()->post(alive, [tracker, alive, root, activeWindow](xcb_connection_t *connection) {
+        XcbPropertyBatch batch(connection);
+        const int slot = batch.add(root, activeWindow, XCB_ATOM_WINDOW);
+        batch.fetch();
+
+        const QByteArray data = batch.value(slot);
+        xcb_window_t active = XCB_WINDOW_NONE;
+        if (data.size() >= int(sizeof(xcb_window_t))) {
+            std::memcpy(&active, data.constData(), sizeof(active));
+        }
+
+        XConnection::instance()->reply(alive, [tracker, active]() {
+            tracker->setActiveWindow(active);
+        });
+    });
+}
+
+void WindowTracker::setActiveWindow(xcb_window_t window)
+{
+    if (window != m_activeWindow) {
+        m_activeWindow = window;
+        emit activeWindowChanged(window);
+    }
+}
+
+void WindowTracker::fetch(const QVector<xcb_window_t> &windows, int fields)
+{
+    if (windows.isEmpty()) {
+        return;
+    }
+
+    WindowTracker *tracker = this;
+    const XConnection::Alive alive = m_alive;
+    const xcb_atom_t netWmName = m_atoms[NetWmName];
+    const xcb_atom_t utf8String = m_atoms[Utf8String];
+    const xcb_atom_t netWmPid = m_atoms[NetWmPid];
+    const xcb_atom_t netWmState = m_atoms[NetWmState];
+    const xcb_atom_t netWmIcon = m_atoms[NetWmIcon];
+
+    XConnection::instance()->post(alive, [=](xcb_connection_t *connection) {
+        // Pencere başına en fazla altı istek; hepsi yanıt beklenmeden gönderilir
+        struct Slots {
+            int netName = -1;
+            int name = -1;
+            int wmClass = -1;
+            int pid = -1;
+            int state = -1;
+            int icon = -1;
+        };
+
+        XcbPropertyBatch batch(connection);
+        QVector<Slots> requests(windows.size());
+        for (int i = 0; i < windows.size(); ++i) {
+            const xcb_window_t window = windows.at(i);
+            Slots &slot = requests[i];
+            if (fields & TitleField) {
+                slot.netName = batch.add(window, netWmName, utf8String);
+                slot.name = batch.add(window, XCB_ATOM_WM_NAME, XCB_ATOM_STRING);
+            }
+            if (fields & ClassField) {
+                slot.wmClass = batch.add(window, XCB_ATOM_WM_CLASS, XCB_ATOM_STRING);
+            }
+            if (fields & PidField) {
+                slot.pid = batch.add(window, netWmPid, XCB_ATOM_CARDINAL, 1);
+            }
+            if (fields & StateField) {
+                slot.state = batch.add(window, netWmState, XCB_ATOM_ATOM);
+            }
+            if (fields & IconField) {
+                slot.icon = batch.add(window, netWmIcon, XCB_ATOM_CARDINAL, MaxIconLength);
+            }
+        }
+
+        batch.fetch();
+
+        QVector<Properties> properties(windows.size());
+        for (int i = 0; i < windows.size(); ++i) {
+            const Slots &slot = requests.at(i);
+            Properties &values = properties[i];
+            values.window = windows.at(i);
+            if (slot.netName >= 0) {
+                values.netName = batch.value(slot.netName);
+                values.name = batch.value(slot.name);
+            }
+            if (slot.wmClass >= 0) {
+                values.wmClass = batch.value(slot.wmClass);
+            }
+            if (slot.pid >= 0) {
+                values.pid = batch.value(slot.pid);
+            }
+            if (slot.state >= 0) {
+                values.state = batch.value(slot.state);
+            }
+            if (slot.icon >= 0) {
+                values.icon = batch.value(slot.icon);
+            }
+        }
+
+        XConnection::instance()->reply(alive, [tracker, properties, fields]() {
+            tracker->applyProperties(properties, fields);
+        });
+    });
+}
+
+void WindowTracker::applyProperties(const QVector<Properties> &properties, int fields)
+{
+    for (const Properties &values : properties) {
+        // İlk tam okuma pencereyi listeye ekler; bu arada kapandıysa atılır
+        const bool added = fields == AllFields && m_pending.remove(values.window);
+        if (added && !m_present.contains(values.window)) {
+            continue;
+        }
+
+        auto it = m_windows.find(values.window);
+        if (added) {
+            WindowInfo info;
+            info.id = values.window;
+            it = m_windows.insert(values.window, info);
+        } else if (it == m_windows.end()) {
+            continue;
+        }
+
+        WindowInfo &info = it.value();
+        bool modified = false;
+        if (fields & TitleField) {
+            modified |= applyTitle(info, values.netName, values.name);
+        }
+        if (fields & ClassField) {
+            modified |= applyClass(info, values.wmClass);
+        }
+        if (fields & PidField) {
+            modified |= applyPid(info, values.pid);
+        }
+        if (fields & StateField) {
+            modified |= applyState(info, values.state);
+        }
+        if (fields & IconField) {
+            modified |= applyIcon(info, values.icon);
+        }
+
+        if (added) {
+            emit windowAdded(values.window);
+        } else if (modified) {
+            emit windowChanged(values.window);
+        }
+    }
+}
+
+bool WindowTracker::applyTitle(WindowInfo &info, const QByteArray &netName, const QByteArray &name)
+{
+    // _NET_WM_NAME (UTF-8) tercih edilir, yoksa eski WM_NAME kullanılır
+    QString title = QString::fromUtf8(netName);
+    if (title.isEmpty()) {
+        title = QString::fromLocal8Bit(name);
+    }
+
+    if (title == info.title) {
+        return false;
+    }
+    info.title = title;
+    return true;
+}
+
+bool WindowTracker::applyClass(WindowInfo &info, const QByteArray &data)
+{
+    // WM_CLASS: "örnek\0sınıf\0"
+    const QList<QByteArray> parts = data.split('\0');
+    const QString instance = parts.size() > 0 ? QString::fromLocal8Bit(parts.at(0)) : QString();
+    const QString wmClass = parts.size() > 1 ? QString::fromLocal8Bit(parts.at(1)) : QString();
+
+    if (instance == info.wmInstance && wmClass == info.wmClass) {
+        return false;
+    }
+    info.wmInstance = instance;
+    info.wmClass = wmClass;
+    return true;
+}
+
+bool WindowTracker::applyPid(WindowInfo &info, const QByteArray &data)
+{
+    quint32 pid = 0;
+    if (data.size() >= int(sizeof(pid))) {
+        std::memcpy(&pid, data.constData(), sizeof(pid));
+    }
+
+    if (pid == info.pid) {
+        return false;
+    }
+    info.pid = pid;
+    return true;
+}
+
+bool WindowTracker::applyState(WindowInfo &info, const QByteArray &data)
+{
+    const xcb_atom_t *states = reinterpret_cast<const xcb_atom_t *>(data.constData());
+    const int count = data.size() / int(sizeof(xcb_atom_t));
+
+    bool skipTaskbar = false;
+    bool demandsAttention = false;
+    bool hidden = false;
+    for (int i = 0; i < count; ++i) {
+        skipTaskbar = skipTaskbar || states[i] == m_atoms[NetWmStateSkipTaskbar];
+        demandsAttention = demandsAttention || states[i] == m_atoms[NetWmStateDemandsAttention];
+        hidden = hidden || states[i] == m_atoms[NetWmStateHidden];
+    }
+
+    if (skipTaskbar == info.skipTaskbar && demandsAttention == info.demandsAttention && hidden == info.hidden) {
+        return false;
+    }
+    info.skipTaskbar = skipTaskbar;
+    info.demandsAttention = demandsAttention;
+    info.hidden = hidden;
+    return true;
+}
+
+bool WindowTracker::applyIcon(WindowInfo &info, const QByteArray &data)
+{
+    // Aynı pikseller yeniden yazıldığında yalnızca özet hesaplanır
+    const quint64 hash = WindowIconCache::contentHash(data);
+    if (hash == info.iconHash) {
+        return false;
+    }
+    info.iconData = data;
+    info.iconHash = hash;
+    return true;
+}
+
+void WindowTracker::propertyChanged(xcb_window_t window, xcb_atom_t atom)
+{
+    if (window == m_root) {
+        if (atom == m_atoms[NetClientList]) {
+            updateClientList();
+        } else if (atom == m_atoms[NetActiveWindow]) {
+            updateActiveWindow();
+        }
+        return;
+    }
+
+    // Okuması sürmekte olan pencereler de izlenir: iş sırası korunduğundan
+    // bu okuma ilk tam okumadan sonra uygulanır
+    if (!m_windows.contains(window) && !m_pending.contains(window)) {
+        return;
+    }
+
+    int field = 0;
+    if (atom == m_atoms[NetWmName] || atom == XCB_ATOM_WM_NAME) {
+        field = TitleField;
+    } else if (atom == XCB_ATOM_WM_CLASS) {
+        field = ClassField;
+    } else if (atom == m_atoms[NetWmPid]) {
+        field = PidField;
+    } else if (atom == m_atoms[NetWmState]) {
+        field = StateField;
+    } else if (atom == m_atoms[NetWmIcon]) {
+        field = IconField;
+    }
+
+    if (field == 0) {
+        return;
+    }
+
+    // Aynı dağıtımdaki değişiklikler (ör. art arda başlık güncellemeleri) tek okumada toplanır
+    m_dirtyFields[window] |= field;
+    if (!m_flushScheduled) {
+        m_flushScheduled = true;
+        QMetaObject::invokeMethod(this, &WindowTracker::fetchDirty, Qt::QueuedConnection);
+    }
+}
+
+void WindowTracker::fetchDirty()
+{
+    m_flushScheduled = false;
+
+    // Aynı alan kümesini isteyen pencereler tek toplu okumada birleşir
+    QHash<int, QVector<xcb_window_t>> byFields;
+    for (auto it = m_dirtyFields.constBegin(); it != m_dirtyFields.constEnd(); ++it) {
+        byFields[it.value()].append(it.key());
+    }
+    m_dirtyFields.clear();
+
+    for (auto it = byFields.constBegin(); it != byFields.constEnd(); ++it) {
+        fetch(it.value(), it.key());
+    }
+}
+
+void WindowTracker::activate(xcb_window_t window)
+{
+    if (!m_connection) {
+        return;
+    }
+
+    xcb_client_message_event_t event;
+    std::memset(&event, 0, sizeof(event));
+    event.response_type = XCB_CLIENT_MESSAGE;
+    event.format = 32;
+    event.window = window;
+    event.type = m_atoms[NetActiveWindow];
+    event.data.data32[0] = SourceIndicationPager;
+    event.data.data32[1] = QX11Info::appUserTime();
+    event.data.data32[2] = m_activeWindow;
+
+    xcb_send_event(m_connection, false, m_root,
+                   XCB_EVENT_MASK_SUBSTRUCTURE_REDIRECT | XCB_EVENT_MASK_SUBSTRUCTURE_NOTIFY,
+                   reinterpret_cast<const char *>(&event));
+    xcb_flush(m_connection);
+}
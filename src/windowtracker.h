@@ -0,0 +1,129 @@
+#ifndef WINDOWTRACKER_H
+#define WINDOWTRACKER_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QVector>
+#include <xcb/xcb.h>
+#include "xconnection.h"
+
+// Görev çubuğunun bir pencere hakkında bildiği her şey
+struct WindowInfo {
+    xcb_window_t id = XCB_WINDOW_NONE;
+    QString title;
+    QString wmClass;       // WM_CLASS sınıf kısmı (ör. "Firefox")
+    QString wmInstance;    // WM_CLASS örnek kısmı
+    quint32 pid = 0;       // _NET_WM_PID
+    QByteArray iconData;   // Ham _NET_WM_ICON (CARDINAL dizisi)
+    quint64 iconHash = 0;  // iconData içerik özeti; 0 = simge yok
+    bool skipTaskbar = false;
+    bool demandsAttention = false;
+    bool hidden = false;
+};
+
+// EWMH pencere listesini olay güdümlü izler. Kök pencerede _NET_CLIENT_LIST
+// ve _NET_ACTIVE_WINDOW, her istemcide başlık, sınıf, durum ve simge için
+// PropertyNotify dinlenir; zamanlayıcı yoktur, değişiklik olmadıkça hiç
+// uyanılmaz. Yalnızca değişen pencereler için sinyal yayılır. Olaylar ve
+// özellik okumaları XConnection'ın iş parçacığındadır: GUI iş parçacığı
+// yanıt beklemez, sonuçlar geldiğinde uygulanır. Özellikler toplu istenir;
+// pencere sayısından bağımsız olarak tam listeleme iki gidiş-dönüş sürer.
+class WindowTracker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit WindowTracker(QObject *parent = nullptr);
+    ~WindowTracker();
+
+    // X11 dışında (ör. Wayland) çalışıyorsa izleme yapılmaz
+    bool isValid() const { return m_connection != nullptr; }
+
+    QVector<xcb_window_t> windows() const;
+    WindowInfo info(xcb_window_t window) const { return m_windows.value(window); }
+    xcb_window_t activeWindow() const { return m_activeWindow; }
+
+    // Pencere yöneticisinden pencereyi etkinleştirmesini ister (_NET_ACTIVE_WINDOW)
+    void activate(xcb_window_t window);
+
+signals:
+    void windowAdded(xcb_window_t window);
+    void windowRemoved(xcb_window_t window);
+    void windowChanged(xcb_window_t window);
+    void activeWindowChanged(xcb_window_t window);
+
+private slots:
+    void propertyChanged(xcb_window_t window, xcb_atom_t atom);
+    void refresh();
+    void fetchDirty();
+
+private:
+    enum Atom {
+        NetClientList,
+        NetActiveWindow,
+        NetWmName,
+        Utf8String,
+        NetWmState,
+        NetWmStateSkipTaskbar,
+        NetWmStateDemandsAttention,
+        NetWmStateHidden,
+        NetWmPid,
+        NetWmIcon,
+        AtomCount
+    };
+
+    // Toplu okumada hangi özelliklerin isteneceği
+    enum Field {
+        TitleField = 0x01,
+        ClassField = 0x02,
+        PidField = 0x04,
+        StateField = 0x08,
+        IconField = 0x10,
+        AllFields = 0x1f
+    };
+
+    // Olay iş parçacığında okunan ham özellik değerleri
+    struct Properties {
+        xcb_window_t window = XCB_WINDOW_NONE;
+        QByteArray netName;
+        QByteArray name;
+        QByteArray wmClass;
+        QByteArray pid;
+        QByteArray state;
+        QByteArray icon;
+    };
+
+    void internAtoms();
+
+    void updateClientList();
+    void updateActiveWindow();
+    void setClientList(const QVector<xcb_window_t> &windows);
+    void setActiveWindow(xcb_window_t window);
+
+    // Verilen pencerelerin istenen özelliklerini tek gidiş-dönüşte, olay
+    // iş parçacığında okur; sonuçlar applyProperties ile uygulanır
+    void fetch(const QVector<xcb_window_t> &windows, int fields);
+    void applyProperties(const QVector<Properties> &properties, int fields);
+    bool applyTitle(WindowInfo &info, const QByteArray &netName, const QByteArray &name);
+    bool applyClass(WindowInfo &info, const QByteArray &data);
+    bool applyPid(WindowInfo &info, const QByteArray &data);
+    bool applyState(WindowInfo &info, const QByteArray &data);
+    bool applyIcon(WindowInfo &info, const QByteArray &data);
+
+    xcb_connection_t *m_connection;
+    xcb_window_t m_root;
+    xcb_atom_t m_atoms[AtomCount];
+
+    QVector<xcb_window_t> m_order;           // Son _NET_CLIENT_LIST sırası
+    QSet<xcb_window_t> m_present;
+    QSet<xcb_window_t> m_pending;            // Özellikleri henüz okunmamış
+    QHash<xcb_window_t, WindowInfo> m_windows;
+    QHash<xcb_window_t, int> m_dirtyFields;  // Okunmayı bekleyen değişiklikler
+    xcb_window_t m_activeWindow;
+    bool m_flushScheduled;
+    XConnection::Alive m_alive;              // Olay iş parçacığındaki işlerin sahibi
+};
+
+#endif // WINDOWTRACKER_H
@@ -0,0 +1,44 @@
+#include "xcbpropertybatch.h"
+#include <cstdlib>
+
+XcbPropertyBatch::XcbPropertyBatch(xcb_connection_t *connection)
+    : m_connection(connection)
+    , m_fetched(0)
+{
+}
+
+XcbPropertyBatch::~XcbPropertyBatch()
+{
+    // Okunmamış yanıtlar bağlantıda birikmesin
+    for (int i = m_fetched; i < m_cookies.size(); ++i) {
+        xcb_discard_reply(m_connection, m_cookies.at(i).sequence);
+    }
+}
+
+int XcbPropertyBatch::add(xcb_window_t window, xcb_atom_t property, xcb_atom_t type, uint32_t maxLength)
+{
+    // Yanıt beklenmez; istek yalnızca çıkış tamponuna yazılır
+    m_cookies.append(xcb_get_property(m_connection, false, window, property, type, 0, maxLength));
+    m_values.append(QByteArray());
+    m_types.append(XCB_ATOM_NONE);
+    return m_cookies.size() - 1;
+}
+
+void XcbPropertyBatch::fetch()
+{
+    // İlk yanıt beklenirken tampon boşaltılır; sunucu istekleri sırayla
+    // yanıtladığından kalanlar çoktan gelmiş olur
+    for (; m_fetched < m_cookies.size(); ++m_fetched) {
+        xcb_get_property_reply_t *reply = xcb_get_property_reply(m_connection, m_cookies.at(m_fetched), nullptr);
+        if (!reply) {
+            continue;
+        }
+
+        if (reply->type != XCB_ATOM_NONE) {
+            m_types[m_fetched] = reply->type;
+            m_values[m_fetched] = QByteArray(static_cast<const char *>(xcb_get_property_value(reply)),
+                                             xcb_get_property_value_length(reply));
+        }
+        free(reply);
+    }
+}
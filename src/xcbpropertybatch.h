@@ -0,0 +1,38 @@
+#ifndef XCBPROPERTYBATCH_H
+#define XCBPROPERTYBATCH_H
+
+#include <QByteArray>
+#include <QVector>
+#include <xcb/xcb.h>
+
+// Çok sayıda pencere özelliği isteğini önce art arda gönderir, yanıtları
+// sonra toplar. İstek sayısından bağımsız olarak tek gidiş-dönüş sürer;
+// 150 pencere için 900 ayrı bekleme yerine bir bekleme.
+class XcbPropertyBatch
+{
+public:
+    explicit XcbPropertyBatch(xcb_connection_t *connection);
+    ~XcbPropertyBatch();
+
+    // İsteği hemen gönderir; dönen sıra numarası value()/type() ile kullanılır
+    int add(xcb_window_t window, xcb_atom_t property, xcb_atom_t type = XCB_ATOM_ANY,
+            uint32_t maxLength = UINT32_MAX / 4);
+
+    // Bekleyen tüm yanıtları toplar
+    void fetch();
+
+    QByteArray value(int slot) const { return m_values.at(slot); }
+    xcb_atom_t type(int slot) const { return m_types.at(slot); }
+    int size() const { return m_cookies.size(); }
+
+private:
+    Q_DISABLE_COPY(XcbPropertyBatch)
+
+    xcb_connection_t *m_connection;
+    QVector<xcb_get_property_cookie_t> m_cookies;
+    QVector<QByteArray> m_values;
+    QVector<xcb_atom_t> m_types;
+    int m_fetched;
+};
+
+#endif // XCBPROPERTYBATCH_H
@@ -0,0 +1,282 @@
+#include "xconnection.h"
+#include <QCoreApplication>
+#include <QThread>
+#include <QX11Info>
+#include <xcb/composite.h>
+#include <xcb/damage.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <cstdlib>
+
+XConnection *XConnection::instance()
+{
+    static XConnection *connection = new XConnection(QCoreApplication::instance());
+    return connection;
+}
+
+XConnection::XConnection(QObject *parent)
+    : QObject(parent)
+    , m_connection(nullptr)
+    , m_root(XCB_WINDOW_NONE)
+    , m_hasComposite(false)
+    , m_damageEvent(0)
+    , m_thread(nullptr)
+    , m_wakeFd(-1)
+    , m_quit(false)
+    , m_dispatchPending(false)
+    , m_overflow(false)
+    , m_backlogged(false)
+    , m_drainPending(false)
+{
+    if (!QX11Info::isPlatformX11()) {
+        return;
+    }
+
+    // Qt ile aynı ekrana (DISPLAY) ayrı bir bağlantı
+    int screenNumber = 0;
+    xcb_connection_t *connection = xcb_connect(nullptr, &screenNumber);
+    if (xcb_connection_has_error(connection)) {
+        xcb_disconnect(connection);
+        return;
+    }
+
+    xcb_screen_iterator_t screens = xcb_setup_roots_iterator(xcb_get_setup(connection));
+    for (int i = 0; i < screenNumber && screens.rem > 0; ++i) {
+        xcb_screen_next(&screens);
+    }
+    m_root = screens.data ? screens.data->root : XCB_WINDOW_NONE;
+
+    // Eklenti sürümleri yalnızca açılışta, tek gidiş-dönüşte sorgulanır
+    xcb_prefetch_extension_data(connection, &xcb_composite_id);
+    xcb_prefetch_extension_data(connection, &xcb_damage_id);
+    const xcb_query_extension_reply_t *composite = xcb_get_extension_data(connection, &xcb_composite_id);
+    const xcb_query_extension_reply_t *damage = xcb_get_extension_data(connection, &xcb_damage_id);
+    if (composite && composite->present && damage && damage->present) {
+        xcb_composite_query_version_cookie_t compositeCookie = xcb_composite_query_version(connection, 0, 4);
+        xcb_damage_query_version_cookie_t damageCookie = xcb_damage_query_version(connection, 1, 1);
+        xcb_composite_query_version_reply_t *compositeVersion =
+            xcb_composite_query_version_reply(connection, compositeCookie, nullptr);
+        xcb_damage_query_version_reply_t *damageVersion =
+            xcb_damage_query_version_reply(connection, damageCookie, nullptr);
+
+        // NameWindowPixmap için Composite 0.2 gerekir
+        m_hasComposite = compositeVersion && damageVersion
+                         && (compositeVersion->major_version > 0 || compositeVersion->minor_version >= 2);
+        m_damageEvent = damage->first_event + XCB_DAMAGE_NOTIFY;
+        free(compositeVersion);
+        free(damageVersion);
+    }
+
+    m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_wakeFd < 0) {
+        xcb_disconnect(connection);
+        return;
+    }
+
+    m_connection = connection;
+    m_thread = QThread::create([this]() { run(); });
+    m_thread->setObjectName("xenora-x11");
+    m_thread->start();
+}
+
+XConnection::~XConnection()
+{
+    if (!m_thread) {
+        return;
+    }
+
+    m_quit.store(true);
+    wake();
+    m_thread->wait();
+    delete m_thread;
+
+    close(m_wakeFd);
+    xcb_disconnect(m_connection);
+}
+
+void XConnection::post(Job job)
+{
+    if (!m_connection) {
+        return;
+    }
+
+    // Halka doluysa (ya da önünde bekleyen iş varsa) iş GUI tarafında sıraya
+    // girer; hiçbir iş çağıranın iş parçacığında çalışmaz ve sıra korunur
+    if (!m_backlog.empty() || !m_jobs.push(std::move(job))) {
+        m_backlog.push_back(std::move(job));
+        m_backlogged.store(true);
+    }
+    wake();
+}
+
+void XConnection::post(const Alive &alive, Job job)
+{
+    post([alive, job = std::move(job)](xcb_connection_t *connection) {
+        if (alive->load()) {
+            job(connection);
+        }
+    });
+}
+
+void XConnection::reply(const Alive &alive, std::function<void()> function)
+{
+    // Sahip GUI iş parçacığında yıkılır; denetim de orada yapıldığından yarış yoktur
+    QMetaObject::invokeMethod(this, [alive, function = std::move(function)]() {
+        if (alive->load()) {
+            function();
+        }
+    }, Qt::QueuedConnection);
+}
+
+void XConnection::drainBacklog()
+{
+    m_drainPending.store(false);
+
+    while (!m_backlog.empty() && m_jobs.push(std::move(m_backlog.front()))) {
+        m_backlog.pop_front();
+    }
+    if (m_backlog.empty()) {
+        m_backlogged.store(false);
+    }
+    wake();
+}
+
+void XConnection::selectEvents(xcb_window_t window, uint32_t mask)
+{
+    if (!m_connection) {
+        return;
+    }
+
+    // Maske bağlantı başınadır; diğer bileşenlerin seçtikleri korunur
+    uint32_t &current = m_eventMasks[window];
+    if ((current | mask) == current) {
+        return;
+    }
+    current |= mask;
+
+    xcb_change_window_attributes(m_connection, window, XCB_CW_EVENT_MASK, &current);
+    xcb_flush(m_connection);
+}
+
+void XConnection::wake()
+{
+    const uint64_t one = 1;
+    ssize_t written = write(m_wakeFd, &one, sizeof(one));
+    Q_UNUSED(written);
+}
+
+void XConnection::run()
+{
+    pollfd fds[2];
+    fds[0].fd = xcb_get_file_descriptor(m_connection);
+    fds[0].events = POLLIN;
+    fds[1].fd = m_wakeFd;
+    fds[1].events = POLLIN;
+
+    while (!m_quit.load()) {
+        // Yanıt beklerken xcb'nin okuduğu olaylar da hemen ardından boşaltılır
+        runJobs();
+        readEvents();
+        xcb_flush(m_connection);
+
+        if (xcb_connection_has_error(m_connection)) {
+            break;
+        }
+
+        if (poll(fds, 2, -1) < 0) {
+            continue;
+        }
+        if (fds[1].revents & POLLIN) {
+            uint64_t value = 0;
+            ssize_t count = read(m_wakeFd, &value, sizeof(value));
+            Q_UNUSED(count);
+        }
+    }
+}
+
+void XConnection::runJobs()
+{
+    Job job;
+    while (m_jobs.pop(job)) {
+        job(m_connection);
+        // Yakalanan veriler (ör. görüntüler) hemen bırakılır
+        job = nullptr;
+    }
+
+    // Halkada yer açıldı; bekleyen işler GUI iş parçacığından sırayla aktarılır.
+    // post() bayrağı kurduktan sonra uyandırdığından bu denetim kaçırılmaz.
+    if (m_backlogged.load() && !m_drainPending.exchange(true)) {
+        QMetaObject::invokeMethod(this, "drainBacklog", Qt::QueuedConnection);
+    }
+}
+
+void XConnection::readEvents()
+{
+    bool pushed = false;
+    while (xcb_generic_event_t *event = xcb_poll_for_event(m_connection)) {
+        const uint8_t type = event->response_type & ~0x80;
+
+        EventRecord record;
+        bool keep = false;
+        if (type == XCB_PROPERTY_NOTIFY) {
+            const xcb_property_notify_event_t *notify = reinterpret_cast<const xcb_property_notify_event_t *>(event);
+            record.type = EventRecord::Property;
+            record.window = notify->window;
+            record.atom = notify->atom;
+            keep = true;
+        } else if (m_hasComposite && type == m_damageEvent) {
+            const xcb_damage_notify_event_t *notify = reinterpret_cast<const xcb_damage_notify_event_t *>(event);
+            record.type = EventRecord::Damage;
+            record.window = notify->damage;
+            record.x = notify->area.x;
+            record.y = notify->area.y;
+            record.width = notify->area.width;
+            record.height = notify->area.height;
+            record.geometryWidth = notify->geometry.width;
+            record.geometryHeight = notify->geometry.height;
+            keep = true;
+        } else if (type == XCB_ENTER_NOTIFY) {
+            const xcb_enter_notify_event_t *notify = reinterpret_cast<const xcb_enter_notify_event_t *>(event);
+            record.type = EventRecord::Enter;
+            record.window = notify->event;
+            keep = true;
+        }
+        // Hatalar (kapanmış pencereye istek vb.) sessizce atılır
+        free(event);
+
+        if (keep) {
+            if (m_events.push(record)) {
+                pushed = true;
+            } else {
+                m_overflow.store(true);
+            }
+        }
+    }
+
+    // GUI iş parçacığı her seferinde değil, kuyruk boşaltılana dek bir kez uyandırılır
+    if ((pushed || m_overflow.load()) && !m_dispatchPending.exchange(true)) {
+        QMetaObject::invokeMethod(this, "dispatchEvents", Qt::QueuedConnection);
+    }
+}
+
+void XConnection::dispatchEvents()
+{
+    m_dispatchPending.store(false);
+
+    EventRecord record;
+    while (m_events.pop(record)) {
+        if (record.type == EventRecord::Property) {
+            emit propertyChanged(record.window, record.atom);
+        } else if (record.type == EventRecord::Enter) {
+            emit pointerEntered(record.window);
+        } else {
+            emit damaged(record.window, QRect(record.x, record.y, record.width, record.height),
+                         QSize(record.geometryWidth, record.geometryHeight));
+        }
+    }
+
+    if (m_overflow.exchange(false)) {
+        emit eventsLost();
+    }
+}
@@ -0,0 +1,113 @@
+#ifndef XCONNECTION_H
+#define XCONNECTION_H
+
+#include <QObject>
+#include <QHash>
+#include <QRect>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <xcb/xcb.h>
+#include "spscqueue.h"
+
+class QThread;
+
+// Kabuk bileşenlerinin paylaştığı X bağlantısı. Qt'nin bağlantısından
+// ayrıdır ve olayları arka plandaki bir iş parçacığında okur: olaylar
+// çözülüp küçük kayıtlar halinde kilitsiz bir kuyrukla GUI iş parçacığına
+// aktarılır, orada sinyal olarak yayılır. Yanıt bekleyen istekler (özellik
+// okumaları, görüntü alma) post() ile aynı iş parçacığında çalıştırılır;
+// GUI iş parçacığı hiçbir zaman X yanıtı beklemez. Yanıt gerektirmeyen
+// istekler connection() üzerinden doğrudan gönderilebilir (xcb iş
+// parçacığı güvenlidir).
+class XConnection : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Job = std::function<void(xcb_connection_t *)>;
+
+    static XConnection *instance();
+    ~XConnection();
+
+    bool isValid() const { return m_connection != nullptr; }
+    xcb_connection_t *connection() const { return m_connection; }
+    xcb_window_t rootWindow() const { return m_root; }
+
+    // Sunucuda Composite >= 0.2 ve Damage var mı (önizlemeler için)
+    bool hasComposite() const { return m_hasComposite; }
+
+    // İşi olay iş parçacığında, gönderildiği sırayla çalıştırır (yalnızca GUI
+    // iş parçacığından çağrılmalı). Sonuçlar alıcıya
+    // QMetaObject::invokeMethod(..., Qt::QueuedConnection) ile döndürülmelidir.
+    void post(Job job);
+
+    // İş gönderen nesnenin yaşam işareti. Sahibi yıkıcısında false yapar;
+    // kuyrukta bekleyen işleri atlanır, olay iş parçacığından dönen
+    // sonuçları atılır. Ham this işaretçisi işlere ve sonuçlara verilmez.
+    using Alive = std::shared_ptr<std::atomic<bool>>;
+    static Alive createAlive() { return std::make_shared<std::atomic<bool>>(true); }
+
+    // Sahipli post(): alive false olduysa iş çalıştırılmaz
+    void post(const Alive &alive, Job job);
+    // Sonucu GUI iş parçacığında çalıştırır (herhangi bir iş parçacığından
+    // çağrılabilir); sahibi bu arada yıkıldıysa çalıştırılmaz
+    void reply(const Alive &alive, std::function<void()> function);
+
+    // Bu bağlantının pencere için dinlediği olaylara mask eklenir (GUI iş parçacığı)
+    void selectEvents(xcb_window_t window, uint32_t mask);
+    void forgetWindow(xcb_window_t window) { m_eventMasks.remove(window); }
+
+signals:
+    void propertyChanged(xcb_window_t window, xcb_atom_t atom);
+    void damaged(uint32_t damage, const QRect &area, const QSize &geometry);
+    // Fare, EnterWindow seçilmiş bir pencereye girdi (ör. kenar tetikleyicisi)
+    void pointerEntered(xcb_window_t window);
+    // Kuyruk taştı ve olaylar kayboldu; dinleyiciler durumlarını baştan okumalı
+    void eventsLost();
+
+private slots:
+    void dispatchEvents();
+    void drainBacklog();
+
+private:
+    explicit XConnection(QObject *parent = nullptr);
+
+    // Olay iş parçacığından GUI iş parçacığına giden küçük olay kaydı
+    struct EventRecord {
+        enum Type : uint8_t { Property, Damage, Enter };
+        uint8_t type = Property;
+        uint32_t window = 0;   // Olayın penceresi ya da Damage nesnesi
+        uint32_t atom = 0;
+        int16_t x = 0, y = 0;
+        uint16_t width = 0, height = 0;
+        uint16_t geometryWidth = 0, geometryHeight = 0;
+    };
+
+    void run();
+    void readEvents();
+    void runJobs();
+    void wake();
+
+    xcb_connection_t *m_connection;
+    xcb_window_t m_root;
+    bool m_hasComposite;
+    uint8_t m_damageEvent;
+
+    QThread *m_thread;
+    int m_wakeFd;
+    std::atomic<bool> m_quit;
+    std::atomic<bool> m_dispatchPending;
+    std::atomic<bool> m_overflow;
+    std::atomic<bool> m_backlogged;     // GUI tarafında halkaya sığmamış işler var
+    std::atomic<bool> m_drainPending;
+
+    SpscQueue<EventRecord, 4096> m_events;  // Olay iş parçacığı -> GUI
+    SpscQueue<Job, 1024> m_jobs;            // GUI -> olay iş parçacığı
+    std::deque<Job> m_backlog;              // Halka doluyken gelen işler, sırayla (GUI)
+
+    QHash<xcb_window_t, uint32_t> m_eventMasks;
+};
+
+#endif // XCONNECTION_H
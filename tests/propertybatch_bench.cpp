@@ -0,0 +1,148 @@
+#include "xcbpropertybatch.h"
+#include "xvfbtest.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QVector>
+#include <algorithm>
+
+// XcbPropertyBatch ölçümü: N sahte pencere eşlenir, görev çubuğunun okuduğu
+// özellikler (başlık, sınıf, PID, durum, simge) önce pencere başına ayrı
+// istek/yanıtla, sonra tek toplu okumayla alınır. Sonuçların aynı olduğu
+// doğrulanır, her yöntemin ortanca süresi yazılır.
+//
+//   propertybatch_bench [pencere sayısı = 200] [tekrar = 5]
+
+namespace {
+
+enum Property { NetWmName, WmClass, NetWmPid, NetWmState, NetWmIcon, PropertyCount };
+
+struct Result {
+    QVector<QByteArray> values;
+    qint64 nsecs = 0;
+};
+
+Result fetchUnbatched(xcb_connection_t *connection, const QVector<xcb_window_t> &windows,
+                      const xcb_atom_t *atoms)
+{
+    Result result;
+    QElapsedTimer timer;
+    timer.start();
+    for (xcb_window_t window : windows) {
+        for (int i = 0; i < PropertyCount; ++i) {
+            // Her özellik ayrı bir gidiş-dönüş
+            xcb_get_property_reply_t *reply = xcb_get_property_reply(
+                connection, xcb_get_property(connection, false, window, atoms[i], XCB_ATOM_ANY, 0, UINT32_MAX / 4),
+                nullptr);
+            QByteArray value;
+            if (reply && reply->type != XCB_ATOM_NONE) {
+                value = QByteArray(static_cast<const char *>(xcb_get_property_value(reply)),
+                                   xcb_get_property_value_length(reply));
+            }
+            free(reply);
+            result.values.append(value);
+        }
+    }
+    result.nsecs = timer.nsecsElapsed();
+    return result;
+}
+
+Result fetchBatched(xcb_connection_t *connection, const QVector<xcb_window_t> &windows,
+                    const xcb_atom_t *atoms)
+{
+    Result result;
+    QElapsedTimer timer;
+    timer.start();
+    XcbPropertyBatch batch(connection);
+    for (xcb_window_t window : windows) {
+        for (int i = 0; i < PropertyCount; ++i) {
+            batch.add(window, atoms[i]);
+        }
+    }
+    batch.fetch();
+    for (int slot = 0; slot < batch.size(); ++slot) {
+        result.values.append(batch.value(slot));
+    }
+    result.nsecs = timer.nsecsElapsed();
+    return result;
+}
+
+double median(QVector<qint64> samples)
+{
+    std::sort(samples.begin(), samples.end());
+    return samples.at(samples.size() / 2) / 1e6;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    const QStringList arguments = app.arguments();
+    const int windowCount = arguments.size() > 1 ? qMax(1, arguments.at(1).toInt()) : 200;
+    const int rounds = arguments.size() > 2 ? qMax(1, arguments.at(2).toInt()) : 5;
+
+    xcb_connection_t *connection = xcb_connect(nullptr, nullptr);
+    if (!XvfbTest::hasDisplay() || xcb_connection_has_error(connection)) {
+        qWarning() << "X sunucusuna bağlanılamadı, ölçüm atlanıyor";
+        return XvfbTest::Skip;
+    }
+
+    xcb_atom_t atoms[PropertyCount];
+    atoms[NetWmName] = XvfbTest::atom(connection, "_NET_WM_NAME");
+    atoms[WmClass] = XCB_ATOM_WM_CLASS;
+    atoms[NetWmPid] = XvfbTest::atom(connection, "_NET_WM_PID");
+    atoms[NetWmState] = XvfbTest::atom(connection, "_NET_WM_STATE");
+    atoms[NetWmIcon] = XvfbTest::atom(connection, "_NET_WM_ICON");
+    const xcb_atom_t utf8String = XvfbTest::atom(connection, "UTF8_STRING");
+    const xcb_atom_t stateHidden = XvfbTest::atom(connection, "_NET_WM_STATE_HIDDEN");
+
+    // 32x32 simge: genişlik, yükseklik ve ARGB pikseller
+    QVector<quint32> icon(2 + 32 * 32, 0xff3366cc);
+    icon[0] = 32;
+    icon[1] = 32;
+
+    QVector<xcb_window_t> windows;
+    for (int i = 0; i < windowCount; ++i) {
+        const xcb_window_t window = XvfbTest::createWindow(connection, QRect(i % 64, i % 48, 120, 80), 0x202020);
+        const QByteArray title = QStringLiteral("Terminal %1 — ~/proje").arg(i).toUtf8();
+        const QByteArray wmClass("terminal\0Terminal\0", 18);
+        const quint32 pid = quint32(1000 + i);
+        XvfbTest::setProperty(connection, window, atoms[NetWmName], utf8String, 8, uint32_t(title.size()), title.constData());
+        XvfbTest::setProperty(connection, window, atoms[WmClass], XCB_ATOM_STRING, 8, uint32_t(wmClass.size()), wmClass.constData());
+        XvfbTest::setProperty(connection, window, atoms[NetWmPid], XCB_ATOM_CARDINAL, 32, 1, &pid);
+        if (i % 4 == 0) {
+            XvfbTest::setProperty(connection, window, atoms[NetWmState], XCB_ATOM_ATOM, 32, 1, &stateHidden);
+        }
+        XvfbTest::setProperty(connection, window, atoms[NetWmIcon], XCB_ATOM_CARDINAL, 32, uint32_t(icon.size()), icon.constData());
+        windows.append(window);
+    }
+    XvfbTest::sync(connection);
+
+    QVector<qint64> unbatched;
+    QVector<qint64> batched;
+    for (int round = 0; round < rounds; ++round) {
+        const Result single = fetchUnbatched(connection, windows, atoms);
+        const Result batch = fetchBatched(connection, windows, atoms);
+        if (single.values != batch.values) {
+            qWarning() << "Toplu okuma farklı sonuç verdi";
+            return 1;
+        }
+        unbatched.append(single.nsecs);
+        batched.append(batch.nsecs);
+    }
+
+    const double singleMs = median(unbatched);
+    const double batchMs = median(batched);
+    qInfo().noquote() << QStringLiteral("%1 pencere, %2 özellik: ayrı %3 ms (%4 gidiş-dönüş), toplu %5 ms (1 gidiş-dönüş), %6x")
+                             .arg(windowCount)
+                             .arg(windowCount * PropertyCount)
+                             .arg(singleMs, 0, 'f', 2)
+                             .arg(windowCount * PropertyCount)
+                             .arg(batchMs, 0, 'f', 2)
+                             .arg(batchMs > 0 ? singleMs / batchMs : 0.0, 0, 'f', 1);
+
+    xcb_disconnect(connection);
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include "windowthumbnailer.h"
+#include "xconnection.h"
+#include "xvfbtest.h"
+#include <QApplication>
+#include <QDebug>
+
+// WindowThumbnailer'ı başsız sunucuda dener: ilk kare bütün alınır, sonraki
+// çizim yalnızca hasar gören bölgeden küçük resme yansır, pencere
+// kapandıktan sonra son kare önbellekte kalır.
+
+namespace {
+
+const uint32_t Red = 0xff0000;
+const uint32_t Blue = 0x0000ff;
+
+bool isColor(const QImage &image, const QPoint &point, uint32_t pixel)
+{
+    return image.valid(point) && (image.pixel(point) & 0xffffff) == pixel;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    if (!XvfbTest::hasDisplay()) {
+        return XvfbTest::Skip;
+    }
+    QApplication app(argc, argv);
+
+    XConnection *x = XConnection::instance();
+    if (!x->isValid() || !x->hasComposite()) {
+        qWarning() << "Composite ya da Damage yok, test atlanıyor";
+        return XvfbTest::Skip;
+    }
+
+    xcb_connection_t *client = xcb_connect(nullptr, nullptr);
+    const xcb_window_t window = XvfbTest::createWindow(client, QRect(10, 10, 200, 150), Red);
+    XvfbTest::sync(client);
+
+    WindowThumbnailer thumbnailer;
+    QImage latest;
+    int updates = 0;
+    QObject::connect(&thumbnailer, &WindowThumbnailer::thumbnailUpdated,
+                     [&](xcb_window_t updated, const QImage &thumbnail) {
+        if (updated == window) {
+            latest = thumbnail;
+            ++updates;
+        }
+    });
+
+    thumbnailer.start(window, QSize(100, 75));
+    if (!XvfbTest::waitFor([&]() { return updates > 0; })) {
+        qWarning() << "İlk kare gelmedi";
+        return 1;
+    }
+    if (latest.size() != QSize(100, 75) || !isColor(latest, QPoint(50, 37), Red)) {
+        qWarning() << "İlk kare yanlış:" << latest.size() << QString::number(latest.pixel(50, 37), 16);
+        return 1;
+    }
+
+    // Sol yarı boyanır; küçük resmin sağ yarısı önceki kareden gelmelidir
+    XvfbTest::fill(client, window, QRect(0, 0, 100, 150), Blue);
+    XvfbTest::sync(client);
+    if (!XvfbTest::waitFor([&]() { return isColor(latest, QPoint(20, 37), Blue); })) {
+        qWarning() << "Hasar gören bölge küçük resme yansımadı";
+        return 1;
+    }
+    if (!isColor(latest, QPoint(80, 37), Red)) {
+        qWarning() << "Hasar görmeyen bölge bozuldu";
+        return 1;
+    }
+
+    // Eşlemeden çıkan pencerenin son karesi önbellekten verilir
+    xcb_unmap_window(client, window);
+    XvfbTest::sync(client);
+    thumbnailer.stop();
+    if (!isColor(thumbnailer.thumbnail(window), QPoint(20, 37), Blue)) {
+        qWarning() << "Son kare önbellekte yok";
+        return 1;
+    }
+
+    xcb_destroy_window(client, window);
+    xcb_disconnect(client);
+    qInfo() << "Önizleme testi geçti," << updates << "kare";
+    return 0;
+}
@@ -0,0 +1,139 @@
+#include "windowtracker.h"
+#include "xconnection.h"
+#include "xvfbtest.h"
+#include <QApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+
+// WindowTracker'ı başsız sunucuda dener. Test, pencere yöneticisi yerine
+// kök penceredeki _NET_CLIENT_LIST ve _NET_ACTIVE_WINDOW özelliklerini
+// kendisi yazar; izleyicinin her değişikliği zamanlayıcısız, olaylarla ve
+// yalnızca değişen pencere için bildirdiği doğrulanır.
+
+namespace {
+
+// Olay iş parçacığı -> GUI aktarımı ve toplu okuma için cömert üst sınır
+const int MaxLatency = 250;
+
+struct Counts {
+    int added = 0;
+    int removed = 0;
+    int changed = 0;
+    int active = 0;
+    int total() const { return added + removed + changed + active; }
+};
+
+int failed(const char *message)
+{
+    qWarning() << message;
+    return 1;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    if (!XvfbTest::hasDisplay()) {
+        return XvfbTest::Skip;
+    }
+    QApplication app(argc, argv);
+
+    xcb_connection_t *client = xcb_connect(nullptr, nullptr);
+    const xcb_window_t root = XvfbTest::screen(client)->root;
+    const xcb_atom_t clientList = XvfbTest::atom(client, "_NET_CLIENT_LIST");
+    const xcb_atom_t activeWindow = XvfbTest::atom(client, "_NET_ACTIVE_WINDOW");
+    const xcb_atom_t netWmName = XvfbTest::atom(client, "_NET_WM_NAME");
+    const xcb_atom_t utf8String = XvfbTest::atom(client, "UTF8_STRING");
+    const xcb_atom_t netWmState = XvfbTest::atom(client, "_NET_WM_STATE");
+    const xcb_atom_t stateHidden = XvfbTest::atom(client, "_NET_WM_STATE_HIDDEN");
+
+    auto setTitle = [&](xcb_window_t window, const QByteArray &title) {
+        XvfbTest::setProperty(client, window, netWmName, utf8String, 8, uint32_t(title.size()), title.constData());
+    };
+    auto setClients = [&](const QVector<xcb_window_t> &windows) {
+        XvfbTest::setProperty(client, root, clientList, XCB_ATOM_WINDOW, 32, uint32_t(windows.size()), windows.constData());
+    };
+
+    // Açılışta var olan pencere
+    const xcb_window_t first = XvfbTest::createWindow(client, QRect(0, 0, 100, 100), 0x808080);
+    setTitle(first, "Birinci");
+    setClients({ first });
+    XvfbTest::sync(client);
+
+    WindowTracker tracker;
+    if (!tracker.isValid()) {
+        return failed("X bağlantısı yok");
+    }
+
+    Counts counts;
+    xcb_window_t last = XCB_WINDOW_NONE;
+    QObject::connect(&tracker, &WindowTracker::windowAdded, [&](xcb_window_t w) { ++counts.added; last = w; });
+    QObject::connect(&tracker, &WindowTracker::windowRemoved, [&](xcb_window_t w) { ++counts.removed; last = w; });
+    QObject::connect(&tracker, &WindowTracker::windowChanged, [&](xcb_window_t w) { ++counts.changed; last = w; });
+    QObject::connect(&tracker, &WindowTracker::activeWindowChanged, [&](xcb_window_t) { ++counts.active; });
+
+    if (!XvfbTest::waitFor([&]() { return counts.added == 1; }) || tracker.info(first).title != "Birinci") {
+        return failed("Açılıştaki pencere okunmadı");
+    }
+
+    // Yeni pencere: özellikleriyle birlikte tek olay döngüsü turunda gelmeli
+    const xcb_window_t second = XvfbTest::createWindow(client, QRect(0, 0, 100, 100), 0x808080);
+    setTitle(second, "İkinci");
+    setClients({ first, second });
+    xcb_flush(client);
+    QElapsedTimer latency;
+    latency.start();
+    if (!XvfbTest::waitFor([&]() { return counts.added == 2; }) || last != second) {
+        return failed("Yeni pencere bildirilmedi");
+    }
+    const qint64 addLatency = latency.elapsed();
+    if (addLatency > MaxLatency || tracker.info(second).title != QStringLiteral("İkinci")) {
+        return failed("Yeni pencere geç ya da eksik geldi");
+    }
+    if (tracker.windows() != QVector<xcb_window_t>({ first, second })) {
+        return failed("Pencere sırası _NET_CLIENT_LIST ile aynı değil");
+    }
+
+    // Başlık değişimi yalnızca o pencereyi bildirir
+    const int changedBefore = counts.changed;
+    setTitle(first, "Birinci (değişti)");
+    xcb_flush(client);
+    if (!XvfbTest::waitFor([&]() { return counts.changed > changedBefore; })
+        || last != first || tracker.info(first).title != QStringLiteral("Birinci (değişti)")) {
+        return failed("Başlık değişikliği bildirilmedi");
+    }
+
+    // Durum değişimi
+    XvfbTest::setProperty(client, second, netWmState, XCB_ATOM_ATOM, 32, 1, &stateHidden);
+    xcb_flush(client);
+    if (!XvfbTest::waitFor([&]() { return tracker.info(second).hidden; })) {
+        return failed("_NET_WM_STATE_HIDDEN okunmadı");
+    }
+
+    // Etkin pencere
+    XvfbTest::setProperty(client, root, activeWindow, XCB_ATOM_WINDOW, 32, 1, &second);
+    xcb_flush(client);
+    if (!XvfbTest::waitFor([&]() { return tracker.activeWindow() == second; })) {
+        return failed("_NET_ACTIVE_WINDOW okunmadı");
+    }
+
+    // Boşta hiçbir bildirim gelmemeli
+    const int idleBefore = counts.total();
+    XvfbTest::waitFor([]() { return false; }, 300);
+    if (counts.total() != idleBefore) {
+        return failed("Değişiklik yokken bildirim geldi");
+    }
+
+    // Kapanan pencere
+    setClients({ first });
+    xcb_destroy_window(client, second);
+    xcb_flush(client);
+    if (!XvfbTest::waitFor([&]() { return counts.removed == 1; }) || last != second
+        || tracker.windows() != QVector<xcb_window_t>({ first })) {
+        return failed("Kapanan pencere bildirilmedi");
+    }
+
+    xcb_disconnect(client);
+    qInfo() << "Pencere izleyici testi geçti; yeni pencere" << addLatency << "ms içinde geldi";
+    return 0;
+}
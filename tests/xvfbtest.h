@@ -0,0 +1,98 @@
+#ifndef XVFBTEST_H
+#define XVFBTEST_H
+
+#include <QEventLoop>
+#include <QElapsedTimer>
+#include <QRect>
+#include <QTimer>
+#include <QtGlobal>
+#include <xcb/xcb.h>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+
+// Xvfb üzerinde çalışan testlerin ortak yardımcıları. Testler sahte istemci
+// pencerelerini kendi X bağlantılarında açar; kabuk bileşenleri bunları
+// gerçek uygulama pencereleri gibi görür. DISPLAY yoksa ya da sunucuda
+// gereken eklenti bulunmazsa test atlanır (ctest SKIP_RETURN_CODE).
+namespace XvfbTest {
+
+const int Skip = 77;
+
+inline bool hasDisplay()
+{
+    return !qEnvironmentVariableIsEmpty("DISPLAY");
+}
+
+// Koşul sağlanana ya da süre dolana dek olay döngüsünü çevirir
+inline bool waitFor(const std::function<bool()> &done, int timeout = 3000)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!done()) {
+        if (timer.elapsed() > timeout) {
+            return false;
+        }
+        QEventLoop loop;
+        QTimer::singleShot(5, &loop, &QEventLoop::quit);
+        loop.exec();
+    }
+    return true;
+}
+
+// Gönderilen tüm isteklerin sunucuda işlenmesini bekler
+inline void sync(xcb_connection_t *connection)
+{
+    free(xcb_get_input_focus_reply(connection, xcb_get_input_focus(connection), nullptr));
+}
+
+inline xcb_screen_t *screen(xcb_connection_t *connection)
+{
+    return xcb_setup_roots_iterator(xcb_get_setup(connection)).data;
+}
+
+inline xcb_atom_t atom(xcb_connection_t *connection, const char *name)
+{
+    xcb_intern_atom_reply_t *reply = xcb_intern_atom_reply(
+        connection, xcb_intern_atom(connection, 0, uint16_t(strlen(name)), name), nullptr);
+    const xcb_atom_t atom = reply ? reply->atom : XCB_ATOM_NONE;
+    free(reply);
+    return atom;
+}
+
+// Düz renkli arka planı olan üst düzey pencere
+inline xcb_window_t createWindow(xcb_connection_t *connection, const QRect &rect, uint32_t pixel,
+                                 bool map = true)
+{
+    xcb_screen_t *root = screen(connection);
+    const xcb_window_t window = xcb_generate_id(connection);
+    const uint32_t values[] = { pixel };
+    xcb_create_window(connection, XCB_COPY_FROM_PARENT, window, root->root,
+                      int16_t(rect.x()), int16_t(rect.y()), uint16_t(rect.width()), uint16_t(rect.height()),
+                      0, XCB_WINDOW_CLASS_INPUT_OUTPUT, root->root_visual, XCB_CW_BACK_PIXEL, values);
+    if (map) {
+        xcb_map_window(connection, window);
+    }
+    return window;
+}
+
+inline void fill(xcb_connection_t *connection, xcb_window_t window, const QRect &rect, uint32_t pixel)
+{
+    const xcb_gcontext_t gc = xcb_generate_id(connection);
+    const uint32_t values[] = { pixel };
+    xcb_create_gc(connection, gc, window, XCB_GC_FOREGROUND, values);
+    const xcb_rectangle_t rectangle = { int16_t(rect.x()), int16_t(rect.y()),
+                                        uint16_t(rect.width()), uint16_t(rect.height()) };
+    xcb_poly_fill_rectangle(connection, window, gc, 1, &rectangle);
+    xcb_free_gc(connection, gc);
+}
+
+inline void setProperty(xcb_connection_t *connection, xcb_window_t window, xcb_atom_t property,
+                        xcb_atom_t type, uint8_t format, uint32_t length, const void *data)
+{
+    xcb_change_property(connection, XCB_PROP_MODE_REPLACE, window, property, type, format, length, data);
+}
+
+} // namespace XvfbTest
+
+#endif // XVFBTEST_H